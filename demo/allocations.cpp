@@ -0,0 +1,93 @@
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <BGE/All>
+
+using namespace bge;
+
+// every allocation of the program goes through here and is counted
+static unsigned long long allocations = 0;
+
+void* operator new(size_t size)
+{
+    allocations ++;
+    void* memory = malloc(size > 0 ? size : 1);
+    if(!memory)
+        throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+// usage: allocations [panels] [children per panel] [frames]
+// the scene does not change while the frames are counted,only the cursor moves over it
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const int panels = argc > 1 ? atoi(argv[1]) : 16;
+    const int children = argc > 2 ? atoi(argv[2]) : 32;
+    const int frames = argc > 3 ? atoi(argv[3]) : 200;
+    const int width = 800;
+    const int height = 600;
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(width,height,bge::String("BGE Allocations"));
+
+    WindowManager::instance().initialize(":accid.ttf",true);
+
+    Panel* root = new Panel(FloatRect(0,0,width,height));
+    FlowLayout* layout = new FlowLayout();
+    root->setLayout(layout);
+    for(int i = 0;i < panels;i++)
+    {
+        Panel* panel = new Panel(FloatRect(0,0,180,120));
+        layout->addWindow(panel);
+        BoxLayout* box = new BoxLayout(i % 2 ? Orientation_horizontal : Orientation_vertical);
+        panel->setLayout(box);
+        for(int j = 0;j < children;j++)
+            box->addWindow(new Panel(FloatRect(0,0,4,4)));
+        panel->arrangeChildren();
+    }
+    root->arrangeChildren();
+    WindowManager::instance().addWindow(root);
+
+    // the first frames build caches,the cursor visits every panel once to create its hit-test grid
+    for(int i = 0;i < 8 && device->isRunning();i++)
+    {
+        for(int y = 0;y < height;y += 10)
+            for(int x = 0;x < width;x += 10)
+                WindowManager::instance().onMouseMove(x,y);
+        WindowManager::instance().invalidate();
+        device->preRender();
+        WindowManager::instance().update();
+        device->swapBuffers();
+    }
+
+    const unsigned long long before = allocations;
+    int drawn = 0;
+    for(int i = 0;i < frames && device->isRunning();i++)
+    {
+        WindowManager::instance().onMouseMove((i * 37) % width,(i * 23) % height);
+        WindowManager::instance().invalidate();
+        device->preRender();
+        WindowManager::instance().update();
+        device->swapBuffers();
+        drawn ++;
+    }
+    const unsigned long long used = allocations - before;
+
+    printf("windows:%d,frames:%d\n",panels * (children + 1) + 1,drawn);
+    printf("allocations:%llu,%.2f per frame\n",used,drawn > 0 ? double(used) / drawn : 0.0);
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
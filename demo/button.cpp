@@ -40,10 +40,13 @@ int main(int argc,char* argv[])
 
     while(device->isRunning())
     {
-        device->preRender();
-        WindowManager::instance().update();
-        device->swapBuffers();
-        device->pollEvents();
+        if(WindowManager::instance().needsUpdate())
+        {
+            device->preRender();
+            WindowManager::instance().update();
+            device->swapBuffers();
+        }
+        device->waitEvents(WindowManager::instance().idleTimeout());
     }
 
     WindowManager::instance().terminate();
@@ -0,0 +1,134 @@
+#include <cstdio>
+#include <cstdlib>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+static std::string printed(const TiXmlDocument& document)
+{
+    TiXmlPrinter printer;
+    document.Accept(&printer);
+    return printer.Str();
+}
+
+// the file a window is saved to again
+static std::string saved(Window* window)
+{
+    const std::string file = "compiledload.saved.xml";
+    TiXmlDocument document(file);
+    if(!window || !WindowManager::instance().saveWindow(window,file) || !document.LoadFile())
+        return std::string();
+    return printed(document);
+}
+
+static float loadAndDelete(const std::string& file,int loads)
+{
+    float load = 0.0f;
+    for(int i = 0;i < loads;i++)
+    {
+        const float start = TimeManager::systemTime();
+        Window* window = WindowManager::instance().createWindow(file);
+        load += TimeManager::systemTime() - start;
+        if(window)
+            window->deleteLater();
+        WindowManager::instance().deleteQueuedObjects();
+    }
+    return loads > 0 ? load * 1000.0f / loads : 0.0f;
+}
+
+static long fileSize(const std::string& file)
+{
+    FILE* handle = fopen(file.c_str(),"rb");
+    if(!handle)
+        return 0;
+    fseek(handle,0,SEEK_END);
+    const long size = ftell(handle);
+    fclose(handle);
+    return size;
+}
+
+// usage: compiledload [panels] [loads]
+// a grid of panels is saved,compiled,and loaded from both files
+// the nodes and the windows loaded from the compiled file must match those of the xml
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const int panels = argc > 1 ? atoi(argv[1]) : 1000;
+    const int loads = argc > 2 ? atoi(argv[2]) : 5;
+    const std::string xml = "compiledload.xml";
+    const std::string image = "compiledload.bgeui";
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(640,480,bge::String("BGE Compiled Load"));
+    WindowManager::instance().initialize(":accid.ttf",true);
+
+    Panel* root = new Panel(FloatRect(0,0,640,480));
+    GridLayout* grid = new GridLayout();
+    root->setLayout(grid);
+    char text[32];
+    for(int i = 0;i < panels;i++)
+    {
+        Panel* panel = new Panel();
+        sprintf(text,"panel%d",i);
+        panel->setName(text);
+        GridCellInfo info;
+        info.rowIndex_ = i / 32;
+        info.columnIndex_ = i % 32;
+        grid->addWindow(panel,info);
+
+        BoxLayout* box = new BoxLayout();
+        panel->setLayout(box);
+        for(int j = 0;j < 9;j++)
+        {
+            StaticText* label = new StaticText(0,L"label");
+            sprintf(text,"label%d",j);
+            label->setName(text);
+            box->addWindow(label);
+        }
+    }
+    WindowManager::instance().saveWindow(root,xml);
+    root->deleteLater();
+    WindowManager::instance().deleteQueuedObjects();
+
+    float start = TimeManager::systemTime();
+    const bool compiled = CompiledDocument::compile(xml,image);
+    const float compile = TimeManager::systemTime() - start;
+    if(!compiled)
+    {
+        printf("compiling %s failed\n",xml.c_str());
+        return 1;
+    }
+
+    TiXmlDocument parsed(xml);
+    parsed.LoadFile();
+    CompiledDocument document;
+    TiXmlDocument built(image);
+    const bool sameNodes = document.load(image) && document.build(built) && printed(parsed) == printed(built);
+    document.close();
+
+    Window* fromXml = WindowManager::instance().createWindow(xml);
+    Window* fromImage = WindowManager::instance().createWindow(image);
+    const std::string savedXml = saved(fromXml);
+    const bool sameWindows = !savedXml.empty() && savedXml == saved(fromImage);
+    fromXml->deleteLater();
+    fromImage->deleteLater();
+    WindowManager::instance().deleteQueuedObjects();
+
+    const float xmlLoad = loadAndDelete(xml,loads);
+    const float imageLoad = loadAndDelete(image,loads);
+
+    printf("%d windows,xml %ld KB,compiled %ld KB in %.2f ms\n",panels * 10 + 1,fileSize(xml) / 1024,fileSize(image) / 1024,
+           compile * 1000.0f);
+    printf("nodes %s,windows saved again %s\n",sameNodes ? "match" : "differ",sameWindows ? "match" : "differ");
+    printf("load:xml %.2f ms,compiled %.2f ms\n",xmlLoad,imageLoad);
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return sameNodes && sameWindows ? 0 : 1;
+}
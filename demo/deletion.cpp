@@ -0,0 +1,109 @@
+#include <cstdio>
+#include <cstdlib>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+class Closer : public SlotHolder
+{
+public:
+    Closer(Window* window):
+        window_(window)
+    {
+    }
+
+    //! the button emitting the signal is deleted from its own slot
+    void close()
+    {
+        window_->deleteLater();
+    }
+private:
+    Window* window_;
+};
+
+//! a panel of panels,each holding nine texts
+Panel* createTree(int panels)
+{
+    Panel* root = new Panel(FloatRect(0,0,640,480));
+    for(int i = 0;i < panels;i++)
+    {
+        Panel* panel = new Panel(FloatRect(0,0,64,64),root);
+        for(int j = 0;j < 9;j++)
+            new StaticText(panel,L"label");
+    }
+    return root;
+}
+
+void settle(WindowManager& manager)
+{
+    for(int i = 0;i < 10 && manager.needsUpdate();i++)
+        manager.update();
+}
+
+// usage: deletion [panels]
+// a tree deleted in one update against one spread over updates by the budget
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const int panels = argc > 1 ? atoi(argv[1]) : 5000;
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(640,480,bge::String("BGE Deletion"));
+    WindowManager& manager = WindowManager::instance();
+    manager.initialize(":accid.ttf",true);
+
+    Panel* dialog = new Panel(FloatRect(0,0,200,100));
+    Button* button = new Button(dialog,L"close");
+    Closer closer(dialog);
+    button->clicked.connect(&closer,&Closer::close);
+    manager.addWindow(dialog);
+    manager.setFocusedWindow(button);
+    button->clicked();
+    const bool keptForFrame = manager.isTopLevelWindow(dialog) && manager.queuedDeletions() == 1;
+    manager.update();
+    printf("closed from its slot:%s,top level after update:%s,focus %s\n",keptForFrame ? "kept until the update" : "deleted at once",
+           manager.isTopLevelWindow(dialog) ? "yes" : "no",manager.focusedWindow() ? "kept" : "dropped");
+
+    // the new panels are arranged and drawn first,only deletion is timed
+    Panel* tree = createTree(panels);
+    settle(manager);
+    float start = TimeManager::systemTime();
+    tree->deleteLater();
+    manager.deleteQueuedObjects();
+    const float once = TimeManager::systemTime() - start;
+
+    // the loop of an application,a frame is drawn only if the screen changed
+    tree = createTree(panels);
+    settle(manager);
+    tree->deleteLater();
+    int updates = 0;
+    int frames = 0;
+    float longest = 0.0f;
+    while(manager.queuedDeletions() > 0)
+    {
+        start = TimeManager::systemTime();
+        if(manager.needsUpdate())
+        {
+            manager.update();
+            frames ++;
+        }
+        const float update = TimeManager::systemTime() - start;
+        if(update > longest)
+            longest = update;
+        updates ++;
+    }
+
+    printf("%d objects\n",panels * 10 + 1);
+    printf("deleted at once:%.2f ms\n",once * 1000.0f);
+    printf("deleted by the budget:%d updates,%d frames drawn,longest %.2f ms\n",updates,frames,longest * 1000.0f);
+
+    manager.terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
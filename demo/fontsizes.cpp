@@ -0,0 +1,58 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+// usage: fontsizes [font] [sizes] [smallest point size]
+// every size is a text renderer of its own,they all read from one copy of the font file
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const std::string font = argc > 1 ? argv[1] : ":accid.ttf";
+    const int sizes = argc > 2 ? atoi(argv[2]) : 32;
+    const int smallest = argc > 3 ? atoi(argv[3]) : 8;
+    const int width = 1024;
+    const int height = 768;
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(width,height,bge::String("BGE Font Sizes"));
+
+    WindowManager::instance().initialize(font,true);
+    Canvas* canvas = WindowManager::instance().canvas();
+    const FontStatistics before = canvas->fontStatistics();
+
+    // startup is loading the sizes and rendering a first line with each of them
+    const String sample("The quick brown fox jumps over the lazy dog 0123456789");
+    const float start = TimeManager::systemTime();
+    canvas->preRender(width,height);
+    canvas->setColor(Color(1.0f,1.0f,1.0f,1.0f));
+    float y = 0.0f;
+    for(int i = 0;i < sizes;i++)
+    {
+        TextRenderer* text = canvas->createText(font,smallest + i);
+        text->render(sample,FloatRect(0.0f,y,float(width),text->lineHeight()),false,Horizontal_left,Vertical_top);
+        y = y + text->lineHeight() < height ? y + text->lineHeight() : 0.0f;
+    }
+    canvas->postRender();
+    const float elapsed = TimeManager::systemTime() - start;
+
+    const FontStatistics statistics = canvas->fontStatistics();
+    printf("sizes:%d,startup:%.2f ms,%.3f ms per size\n",sizes,elapsed * 1000.0f,elapsed * 1000.0f / sizes);
+    printf("font files:%u,renderers:%u,%llu kb held\n",statistics.files_,statistics.users_ - before.users_,
+        (unsigned long long)(statistics.bytes_ >> 10));
+    if(statistics.files_ > 0)
+        printf("one copy per renderer would hold %llu kb\n",
+            (unsigned long long)((statistics.bytes_ / statistics.files_ * statistics.users_) >> 10));
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+// usage: glyphatlas [font] [point size] [budget in kb] [first character] [characters]
+// screens show consecutive slices of the character range,so older glyphs fall out of use
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const std::string font = argc > 1 ? argv[1] : ":accid.ttf";
+    const int point = argc > 2 ? atoi(argv[2]) : 16;
+    const size_t budget = argc > 3 ? size_t(atoi(argv[3])) << 10 : size_t(1) << 20;
+    const uint32_t first = argc > 4 ? uint32_t(strtoul(argv[4],0,0)) : 0x4e00;
+    const uint32_t range = argc > 5 ? uint32_t(atoi(argv[5])) : 12000;
+    const int width = 1024;
+    const int height = 768;
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(width,height,bge::String("BGE Glyph Atlas"));
+
+    WindowManager::instance().initialize(font,true);
+    Canvas* canvas = WindowManager::instance().canvas();
+    TextRenderer* text = canvas->createText(font,point);
+    text->setAtlasBudget(budget);
+
+    const int columns = 40;
+    const int rows = 30;
+    const uint32_t perScreen = columns * rows;
+    const int screens = int((range + perScreen - 1) / perScreen) * 2;
+
+    const float start = TimeManager::systemTime();
+    for(int screen = 0;screen < screens;screen++)
+    {
+        canvas->preRender(width,height);
+        canvas->setColor(Color(1.0f,1.0f,1.0f,1.0f));
+        for(int row = 0;row < rows;row++)
+        {
+            String line;
+            for(int column = 0;column < columns;column++)
+                line.push_back(first + (screen * perScreen + row * columns + column) % range);
+
+            const FloatRect area(0.0f,row * text->lineHeight(),float(width),text->lineHeight());
+            text->render(line,area,false,Horizontal_left,Vertical_top);
+        }
+        canvas->postRender();
+
+        const GlyphAtlasStatistics statistics = text->atlasStatistics();
+        printf("screen %d:%u glyphs,%u pages,%llu of %llu kb,occupancy %.0f%%,%llu evictions,%u defragmentations\n",
+            screen,statistics.glyphs_,statistics.pages_,
+            (unsigned long long)(statistics.bytes_ >> 10),(unsigned long long)(statistics.budget_ >> 10),
+            statistics.occupancy_ * 100.0f,(unsigned long long)statistics.evictions_,statistics.defragmentations_);
+    }
+    printf("%.2f ms per screen\n",(TimeManager::systemTime() - start) * 1000.0f / screens);
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
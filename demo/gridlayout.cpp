@@ -0,0 +1,76 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+// usage: gridlayout [columns] [rows] [arranges]
+// every tenth row starts with a cell spanning two columns,the first two columns are fixed
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const int columns = argc > 1 ? atoi(argv[1]) : 100;
+    const int rows = argc > 2 ? atoi(argv[2]) : 1000;
+    const int arranges = argc > 3 ? atoi(argv[3]) : 20;
+    const int width = 1024;
+    const int height = 768;
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(width,height,bge::String("BGE Grid Layout"));
+
+    WindowManager::instance().initialize(":accid.ttf",true);
+
+    Panel* root = new Panel(FloatRect(0,0,float(columns * 24),float(rows * 16)));
+    GridLayout* grid = new GridLayout();
+    root->setLayout(grid);
+    std::vector<float> widths(2,40.0f);
+    grid->setColumnWidths(widths);
+
+    float start = TimeManager::systemTime();
+    int cells = 0;
+    for(int row = 0;row < rows;row++)
+    {
+        for(int column = 0;column < columns;column++)
+        {
+            GridCellInfo info;
+            info.rowIndex_ = row;
+            info.columnIndex_ = column;
+            if(row % 10 == 0 && column == 0)
+            {
+                info.horizontalSpan_ = 2;
+                column ++;
+            }
+            grid->addWindow(new Panel(),info);
+            cells ++;
+        }
+    }
+    const float build = TimeManager::systemTime() - start;
+
+    start = TimeManager::systemTime();
+    root->arrangeChildren();
+    const float first = TimeManager::systemTime() - start;
+
+    start = TimeManager::systemTime();
+    for(int i = 0;i < arranges;i++)
+    {
+        root->setSize(Vector2f(float(columns * 24 + i),float(rows * 16 + i)));
+        root->arrangeChildren();
+    }
+    const float arranged = TimeManager::systemTime() - start;
+
+    printf("%dx%d grid,%d cells\n",columns,rows,cells);
+    printf("build:%.2f ms,first arrange:%.2f ms,arrange:%.2f ms\n",build * 1000.0f,first * 1000.0f,
+        arranges > 0 ? arranged * 1000.0f / arranges : 0.0f);
+
+    WindowManager::instance().addWindow(root);
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+// hit-testing the way panels did before the spatial grid,every child is asked in turn
+Window* linearWindowBelow(Panel* panel,Layout* layout,const Vector2f& point)
+{
+    Window* ret = panel->Window::windowBelow(point);
+    if(ret != 0)
+    {
+        const std::vector<Window*>& list = layout->windows();
+        for(auto it = list.begin(); it != list.end(); ++it)
+        {
+            Window* window = (*it)->windowBelow(point);
+            if(window != 0)
+                return window;
+        }
+    }
+    return ret;
+}
+
+int main(int argc,char* argv[])
+{
+    const int count = argc > 1 ? atoi(argv[1]) : 10000;
+    const int queries = argc > 2 ? atoi(argv[2]) : 100000;
+    const float width = 1920.0f;
+    const float height = 1080.0f;
+
+    Panel* root = new Panel(FloatRect(0,0,width,height));
+    AbsoluteLayout* layout = new AbsoluteLayout();
+    root->setLayout(layout);
+
+    srand(2017);
+    for(int i = 0;i < count;i++)
+    {
+        const float w = 8.0f + rand() % 48;
+        const float h = 8.0f + rand() % 24;
+        const float x = static_cast<float>(rand() % static_cast<int>(width - w));
+        const float y = static_cast<float>(rand() % static_cast<int>(height - h));
+        layout->addWindow(new Panel(FloatRect(x,y,w,h)));
+    }
+
+    // mouse paths are random walks,a jump now and then
+    std::vector<Vector2f> path(queries);
+    Vector2f cursor(width * 0.5f,height * 0.5f);
+    for(int i = 0;i < queries;i++)
+    {
+        if(rand() % 64 == 0)
+            cursor = Vector2f(rand() % static_cast<int>(width),rand() % static_cast<int>(height));
+        cursor.x_ = std::min(std::max(cursor.x_ + rand() % 9 - 4,0.0f),width - 1.0f);
+        cursor.y_ = std::min(std::max(cursor.y_ + rand() % 9 - 4,0.0f),height - 1.0f);
+        path[i] = cursor;
+    }
+
+    int hits = 0;
+    int mismatches = 0;
+    float start = TimeManager::systemTime();
+    for(int i = 0;i < queries;i++)
+    {
+        if(root->windowBelow(path[i]) != root)
+            hits ++;
+    }
+    const float grid = TimeManager::systemTime() - start;
+
+    const int linearQueries = std::min(queries,2000);
+    start = TimeManager::systemTime();
+    for(int i = 0;i < linearQueries;i++)
+    {
+        if(linearWindowBelow(root,layout,path[i]) != root->windowBelow(path[i]))
+            mismatches ++;
+    }
+    const float linear = TimeManager::systemTime() - start;
+
+    // moving windows keeps the grid up to date without a rebuild
+    const std::vector<Window*>& windows = layout->windows();
+    start = TimeManager::systemTime();
+    for(auto it = windows.begin(); it != windows.end(); ++it)
+        (*it)->setPosition((*it)->position() + Vector2f(1.0f,1.0f));
+    const float moves = TimeManager::systemTime() - start;
+
+    for(int i = 0;i < linearQueries;i++)
+    {
+        if(linearWindowBelow(root,layout,path[i]) != root->windowBelow(path[i]))
+            mismatches ++;
+    }
+
+    // dragging the panel shifts the grid along with its windows,the cursor follows the panel
+    const int panelMoves = 20;
+    start = TimeManager::systemTime();
+    for(int i = 0;i < panelMoves;i++)
+    {
+        root->setPosition(root->position() + Vector2f(3.0f,2.0f));
+        root->windowBelow(path[i] + root->position());
+    }
+    const float panelMove = TimeManager::systemTime() - start;
+
+    const Vector2f shift = root->position();
+    int movedHits = 0;
+    start = TimeManager::systemTime();
+    for(int i = 0;i < queries;i++)
+    {
+        if(root->windowBelow(path[i] + shift) != root)
+            movedHits ++;
+    }
+    const float moved = TimeManager::systemTime() - start;
+
+    for(int i = 0;i < linearQueries;i++)
+    {
+        if(linearWindowBelow(root,layout,path[i] + shift) != root->windowBelow(path[i] + shift))
+            mismatches ++;
+    }
+
+    printf("%d windows,%d queries,%d hits\n",count,queries,hits);
+    printf("grid:%.1f ns per query\n",grid * 1e9f / queries);
+    printf("linear:%.1f ns per query\n",linear * 1e9f / linearQueries);
+    printf("move:%.1f ns per window\n",moves * 1e9f / count);
+    printf("panel move and hit test:%.2f ms,grid after it:%.1f ns per query,%d hits\n",panelMove * 1000.0f / panelMoves,
+           moved * 1e9f / queries,movedHits);
+    printf("mismatches:%d\n",mismatches);
+    return 0;
+}
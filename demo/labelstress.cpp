@@ -0,0 +1,62 @@
+#include <cstdio>
+#include <cstdlib>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const int count = argc > 1 ? atoi(argv[1]) : 2000;
+    const int frames = argc > 2 ? atoi(argv[2]) : 100;
+    const int width = 3840;
+    const int height = 2160;
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(width,height,bge::String("BGE Label Stress"));
+
+    WindowManager::instance().initialize(":accid.ttf",true);
+
+    Panel* root = new Panel(FloatRect(0,0,width,height));
+    AbsoluteLayout* layout = new AbsoluteLayout();
+    root->setLayout(layout);
+
+    const int columns = 30;
+    const float cellWidth = float(width) / columns;
+    const float cellHeight = 32.0f;
+    for(int i = 0;i < count;i++)
+    {
+        char text[16];
+        sprintf(text,"label%d",i);
+        StaticText* label = new StaticText(0,String(text));
+        label->setPosition(Vector2f((i % columns) * cellWidth,(i / columns) * cellHeight));
+        label->setSize(Vector2f(cellWidth - 4.0f,cellHeight - 4.0f));
+        layout->addWindow(label);
+    }
+    WindowManager::instance().addWindow(root);
+
+    const float start = TimeManager::systemTime();
+    for(int i = 0;i < frames && device->isRunning();i++)
+    {
+        WindowManager::instance().invalidate();
+        device->preRender();
+        WindowManager::instance().update();
+        device->swapBuffers();
+    }
+    const float elapsed = TimeManager::systemTime() - start;
+
+    const CanvasStatistics statistics = WindowManager::instance().canvas()->statistics();
+    printf("labels:%d\n",count);
+    printf("draw calls:%u,vertices:%u\n",statistics.drawCalls_,statistics.vertices_);
+    printf("frame:%.2f ms\n",elapsed * 1000.0f / frames);
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
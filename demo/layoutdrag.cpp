@@ -0,0 +1,109 @@
+#include <cstdio>
+#include <cstdlib>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+void drawFrame(Device* device)
+{
+    device->preRender();
+    WindowManager::instance().update();
+    device->swapBuffers();
+}
+
+// usage: layoutdrag [panels] [children per panel] [frames]
+// a frame window holding rows of nested box layouts is dragged across the screen,then resized
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const int panels = argc > 1 ? atoi(argv[1]) : 64;
+    const int children = argc > 2 ? atoi(argv[2]) : 16;
+    const int frames = argc > 3 ? atoi(argv[3]) : 200;
+    const int width = 1024;
+    const int height = 768;
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(width,height,bge::String("BGE Layout Drag"));
+
+    WindowManager::instance().initialize(":accid.ttf",true);
+
+    FrameWindow* frame = new FrameWindow(FloatRect(20,20,480,360));
+    frame->setText(L"BGE");
+    frame->enableMovement();
+    Panel* client = new Panel();
+    frame->setClientPanel(client);
+
+    BoxLayout* rows = new BoxLayout(Orientation_vertical);
+    client->setLayout(rows);
+    const int columns = 8;
+    BoxLayout* row = 0;
+    for(int i = 0;i < panels;i++)
+    {
+        if(i % columns == 0)
+        {
+            Panel* panel = new Panel();
+            rows->addWindow(panel);
+            row = new BoxLayout(Orientation_horizontal);
+            panel->setLayout(row);
+        }
+        Panel* panel = new Panel();
+        row->addWindow(panel);
+        BoxLayout* box = new BoxLayout(i % 2 ? Orientation_horizontal : Orientation_vertical);
+        panel->setLayout(box);
+        for(int j = 0;j < children;j++)
+            box->addWindow(new Panel(FloatRect(0,0,4,4)));
+    }
+    WindowManager::instance().addWindow(frame);
+    drawFrame(device);
+    const LayoutStatistics first = WindowManager::instance().layoutStatistics();
+    printf("windows:%d,first frame arranged %u layouts\n",panels * (children + 1) + (panels + columns - 1) / columns + 2,first.arranged_);
+
+    // the title bar is grabbed and the window follows the cursor
+    Vector2f cursor = frame->position() + Vector2f(40.0f,4.0f);
+    WindowManager::instance().onMouseMove(int(cursor.x()),int(cursor.y()));
+    WindowManager::instance().onLeftButtonDown(int(cursor.x()),int(cursor.y()));
+
+    LayoutStatistics total;
+    int drawn = 0;
+    float start = TimeManager::systemTime();
+    for(int i = 0;i < frames && device->isRunning();i++)
+    {
+        cursor = cursor + Vector2f(i % 40 < 20 ? 2.0f : -2.0f,1.0f);
+        WindowManager::instance().onMouseMove(int(cursor.x()),int(cursor.y()));
+        drawFrame(device);
+        total.arranged_ += WindowManager::instance().layoutStatistics().arranged_;
+        total.shifted_ += WindowManager::instance().layoutStatistics().shifted_;
+        drawn ++;
+    }
+    float elapsed = TimeManager::systemTime() - start;
+    WindowManager::instance().onLeftButtonUp(int(cursor.x()),int(cursor.y()));
+    if(drawn > 0)
+        printf("drag:%.3f ms,%.1f arranged,%.1f shifted per frame\n",elapsed * 1000.0f / drawn,
+            float(total.arranged_) / drawn,float(total.shifted_) / drawn);
+
+    total = LayoutStatistics();
+    drawn = 0;
+    start = TimeManager::systemTime();
+    for(int i = 0;i < frames && device->isRunning();i++)
+    {
+        frame->setSize(Vector2f(480.0f + i % 64,360.0f + i % 32));
+        drawFrame(device);
+        total.arranged_ += WindowManager::instance().layoutStatistics().arranged_;
+        total.shifted_ += WindowManager::instance().layoutStatistics().shifted_;
+        drawn ++;
+    }
+    elapsed = TimeManager::systemTime() - start;
+    if(drawn > 0)
+        printf("resize:%.3f ms,%.1f arranged,%.1f shifted per frame\n",elapsed * 1000.0f / drawn,
+            float(total.arranged_) / drawn,float(total.shifted_) / drawn);
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
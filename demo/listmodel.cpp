@@ -0,0 +1,88 @@
+#include <cstdio>
+#include <cstdlib>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+//! rows are produced when they are drawn,nothing is stored per row
+class LogModel : public ListModel
+{
+public:
+    LogModel(size_t count):
+        count_(count)
+    {
+    }
+public:
+    size_t count()const{return count_;}
+    String data(size_t row,size_t column)const
+    {
+        if(row >= count_)
+            return String();
+        char text[64];
+        sprintf(text,"%08u connection %u accepted",unsigned(row),unsigned(row * 2654435761u % 65536));
+        return String(text);
+    }
+private:
+    size_t count_;
+};
+
+// usage: listmodel [generated rows] [stored rows] [frames]
+// both lists scroll through their whole range while the frames are timed
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const size_t generated = argc > 1 ? size_t(atol(argv[1])) : 10000000;
+    const size_t stored = argc > 2 ? size_t(atol(argv[2])) : 100000;
+    const int frames = argc > 3 ? atoi(argv[3]) : 200;
+    const int width = 800;
+    const int height = 600;
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(width,height,bge::String("BGE List Model"));
+
+    WindowManager::instance().initialize(":accid.ttf",true);
+
+    Panel* root = new Panel(FloatRect(0,0,width,height));
+    AbsoluteLayout* layout = new AbsoluteLayout();
+    root->setLayout(layout);
+
+    LogModel model(generated);
+    ListBox* log = new ListBox(0,FloatRect(0,0,width / 2 - 4,height));
+    log->setModel(&model);
+    layout->addWindow(log);
+
+    ListBox* list = new ListBox(0,FloatRect(width / 2,0,width / 2,height));
+    float start = TimeManager::systemTime();
+    list->strings().reserve(stored);
+    for(size_t i = 0;i < stored;i++)
+        list->addString(model.data(i,0));
+    printf("%u stored rows added in %.2f ms\n",unsigned(stored),(TimeManager::systemTime() - start) * 1000.0f);
+    layout->addWindow(list);
+    WindowManager::instance().addWindow(root);
+
+    start = TimeManager::systemTime();
+    for(int i = 0;i < frames && device->isRunning();i++)
+    {
+        log->scrollTo(size_t(double(generated) * i / frames));
+        list->scrollTo(size_t(double(stored) * i / frames));
+        WindowManager::instance().invalidate();
+        device->preRender();
+        WindowManager::instance().update();
+        device->swapBuffers();
+    }
+    const float elapsed = TimeManager::systemTime() - start;
+
+    printf("generated rows:%u,first visible %u\n",unsigned(generated),log->firstVisibleEntry());
+    printf("stored rows:%u,first visible %u\n",unsigned(stored),list->firstVisibleEntry());
+    printf("frame:%.2f ms\n",elapsed * 1000.0f / frames);
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+void logMessages(int count,int thread)
+{
+    for(int i = 0;i < count;i++)
+        BGE_LOG_INFO(LogCategory_gui) << "thread " << thread << " message " << i;
+}
+
+// usage: logging [messages] [threads] [file]
+// times what the logging thread sees,writing happens in the background
+int main(int argc,char* argv[])
+{
+    const int messages = argc > 1 ? atoi(argv[1]) : 100000;
+    const int threads = argc > 2 ? atoi(argv[2]) : 4;
+    const std::string file = argc > 3 ? argv[3] : "logging.txt";
+
+    Log& log = Log::instance();
+    if(!log.setOutput(file))
+        printf("can not write %s,logging to stderr\n",file.c_str());
+
+    // below the level nothing is formatted
+    log.setLevel(LogCategory_gui,LogLevel_warning);
+    float start = TimeManager::systemTime();
+    logMessages(messages,0);
+    const float disabled = TimeManager::systemTime() - start;
+
+    log.setLevel(LogCategory_gui,LogLevel_info);
+    start = TimeManager::systemTime();
+    logMessages(messages,0);
+    const float enabled = TimeManager::systemTime() - start;
+    log.flush();
+
+    std::vector<std::thread> workers;
+    start = TimeManager::systemTime();
+    for(int i = 0;i < threads;i++)
+        workers.push_back(std::thread(logMessages,messages / threads,i + 1));
+    for(size_t i = 0;i < workers.size();i++)
+        workers[i].join();
+    const float parallel = TimeManager::systemTime() - start;
+    log.flush();
+
+    start = TimeManager::systemTime();
+    for(int i = 0;i < messages;i++)
+        err() << "err message " << i << "\n";
+    const float shim = TimeManager::systemTime() - start;
+    log.flush();
+
+    printf("disabled:%.1f ns per message\n",disabled * 1e9f / messages);
+    printf("enabled:%.1f ns per message\n",enabled * 1e9f / messages);
+    printf("%d threads:%.1f ns per message\n",threads,parallel * 1e9f / messages);
+    printf("err():%.1f ns per message\n",shim * 1e9f / messages);
+    printf("dropped:%llu\n",(unsigned long long)log.droppedMessages());
+    return 0;
+}
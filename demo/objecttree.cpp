@@ -0,0 +1,87 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+// usage: objecttree [parents] [children]
+// every parent and child is named,children are found by name,by path and by a recursive search
+int main(int argc,char* argv[])
+{
+    const int parents = argc > 1 ? atoi(argv[1]) : 200;
+    const int children = argc > 2 ? atoi(argv[2]) : 100;
+
+    std::vector<std::string> parentNames;
+    std::vector<std::string> childNames;
+    std::vector<std::string> paths;
+    char text[64];
+    for(int i = 0;i < parents;i++)
+    {
+        sprintf(text,"panel%d",i);
+        parentNames.push_back(text);
+    }
+    for(int i = 0;i < children;i++)
+    {
+        sprintf(text,"item%d",i);
+        childNames.push_back(text);
+    }
+    for(int i = 0;i < parents;i++)
+        paths.push_back(parentNames[i] + "/" + childNames[i % children]);
+
+    float start = TimeManager::systemTime();
+    Object* root = new Object();
+    std::vector<Object*> panels;
+    for(int i = 0;i < parents;i++)
+    {
+        Object* panel = new Object(root);
+        panel->setName(parentNames[i]);
+        panels.push_back(panel);
+        for(int j = 0;j < children;j++)
+            (new Object(panel))->setName(childNames[j]);
+    }
+    const float build = TimeManager::systemTime() - start;
+
+    int found = 0;
+    start = TimeManager::systemTime();
+    for(int i = 0;i < parents;i++)
+    {
+        for(int j = 0;j < children;j++)
+            found += panels[i]->findChild(childNames[j]) != NULL;
+    }
+    const float names = TimeManager::systemTime() - start;
+
+    start = TimeManager::systemTime();
+    for(int i = 0;i < parents;i++)
+        found += root->findChild(paths[i]) != NULL;
+    const float path = TimeManager::systemTime() - start;
+
+    const int searches = parents < 100 ? parents : 100;
+    start = TimeManager::systemTime();
+    for(int i = 0;i < searches;i++)
+        found += root->findChild(childNames[children - 1],true) != NULL;
+    const float recursive = TimeManager::systemTime() - start;
+
+    // every other child is removed and deleted on its own
+    start = TimeManager::systemTime();
+    for(int i = 0;i < parents;i++)
+    {
+        for(int j = 0;j < children;j += 2)
+            panels[i]->findChild(childNames[j])->deleteLater();
+    }
+    const float removal = TimeManager::systemTime() - start;
+
+    start = TimeManager::systemTime();
+    root->deleteLater();
+    const float teardown = TimeManager::systemTime() - start;
+
+    const int objects = parents * children + parents + 1;
+    printf("%d objects,%d found\n",objects,found);
+    printf("build:%.2f ms,%.1f ns per object\n",build * 1000.0f,build * 1e9f / objects);
+    printf("name lookup:%.1f ns,path lookup:%.1f ns,recursive lookup:%.1f us\n",names * 1e9f / (parents * children),
+        path * 1e9f / parents,searches > 0 ? recursive * 1e6f / searches : 0.0f);
+    printf("removal:%.1f ns per child,teardown:%.2f ms\n",removal * 1e9f / (parents * ((children + 1) / 2)),teardown * 1000.0f);
+    return 0;
+}
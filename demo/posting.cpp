@@ -0,0 +1,84 @@
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+//! only touched by tasks,on the ui thread
+static uint64_t completed = 0;
+static uint64_t latency = 0;
+
+void complete(uint64_t posted)
+{
+    completed ++;
+    latency += TimeManager::nanoseconds() - posted;
+}
+
+void postTasks(int count)
+{
+    for(int i = 0;i < count;i++)
+    {
+        const uint64_t posted = TimeManager::nanoseconds();
+        WindowManager::instance().post([posted](){complete(posted);});
+    }
+}
+
+void postBatches(int count,int batch)
+{
+    std::vector<TaskQueue::Task> tasks;
+    for(int i = 0;i < count;i += batch)
+    {
+        const uint64_t posted = TimeManager::nanoseconds();
+        for(int j = i;j < count && j < i + batch;j++)
+            tasks.push_back([posted](){complete(posted);});
+        WindowManager::instance().post(std::move(tasks));
+        tasks.clear();
+    }
+}
+
+//! the ui thread drains the queue through the frame loop until every task ran
+float measure(int tasks,int threads,int batch)
+{
+    completed = 0;
+    latency = 0;
+    const uint64_t start = TimeManager::nanoseconds();
+    std::vector<std::thread> producers;
+    for(int i = 0;i < threads;i++)
+    {
+        if(batch > 1)
+            producers.push_back(std::thread(postBatches,tasks / threads,batch));
+        else
+            producers.push_back(std::thread(postTasks,tasks / threads));
+    }
+
+    const uint64_t expected = uint64_t(tasks / threads) * threads;
+    while(completed < expected)
+    {
+        if(!WindowManager::instance().needsUpdate())
+            std::this_thread::yield();
+    }
+
+    for(size_t i = 0;i < producers.size();i++)
+        producers[i].join();
+    return float(double(TimeManager::nanoseconds() - start) * 1e-9);
+}
+
+// usage: posting [tasks] [threads] [batch]
+int main(int argc,char* argv[])
+{
+    const int tasks = argc > 1 ? atoi(argv[1]) : 1000000;
+    const int threads = argc > 2 ? atoi(argv[2]) : 8;
+    const int batch = argc > 3 ? atoi(argv[3]) : 64;
+
+    const float single = measure(tasks,threads,1);
+    printf("%d threads posting one by one:%.2f M tasks/s,%.1f us latency\n",threads,
+        tasks / single * 1e-6f,double(latency) * 0.001 / completed);
+
+    const float batched = measure(tasks,threads,batch);
+    printf("%d threads posting batches of %d:%.2f M tasks/s,%.1f us latency\n",threads,batch,
+        tasks / batched * 1e-6f,double(latency) * 0.001 / completed);
+    return 0;
+}
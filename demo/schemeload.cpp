@@ -0,0 +1,75 @@
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+static std::string printed(const std::string& file)
+{
+    TiXmlDocument document(file);
+    if(!document.LoadFile())
+        return std::string();
+    TiXmlPrinter printer;
+    document.Accept(&printer);
+    return printer.Str();
+}
+
+// the conversion fromString used before fromChars
+static float streamed(const std::string& text)
+{
+    float value = 0.0f;
+    std::istringstream stream(text);
+    stream >> value;
+    return value;
+}
+
+// usage: schemeload [loads]
+// the property scheme of the window manager is saved and loaded again loads times
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const int loads = argc > 1 ? atoi(argv[1]) : 1000;
+    const std::string file = "schemeload.xml";
+    const std::string again = "schemeload.saved.xml";
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(640,480,bge::String("BGE Scheme Load"));
+    WindowManager::instance().initialize(":accid.ttf",true);
+    WindowManager::instance().propertyScheme()->save(file);
+
+    PropertyScheme scheme;
+    float start = TimeManager::systemTime();
+    for(int i = 0;i < loads;i++)
+        scheme.load(file);
+    const float load = TimeManager::systemTime() - start;
+    scheme.save(again);
+    const bool same = printed(file) == printed(again);
+
+    // the float of a color component,converted by both
+    const int conversions = 1000000;
+    const std::string text = "0.752941";
+    float sum = 0.0f;
+    start = TimeManager::systemTime();
+    for(int i = 0;i < conversions;i++)
+        sum += fromString<float>(text);
+    const float chars = TimeManager::systemTime() - start;
+    start = TimeManager::systemTime();
+    for(int i = 0;i < conversions;i++)
+        sum += streamed(text);
+    const float stream = TimeManager::systemTime() - start;
+
+    printf("%d loads:%.3f ms each,saved again %s\n",loads,load * 1000.0f / loads,same ? "matches" : "differs");
+    printf("float from text:fromString %.1f ns,istringstream %.1f ns (%g)\n",chars * 1e9f / conversions,
+           stream * 1e9f / conversions,sum);
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return same ? 0 : 1;
+}
@@ -0,0 +1,118 @@
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+class Counter : public SlotHolder
+{
+public:
+    Counter():
+        count_(0)
+    {
+    }
+
+    void add(int value)
+    {
+        count_ += value;
+    }
+public:
+    uint64_t count_;
+};
+
+//! nanoseconds per emit with direct slots
+double measureDirect(int slots,int emits)
+{
+    Signal1<int> signal;
+    std::vector<Counter> counters(slots);
+    for(int i = 0;i < slots;i++)
+        signal.connect(&counters[i],&Counter::add);
+
+    const uint64_t start = TimeManager::nanoseconds();
+    for(int i = 0;i < emits;i++)
+        signal(1);
+    return double(TimeManager::nanoseconds() - start) / emits;
+}
+
+//! nanoseconds per connect and per disconnect,the holders are connected to a new signal each round
+void measureConnect(int slots,int rounds,double& connect,double& disconnect)
+{
+    std::vector<Counter> counters(slots);
+    uint64_t connecting = 0;
+    uint64_t disconnecting = 0;
+    for(int i = 0;i < rounds;i++)
+    {
+        Signal1<int> signal;
+        const uint64_t start = TimeManager::nanoseconds();
+        for(int j = 0;j < slots;j++)
+            signal.connect(&counters[j],&Counter::add);
+        const uint64_t connected = TimeManager::nanoseconds();
+        for(int j = 0;j < slots;j++)
+            signal.disconnect(&counters[j]);
+        disconnecting += TimeManager::nanoseconds() - connected;
+        connecting += connected - start;
+    }
+
+    connect = double(connecting) / (double(rounds) * slots);
+    disconnect = double(disconnecting) / (double(rounds) * slots);
+}
+
+// usage: signals [emits] [threads]
+// workers emit into a counter connected queued,the ui loop calls its slot
+int main(int argc,char* argv[])
+{
+    const int emits = argc > 1 ? atoi(argv[1]) : 10000000;
+    const int threads = argc > 2 ? atoi(argv[2]) : 4;
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(320,240,bge::String("BGE Signals"));
+    WindowManager::instance().initialize(":accid.ttf",true);
+
+    printf("direct,0 slots:%.2f ns per emit\n",measureDirect(0,emits));
+    printf("direct,1 slot:%.2f ns per emit\n",measureDirect(1,emits));
+    printf("direct,4 slots:%.2f ns per emit\n",measureDirect(4,emits));
+
+    // up to two connections are stored in the signal,more go to the heap
+    const int counts[] = {1,2,4,16};
+    for(int i = 0;i < 4;i++)
+    {
+        double connect = 0.0;
+        double disconnect = 0.0;
+        measureConnect(counts[i],emits / 10 / counts[i],connect,disconnect);
+        printf("%d slots:%.2f ns per connect,%.2f ns per disconnect\n",counts[i],connect,disconnect);
+    }
+
+    Signal1<int> progress;
+    Counter counter;
+    progress.connect(&counter,&Counter::add,ConnectionType_queued);
+
+    const int queued = emits / 10;
+    const uint64_t start = TimeManager::nanoseconds();
+    std::vector<std::thread> workers;
+    for(int i = 0;i < threads;i++)
+        workers.push_back(std::thread([&progress,queued,threads](){
+            for(int j = 0;j < queued / threads;j++)
+                progress(1);
+        }));
+
+    const uint64_t expected = uint64_t(queued / threads) * threads;
+    while(counter.count_ < expected)
+    {
+        if(!WindowManager::instance().needsUpdate())
+            std::this_thread::yield();
+    }
+    for(size_t i = 0;i < workers.size();i++)
+        workers[i].join();
+    const double elapsed = double(TimeManager::nanoseconds() - start) * 1e-9;
+    printf("queued,%d threads:%.2f M calls/s\n",threads,expected / elapsed * 1e-6);
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
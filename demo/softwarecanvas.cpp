@@ -0,0 +1,203 @@
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+Window* createButton(const std::string& name,const String& text)
+{
+    Button* button = new Button(0,text);
+    button->setSize(Vector2f(92,42));
+    button->setName(name);
+    return button;
+}
+
+// the window of demo/button
+Window* createButtonScene()
+{
+    FrameWindow* window = new FrameWindow();
+    window->setText(L"BGE");
+    window->setSize(Vector2f(160,154));
+    Panel* panel = new Panel();
+    panel->setSize(Vector2f(100,90));
+    window->setClientPanel(panel);
+
+    BoxLayout* layout = new BoxLayout(Orientation_vertical);
+    panel->setLayout(layout);
+    layout->addWindow(createButton("confirm",L"OK"));
+    layout->addWindow(createButton("cancel",L"Cancel"));
+    panel->arrangeChildren();
+    return window;
+}
+
+// the widgets of demo/grid1
+Window* createWidgetScene()
+{
+    Panel* panel = new Panel();
+    GridLayout* layout = new GridLayout();
+    panel->setLayout(layout);
+
+    std::vector<float> widths;
+    widths.push_back(0.0f);
+    layout->setColumnWidths(widths);
+    std::vector<float> heights(6,48.0f);
+    layout->setRowHeights(heights);
+
+    GridCellInfo info;
+    Window* skinned = createButton("button1",L"Start");
+    skinned->loadAppearance(":buttonskin1.xml");
+    info.columnIndex_ = 0; info.rowIndex_ = 0; layout->addWindow(skinned,info);
+    info.columnIndex_ = 1; info.rowIndex_ = 0; layout->addWindow(createButton("button2",L"Save"),info);
+    info.columnIndex_ = 0; info.rowIndex_ = 1; layout->addWindow(createButton("button3",L"Cancel"),info);
+    info.columnIndex_ = 1; info.rowIndex_ = 1; layout->addWindow(createButton("button4",L"Load"),info);
+
+    info.columnIndex_ = 0;
+    info.horizontalSpan_ = 2;
+    info.rowIndex_ = 2;
+    Window* edit = new EditField(0,L"edit field");
+    edit->setSize(Vector2f(196,36));
+    layout->addWindow(edit,info);
+
+    info.rowIndex_ = 3;
+    Slider* slider = new Slider();
+    slider->setTickPlacement(bge::TickPlacement_below);
+    slider->setSize(Vector2f(186,48));
+    layout->addWindow(slider,info);
+
+    info.rowIndex_ = 4;
+    ProgressBar* bar = new ProgressBar();
+    bar->setSize(Vector2f(186,24));
+    bar->setPercentage(24.0f);
+    layout->addWindow(bar,info);
+
+    info.rowIndex_ = 5;
+    ComboBox* combobox = new ComboBox();
+    combobox->setSize(Vector2f(96,36));
+    combobox->addString(L"first");
+    combobox->addString(L"second");
+    layout->addWindow(combobox,info);
+
+    FrameWindow* window = new FrameWindow();
+    window->setSize(Vector2f(200,340));
+    window->setText(L"BGE Window");
+    window->setClientPanel(panel);
+    panel->arrangeChildren();
+    return window;
+}
+
+// the window file of demo/grid2
+Window* createGridScene()
+{
+    return WindowManager::instance().createWindow(":grid.xml");
+}
+
+// the text of demo/richtext with its appearance,the labels of demo/labelstress below it
+Window* createTextScene()
+{
+    Panel* root = new Panel(FloatRect(0,0,640,480));
+    AbsoluteLayout* layout = new AbsoluteLayout();
+    root->setLayout(layout);
+
+    StaticText* text = new StaticText(0,L"text drawn by the software canvas");
+    text->setPosition(Vector2f(10.0f,10.0f));
+    text->setSize(Vector2f(620.0f,40.0f));
+    text->loadAppearance(":StaticTextDesc.xml");
+    layout->addWindow(text);
+
+    char name[16];
+    for(int i = 0;i < 120;i++)
+    {
+        sprintf(name,"label%d",i);
+        StaticText* label = new StaticText(0,String(name));
+        label->setPosition(Vector2f((i % 6) * 106.0f,60.0f + (i / 6) * 20.0f));
+        label->setSize(Vector2f(102.0f,18.0f));
+        layout->addWindow(label);
+    }
+    return root;
+}
+
+// a box image of demo/image tiled over a panel,stretched over another one
+Window* createImageScene()
+{
+    const char* appearances[2] = {":softwarecanvas.tiled.xml",":softwarecanvas.stretched.xml"};
+    Panel* root = new Panel(FloatRect(20,20,600,440));
+    BoxLayout* layout = new BoxLayout(Orientation_horizontal);
+    root->setLayout(layout);
+    for(int i = 0;i < 2;i++)
+    {
+        Panel* panel = new Panel();
+        panel->setSize(Vector2f(290,430));
+        panel->loadAppearance(appearances[i]);
+        layout->addWindow(panel);
+    }
+    root->arrangeChildren();
+    return root;
+}
+
+struct Scene
+{
+    const char* name_;
+    Window* (*create_)();
+};
+
+// usage: softwarecanvas [frames]
+// each scene is drawn frames times,one after another
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const int width = 640;
+    const int height = 480;
+    std::vector<uint8_t> pixels(width * height * 4);
+
+    // no device and no opengl context,everything is drawn into pixels
+    SoftwareCanvas* canvas = new SoftwareCanvas(&pixels[0],width,height);
+    WindowManager::instance().initialize(":accid.ttf",true,canvas);
+    WindowManager::instance().applicationResized(width,height);
+    canvas->clear(Color::Black);
+
+    const Scene scenes[] =
+    {
+        {"button",createButtonScene},
+        {"widgets",createWidgetScene},
+        {"grid",createGridScene},
+        {"text",createTextScene},
+        {"image",createImageScene}
+    };
+
+    const int frames = argc > 1 ? atoi(argv[1]) : 500;
+    for(size_t i = 0;i < sizeof(scenes) / sizeof(scenes[0]);i++)
+    {
+        Window* window = scenes[i].create_();
+        if(!window)
+        {
+            printf("%-9s could not be created\n",scenes[i].name_);
+            continue;
+        }
+        WindowManager::instance().addWindow(window);
+
+        const float start = TimeManager::systemTime();
+        for(int j = 0;j < frames;j++)
+        {
+            // only damaged areas are redrawn,the whole screen is damaged to measure full frames
+            WindowManager::instance().invalidate();
+            WindowManager::instance().update();
+        }
+        const float elapsed = TimeManager::systemTime() - start;
+
+        CanvasStatistics statistics = canvas->statistics();
+        printf("%-9s %.1f frames/s,per frame:%u primitives,%u vertices,%llu pixels\n",scenes[i].name_,
+               elapsed > 0.0f ? frames / elapsed : 0.0f,statistics.drawCalls_,statistics.vertices_,
+               (unsigned long long)canvas->pixels());
+
+        WindowManager::instance().removeWindow(window);
+        window->deleteLater();
+        WindowManager::instance().deleteQueuedObjects();
+    }
+
+    WindowManager::instance().terminate();
+    return 0;
+}
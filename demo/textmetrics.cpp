@@ -0,0 +1,65 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+float nanosecondsPerCharacter(TextRenderer* text,const String& string,int count)
+{
+    float width = 0.0f;
+    const float start = TimeManager::systemTime();
+    for(int i = 0;i < count;i++)
+        width += text->width(string);
+    const float elapsed = TimeManager::systemTime() - start;
+
+    if(width < 0.0f)
+        printf("negative width\n");
+    return elapsed * 1e9f / (count * static_cast<float>(string.size()));
+}
+
+String makeString(uint32_t first,uint32_t range,size_t length)
+{
+    String ret;
+    for(size_t i = 0;i < length;i++)
+        ret.push_back(first + static_cast<uint32_t>(i * 37) % range);
+    return ret;
+}
+
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    // glyphs are cached in textures,so an opengl context is needed
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(320,240,bge::String("BGE Text Metrics"));
+
+    WindowManager::instance().initialize(":accid.ttf",true);
+    TextRenderer* text = WindowManager::instance().canvas()->createText(":accid.ttf",16);
+
+    const int count = argc > 1 ? atoi(argv[1]) : 20000;
+    const String ascii(L"The quick brown fox jumps over the lazy dog 0123456789");
+    const String cjk = makeString(0x4e00,2000,ascii.size());
+    const String supplementary = makeString(0x20000,4000,ascii.size());
+
+    // the first pass fills the glyph cache
+    nanosecondsPerCharacter(text,ascii,1);
+    nanosecondsPerCharacter(text,cjk,1);
+    nanosecondsPerCharacter(text,supplementary,1);
+
+    printf("ascii:%.1f ns/char\n",nanosecondsPerCharacter(text,ascii,count));
+    printf("cjk:%.1f ns/char\n",nanosecondsPerCharacter(text,cjk,count));
+    printf("supplementary:%.1f ns/char\n",nanosecondsPerCharacter(text,supplementary,count));
+
+    KerningStatistics kerning = text->kerningStatistics();
+    printf("kerning:%llu hits,%llu misses\n",(unsigned long long)kerning.hits_,(unsigned long long)kerning.misses_);
+
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
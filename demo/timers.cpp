@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+#include <BGE/System/Timer.h>
+
+using namespace bge;
+
+//! measures how late each timer triggers
+class Probe : public SlotHolder
+{
+public:
+    Probe():
+        timer_(0),
+        triggered_(0),
+        lateness_(0)
+    {
+    }
+
+    void onTrigger()
+    {
+        const uint64_t now = TimeManager::milliseconds();
+        if(now > expected_)
+            lateness_ += now - expected_;
+        triggered_ ++;
+        expected_ = timer_->deadline();
+    }
+public:
+    Timer* timer_;
+    uint64_t expected_;
+    uint64_t triggered_;
+    uint64_t lateness_;
+};
+
+// usage: timers [timers] [seconds]
+// starts timers with intervals of 10 to 1000 ms and sleeps until the next deadline between frames
+int main(int argc,char* argv[])
+{
+    const int count = argc > 1 ? atoi(argv[1]) : 10000;
+    const int seconds = argc > 2 ? atoi(argv[2]) : 3;
+
+    std::vector<Timer*> timers;
+    std::vector<Probe> probes(count);
+    srand(7);
+    for(int i = 0;i < count;i++)
+    {
+        timers.push_back(new Timer(10 + rand() % 991));
+        probes[i].timer_ = timers[i];
+        timers[i]->trigger.connect(&probes[i],&Probe::onTrigger);
+    }
+
+    TimerWheel& wheel = TimerWheel::instance();
+    uint64_t start = TimeManager::nanoseconds();
+    for(int i = 0;i < count;i++)
+        timers[i]->start();
+    const uint64_t started = TimeManager::nanoseconds() - start;
+
+    start = TimeManager::nanoseconds();
+    for(int i = 0;i < count;i += 2)
+        timers[i]->stop();
+    const uint64_t stopped = TimeManager::nanoseconds() - start;
+    for(int i = 0;i < count;i += 2)
+        timers[i]->start();
+
+    for(int i = 0;i < count;i++)
+        probes[i].expected_ = timers[i]->deadline();
+
+    uint64_t frames = 0;
+    uint64_t advancing = 0;
+    const uint64_t end = TimeManager::milliseconds() + uint64_t(seconds) * 1000;
+    while(TimeManager::milliseconds() < end)
+    {
+        // as WindowManager::idleTimeout,the sleep ends when the millisecond of the deadline begins
+        const uint64_t deadline = wheel.nextDeadline();
+        const uint64_t now = TimeManager::nanoseconds();
+        if(deadline * 1000000 > now)
+            std::this_thread::sleep_for(std::chrono::nanoseconds(deadline * 1000000 - now));
+
+        start = TimeManager::nanoseconds();
+        wheel.advance(TimeManager::milliseconds());
+        advancing += TimeManager::nanoseconds() - start;
+        frames ++;
+    }
+
+    uint64_t triggered = 0;
+    uint64_t lateness = 0;
+    for(int i = 0;i < count;i++)
+    {
+        triggered += probes[i].triggered_;
+        lateness += probes[i].lateness_;
+    }
+
+    printf("%d timers\n",count);
+    printf("start:%.1f ns,stop:%.1f ns\n",double(started) / count,double(stopped) / (count / 2));
+    printf("%llu frames,advance:%.1f us per frame\n",(unsigned long long)frames,frames > 0 ? double(advancing) * 0.001 / frames : 0.0);
+    printf("%llu triggered,%.3f ms late on average\n",(unsigned long long)triggered,triggered > 0 ? double(lateness) / triggered : 0.0);
+
+    for(int i = 0;i < count;i++)
+        delete timers[i];
+    return 0;
+}
@@ -0,0 +1,22 @@
+#include <cstdio>
+#include <BGE/System/CompiledDocument.h>
+#include <BGE/System/IO.h>
+
+using namespace bge;
+
+// usage: uicompile source.xml target
+// compiles a window file written by WindowManager::saveWindow,createWindow loads either of them
+int main(int argc,char* argv[])
+{
+    if(argc != 3)
+    {
+        printf("usage:%s source.xml target\n",argv[0]);
+        return 1;
+    }
+
+    FileSystem::instance().initial(argv[0]);
+    const bool compiled = CompiledDocument::compile(argv[1],argv[2]);
+    if(compiled)
+        printf("%s compiled to %s\n",argv[1],argv[2]);
+    return compiled ? 0 : 1;
+}
@@ -0,0 +1,124 @@
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <BGE/All>
+#include <BGE/System/TimeManager.h>
+
+using namespace bge;
+
+struct Timing
+{
+    float load_;
+    float teardown_;
+};
+
+// each tree is deleted before the next one is loaded
+static Timing loadAndDelete(const std::string& file,int loads)
+{
+    Timing timing = {0.0f,0.0f};
+    for(int i = 0;i < loads;i++)
+    {
+        float start = TimeManager::systemTime();
+        Window* window = WindowManager::instance().createWindow(file);
+        timing.load_ += TimeManager::systemTime() - start;
+
+        start = TimeManager::systemTime();
+        if(window)
+            window->deleteLater();
+        WindowManager::instance().deleteQueuedObjects();
+        timing.teardown_ += TimeManager::systemTime() - start;
+    }
+    return timing;
+}
+
+// usage: xmlload [panels] [loads]
+// a grid of panels,each with a box layout of nine texts,is saved once and loaded again
+int main(int argc,char* argv[])
+{
+    FileSystem::instance().initial(argv[0]);
+    FileSystem::instance().setResourcePackage("data.zip");
+
+    const int panels = argc > 1 ? atoi(argv[1]) : 1000;
+    const int loads = argc > 2 ? atoi(argv[2]) : 5;
+    const std::string file = "xmlload.xml";
+
+    Device* device = Device::create();
+    device->initial();
+    device->createWindow(640,480,bge::String("BGE Xml Load"));
+    WindowManager::instance().initialize(":accid.ttf",true);
+
+    Panel* root = new Panel(FloatRect(0,0,640,480));
+    GridLayout* grid = new GridLayout();
+    root->setLayout(grid);
+    char text[32];
+    for(int i = 0;i < panels;i++)
+    {
+        Panel* panel = new Panel();
+        sprintf(text,"panel%d",i);
+        panel->setName(text);
+        GridCellInfo info;
+        info.rowIndex_ = i / 32;
+        info.columnIndex_ = i % 32;
+        grid->addWindow(panel,info);
+
+        BoxLayout* box = new BoxLayout();
+        panel->setLayout(box);
+        for(int j = 0;j < 9;j++)
+        {
+            StaticText* label = new StaticText(0,L"label");
+            sprintf(text,"label%d",j);
+            label->setName(text);
+            box->addWindow(label);
+        }
+    }
+    WindowManager::instance().saveWindow(root,file);
+    root->deleteLater();
+    WindowManager::instance().deleteQueuedObjects();
+
+    const Timing heap = loadAndDelete(file,loads);
+    WindowManager::instance().setLoadingArenas(true);
+    const Timing arena = loadAndDelete(file,loads);
+    Window* loaded = WindowManager::instance().createWindow(file);
+    const ArenaStatistics screen = Arena::statistics();
+
+    // what loading spends on each node to resolve its class
+    std::vector<std::string> classes;
+    classes.push_back("Panel");
+    classes.push_back("StaticText");
+    classes.push_back("BoxLayout");
+    classes.push_back("GridLayout");
+    classes.push_back("GridCellInfo");
+    classes.push_back("TextDesc");
+    const int lookups = 1000000;
+    int found = 0;
+    float start = TimeManager::systemTime();
+    for(int i = 0;i < lookups;i++)
+        found += Rtti::rttiByObjectName(classes[i % classes.size()]) != 0;
+    const float lookup = TimeManager::systemTime() - start;
+
+    Object* object = loaded ? loaded->findChild("panel7/label3") : 0;
+    start = TimeManager::systemTime();
+    for(int i = 0;i < lookups;i++)
+        found += Object::castTo<Window>(object) != 0;
+    const float cast = TimeManager::systemTime() - start;
+
+    printf("%d nodes,%s\n",panels * 10 + 1,object ? "label found by path" : "label not found");
+    const float scale = loads > 0 ? 1000.0f / loads : 0.0f;
+    printf("heap:load %.2f ms,teardown %.2f ms\n",heap.load_ * scale,heap.teardown_ * scale);
+    printf("arena:load %.2f ms,teardown %.2f ms\n",arena.load_ * scale,arena.teardown_ * scale);
+    printf("screen:%u objects in %u blocks of %.1f KB,%u objects on the heap\n",screen.objects_,screen.blocks_,
+           screen.bytes_ / 1024.0f,screen.heapObjects_);
+    printf("class lookup:%.1f ns,castTo:%.1f ns,%d found\n",lookup * 1e9f / lookups,cast * 1e9f / lookups,found);
+
+    if(loaded)
+        loaded->deleteLater();
+    WindowManager::instance().deleteQueuedObjects();
+    const ArenaStatistics released = Arena::statistics();
+    printf("deleted:%u arenas,%u blocks,%u objects left in arenas\n",released.arenas_,released.blocks_,released.objects_);
+    WindowManager::instance().terminate();
+    device->closeWindow();
+    device->terminate();
+    device->deleteLater();
+    return 0;
+}
@@ -29,7 +29,7 @@ public:
 	{
 		buttons_.push_back(button);
 	}
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
     friend class BasicButton;
@@ -58,9 +58,8 @@ public:
 
     virtual Vector2f recommendedSize() const;
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-	void deleteLater();
 
     BasicButtonDesc& buttonDesc() const;
 public:
@@ -102,7 +101,7 @@ public:
     TextDesc& textDesc() const { return *textDesc_; }
     Color textColor() const;
 public:
-    virtual bool loadProperty(TiXmlNode* node,const char* = 0);
+    virtual bool loadProperty(const PropertyNode& node,const char* = 0);
     virtual bool saveProperty(TiXmlNode* node,const char* = 0);
 private:
     RenderDesc* background_;
@@ -134,7 +133,7 @@ public:
     }
     Vector2f defaultTextSize() const;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
     ButtonStateDesc pressedDesc_;
@@ -152,7 +151,7 @@ public:
     Button(Window* parent = 0,const String& text = L"",ButtonGroup* group = 0);
     virtual ~Button(){}
 
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 protected:
     virtual Window& onDraw();
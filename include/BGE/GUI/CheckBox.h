@@ -23,7 +23,7 @@ public:
 
     virtual Vector2f recommendedSize() const;
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 protected:
     virtual Window& onDraw();
@@ -44,7 +44,7 @@ public:
         return *this;
     }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 private:
     CheckBox*   checkBox_;
@@ -66,7 +66,7 @@ public:
         return *this;
     }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
     RenderDesc* checked_;
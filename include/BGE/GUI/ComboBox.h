@@ -34,9 +34,8 @@ public:
     virtual Vector2f recommendedSize() const;
 
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-	virtual void deleteLater();
 
     bool isDropDownOpen() const { return isDropDownOpen_; }
 public:
@@ -46,6 +45,7 @@ public:
 protected:
     virtual Window& onDraw();
     virtual void onLostFocus();
+    virtual void destroy();
 private:
     ComboBox& openDropDown();
     ComboBox& closeDropDown();
@@ -71,7 +71,7 @@ public:
 
     TextDesc& textDesc() { return *textDesc_; }
 public:
-    bool loadProperty(TiXmlNode* node);
+    bool loadProperty(const PropertyNode& node);
     bool saveProperty(TiXmlNode* node);
 private:
     RenderDesc* background_;
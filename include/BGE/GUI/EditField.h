@@ -14,6 +14,9 @@ class TextDesc;
 class BGE_EXPORT_API EditField : public Window, public KeyListener
 {
     DECLARE_OBJECT(EditField)
+    //! both bases are allocated the same way
+    using Window::operator new;
+    using Window::operator delete;
 public:
     struct Selection
     {
@@ -42,9 +45,8 @@ public:
 
     virtual Vector2f recommendedSize() const;
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-	virtual void deleteLater();
 public:
     Signal0 returnPressed;
     Signal1<const String&> textChanged;
@@ -98,7 +100,7 @@ public:
 
     TextDesc& textDesc() { return *textDesc_; }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
     void drawTextWithSelection(const FloatRect& area,Canvas* canvas) const;
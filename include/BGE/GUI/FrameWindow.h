@@ -34,10 +34,8 @@ public:
 
     virtual Vector2f recommendedSize() const;
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-
-    virtual void deleteLater();
 protected:
     virtual Window& onDraw();
     virtual FrameWindow& clientWindowChanged();
@@ -71,7 +69,7 @@ public:
     float rightBorderWidth() const { return rightBorderWidth_; }
     float bottomBorderWidth() const { return bottomBorderWidth_; }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
     RenderDesc*  topLeftDesc_;
@@ -37,18 +37,32 @@ public:
 
     virtual Layout& removeWindow(Window* window) = 0;
     virtual Layout& arrangeWithin() = 0;
+    //! moves the windows along with the parent without arranging them again
+    virtual Layout& translateWithin(const Vector2f& offset);
 
-    virtual std::list<Window*> windows()const = 0;
+    //! windows in layout order,iterating them allocates nothing
+    //! the reference is valid as long as the layout,adding or removing windows changes its contents
+    const std::vector<Window*>& windows()const{return windows_;}
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 
-	Window* parse(TiXmlElement* node);
+	Window* parse(const PropertyNode& node);
 public:
     float spacing() const { return spacing_; }
     void  setSpacing(float spacing) { spacing_ = spacing; }
+    //! increases whenever windows are added or removed
+    uint32_t revision() const { return revision_; }
+protected:
+    //! the parent panel is arranged again before the next frame
+    void changed();
+    //! keeps the order of the remaining windows
+    void eraseWindow(Window* window);
+protected:
+    std::vector<Window*> windows_;
 private:
     float   spacing_;
+    uint32_t revision_;
 };
 
 class BGE_EXPORT_API BoxLayout : public Layout
@@ -69,19 +83,16 @@ public:
     bool isChildSizeRespected() const { return isChildSizeRespected_; }
     BoxLayout& respectChildSize() { isChildSizeRespected_ = true; return *this; }
     BoxLayout& doNotRespectChildSize() { isChildSizeRespected_ = false; return *this; }
-
-    std::list<Window*> windows()const{return windows_;}
 public:
     virtual Layout& addWindow(Window* window);
     virtual Layout& removeWindow(Window* window);
     virtual Layout& arrangeWithin();
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
     Orientation justification_;
     bool isChildSizeRespected_;
-    std::list<Window*> windows_;
 };
 
 class BGE_EXPORT_API FlowLayout : public Layout
@@ -102,13 +113,11 @@ public:
     virtual Layout& addWindow(Window* window);
     virtual Layout& removeWindow(Window* window);
     virtual Layout& arrangeWithin();
-    virtual std::list<Window*> windows()const{return windows_;}
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
     Horizontal alignment_;
-    std::list<Window*> windows_;
 };
 
 class BGE_EXPORT_API StackLayout : public Layout
@@ -121,7 +130,6 @@ public:
     virtual Layout& addWindow(Window* window);
     virtual Layout& removeWindow(Window* window);
 
-    std::list<Window*> windows()const{return windows_;}
     Layout& insertWindow(int index,Window* window);
     Window* currentWindow()const;
     int currentIndex()const;
@@ -133,13 +141,12 @@ public:
 
     Layout& arrangeWithin();
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 public:
     Signal1<int> windowRemoved;
     Signal1<int> currentChanged;
 private:
-    std::list<Window*> windows_;
     int current_;
 };
 
@@ -154,12 +161,9 @@ public:
     Layout& removeWindow(Window* window);
     int count()const;
     Layout& arrangeWithin();
-    std::list<Window*> windows()const{return windows_;}
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-private:
-    std::list<Window*> windows_;
 };
 
 class BGE_EXPORT_API GridCellInfo : public LayoutInfo
@@ -169,7 +173,7 @@ public:
     GridCellInfo();
     virtual ~GridCellInfo(){}
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 public:
     uint32_t horizontalSpan_;
@@ -187,18 +191,24 @@ private:
     {
         Window* window_;
         GridCellInfo info_;
+        //! first column and row the cell was placed in
+        uint32_t column_;
+        uint32_t row_;
 
         Cell(Window* window,const GridCellInfo& cellInfo)
         {
             window_ = window;
             info_ = cellInfo;
+            column_ = 0;
+            row_ = 0;
         }
     };
 public:
     explicit GridLayout(const Vector2f& border = Vector2f(2.0f,2.0f)):
         border_(border),
 		numCols_(0),
-		numRows_(0)
+		numRows_(0),
+        isPlaced_(false)
     {
     }
     virtual ~GridLayout(){}
@@ -213,50 +223,25 @@ public:
     virtual Layout& removeWindow(Window* window);
 
     virtual Layout& arrangeWithin();
-
-    std::list<Window*> windows()const
-    {
-        std::list<Window*> list;
-        auto itr = cells_.begin();
-        while(itr != cells_.end())
-        {
-            list.push_back(itr->window_);
-            itr ++;
-        }
-        return list;
-    }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
-    struct Block
-    {
-        uint32_t row;
-        uint32_t col;
-        uint32_t hSpan;
-        uint32_t vSpan;
-        float hSpace;
-        float vSpace;
-        bool windowStart;
-        Window* window;
-    };
-
-	void parseItemNode(TiXmlElement* node);
-    void calculateBlocks();
-    void calculateColWidths(std::vector<float>& colWidths,float width);
-    void calculateRowHeights(std::vector<float>& rowHeights,float height);
-    void addBlockToMap(const Block& block)
-    {
-        blockMap_[block.row*256 + block.col] = block;
-    }
+	void parseItemNode(const PropertyNode& node);
+    //! assigns every cell its column and row,done again only after cells were added or removed
+    void placeCells();
 private:
     Vector2f border_;
+    //! sizes of the tracks,0 for a track sharing the space left by the others
     std::vector<float> columnWidths_;
     std::vector<float> rowHeights_;
     uint32_t numCols_;
     uint32_t numRows_;
-    std::list<Cell> cells_;
-    std::map<uint32_t,Block> blockMap_;
+    std::vector<Cell> cells_;
+    bool isPlaced_;
+    //! where each track starts,the last entry is where the last track ends
+    std::vector<float> columnOffsets_;
+    std::vector<float> rowOffsets_;
 };
 
 }
@@ -1,6 +1,7 @@
 #ifndef BGE_GUI_LISTBOX_H
 #define BGE_GUI_LISTBOX_H
 #include <BGE/GUI/ListWindow.h>
+#include <BGE/GUI/ListModel.h>
 #include <BGE/GUI/Message.h>
 
 namespace bge
@@ -12,32 +13,31 @@ class TextDesc;
 class BGE_EXPORT_API ListBox : public ListWindow
 {
     DECLARE_OBJECT(ListBox)
-public:
-    typedef std::list<String> Strings;
 public:
     ListBox(Window* parent = 0,const FloatRect& rect = FloatRect());
     virtual ~ListBox();
 public:
+    //! the string functions edit the list's own model,which is shown unless setModel replaced it
     ListBox& addString(const String& string);
     ListBox& removeStringAt(size_t pos);
     ListBox& removeAllStrings();
+    StringListModel& strings() { return strings_; }
 
+    //! first column of the shown model
     String stringAt(size_t position) const;
-    size_t numberOfStrings() const { return strings_.size(); }
-
-    virtual size_t numberOfEntries() const { return numberOfStrings(); }
+    size_t numberOfStrings() const { return strings_.count(); }
 
     bool contains(const String& string) const;
     int indexOf(const String& string) const;
 
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 protected:
     virtual Window& onDraw();
     virtual float entryHeight() const;
 private:
-    Strings strings_;
+    StringListModel strings_;
     ListBoxDesc* renderDesc_;
 };
 
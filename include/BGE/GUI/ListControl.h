@@ -1,8 +1,8 @@
 #ifndef BGE_GUI_LISTCONTROL_H
 #define BGE_GUI_LISTCONTROL_H
 #include <BGE/GUI/ListWindow.h>
+#include <BGE/GUI/ListModel.h>
 #include <vector>
-#include <list>
 
 namespace bge
 {
@@ -14,39 +14,24 @@ class BGE_EXPORT_API ListControl : public ListWindow
 {
     DECLARE_OBJECT(ListControl)
 public:
+    //! view of one row of the shown model
     class Row
     {
     public:
-        typedef std::vector<String> Strings;
-    public:
-		Row(ListControl& list): listControl_(list)
-        {
-            strings_.resize(list.numberOfColumns());
-        }
-
-        Row(const Row& row): listControl_(row.listControl_)
+        Row(const ListModel& model,size_t row):
+            model_(model),
+            row_(row)
         {
-            strings_ = row.strings_;
         }
     public:
-        Row& setEntry(uint32_t column,const String& string)
+        String stringAt(int column)const
         {
-            //ASSERT ( aColumn < listControl_.numberOfColumns() );
-            strings_[column] = string;
-            return *this;
-        }
-
-        const String& stringAt(int column)const
-        {
-            return strings_[column];
+            return model_.data(row_,column);
         }
     private:
-        ListControl& listControl_;
-        Strings strings_;
-        Row& operator = (const Row& aRow);
+        const ListModel& model_;
+        size_t row_;
     };
-
-    typedef std::list<Row> Rows;
 public:
     ListControl(Window* parent = 0,const FloatRect& rect = FloatRect(0,0,64,128),uint32_t numColumns = 0);
     virtual ~ListControl();
@@ -58,14 +43,16 @@ public:
     uint32_t numberOfColumns() const { return int(columnWidths_.size()); }
     ListControl& setColumnWidths(const std::vector<float>& widths);
     float columnWidth(uint32_t index) const { return columnWidths_[index]; }
+    //! the row functions edit the control's own model,which is shown unless setModel replaced it
     ListControl& addRow(const std::vector<String>& strings);
     ListControl& removeRowAt(uint32_t pos);
-    uint32_t numberOfRows() const { return int(rows_.size()); }
-    size_t numberOfEntries() const { return numberOfRows(); }
-    const Row& rowAt(uint32_t pos) const;
+    StringListModel& rows() { return rows_; }
+    uint32_t numberOfRows() const { return uint32_t(numberOfEntries()); }
+    //! row of the shown model
+    Row rowAt(uint32_t pos) const;
 
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 protected:
     virtual Window& onDraw();
@@ -74,7 +61,7 @@ protected:
 
     virtual float entryHeight() const;
 
-    Rows rows_;
+    StringListModel rows_;
     std::vector<float> columnWidths_;
     bool usingDefaultWidths_;
     Window& resizeColumns();
@@ -90,7 +77,7 @@ public:
 public:
     virtual void draw(const FloatRect& area,Canvas* canvas) const;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 protected:
     virtual void drawRow(size_t row,const FloatRect& rectangle) const;
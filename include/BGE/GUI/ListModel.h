@@ -0,0 +1,65 @@
+#ifndef BGE_GUI_LISTMODEL_H
+#define BGE_GUI_LISTMODEL_H
+#include <BGE/Config.h>
+#include <BGE/System/NonCopyable.h>
+#include <BGE/System/Sigslot.h>
+#include <BGE/System/String.h>
+#include <vector>
+
+namespace bge
+{
+
+//! rows of strings shown by list windows,views only ask for the rows they draw
+//! implementations may keep the rows in any store and produce them on demand
+class BGE_EXPORT_API ListModel : private NonCopyable
+{
+public:
+    virtual ~ListModel(){}
+public:
+    virtual size_t count()const = 0;
+    virtual size_t columns()const{return 1;}
+    //! empty for a row or column out of range
+    virtual String data(size_t row,size_t column)const = 0;
+public:
+    //! first row and number of rows,emitted after the change
+    Signal2<size_t,size_t> rowsInserted;
+    Signal2<size_t,size_t> rowsRemoved;
+    Signal2<size_t,size_t> rowsChanged;
+    //! all rows were replaced
+    Signal0 modelReset;
+};
+
+//! default model,the strings of all rows are kept row by row in one array
+class BGE_EXPORT_API StringListModel : public ListModel
+{
+public:
+    static const size_t npos = size_t(-1);
+public:
+    StringListModel(size_t columns = 1);
+public:
+    size_t count()const{return strings_.size() / columns_;}
+    size_t columns()const{return columns_;}
+    String data(size_t row,size_t column)const;
+    //! row and column must be in range
+    const String& at(size_t row,size_t column)const{return strings_[row * columns_ + column];}
+
+    //! removes all rows
+    StringListModel& setColumns(size_t columns);
+    StringListModel& reserve(size_t rows);
+    //! adds a row,columns past the passed strings are left empty
+    StringListModel& append(const String* strings,size_t count);
+    StringListModel& append(const String& string){return append(&string,1);}
+    StringListModel& insert(size_t row,const String* strings,size_t count);
+    StringListModel& remove(size_t row,size_t count = 1);
+    StringListModel& set(size_t row,size_t column,const String& string);
+    StringListModel& clear();
+    //! first row holding string in column,npos if there is none
+    size_t find(const String& string,size_t column = 0)const;
+private:
+    size_t columns_;
+    std::vector<String> strings_;
+};
+
+}
+
+#endif
@@ -7,6 +7,7 @@ namespace bge
 {
 
 class ScrollBar;
+class ListModel;
 class ListWindowMouseListener;
 class TextDesc;
 
@@ -20,7 +21,11 @@ public:
     int selectedIndex() const { return selectedIndex_; }
     int highlightedIndex() const { return highlightedIndex_; }
     ListWindow& select(int index);
-    virtual size_t numberOfEntries() const = 0;
+    size_t numberOfEntries() const;
+
+    //! rows shown by the window,the model is not owned and must outlive the window or be replaced first
+    ListWindow& setModel(ListModel* model);
+    ListModel* model() const { return model_; }
 public:
     Signal0 leftClicked;
     Signal0 rightClicked;
@@ -34,20 +39,26 @@ public:
     virtual Vector2f recommendedSize() const;
     const ScrollBar* verticalScrollBar() const { return verticalScrollBar_; }
     uint32_t firstVisibleEntry() const;
+    //! scrolls until entry is the first visible one or the end of the list is reached
+    ListWindow& scrollTo(size_t entry);
     void setScrollBarParameters();
 
     virtual bool containsFocus() const;
     virtual Window* windowBelow(const Vector2f& p);
     virtual bool doesHierarchyContain(Window* window) const;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-	virtual void deleteLater();
 protected:
+    virtual void destroy();
     virtual void onResize();
     virtual void onMove();
     virtual float entryHeight() const = 0;
     void onContentsChanged();
+    void onRowsInserted(size_t row,size_t count);
+    void onRowsRemoved(size_t row,size_t count);
+    void onRowsChanged(size_t row,size_t count);
+    void onModelReset();
     uint32_t entryIndexAt(const Vector2f& p) const;
     void highlight(int index);
 
@@ -60,6 +71,7 @@ private:
     friend class ListWindowMouseListener;
 
     ListWindowMouseListener*  listWindowMouseListener_;
+    ListModel* model_;
     int selectedIndex_;
     int highlightedIndex_;
     float lineHeightFactor_;
@@ -80,7 +92,7 @@ public:
 
     TextDesc& textDesc() { return *textDesc_; }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 protected:
     virtual void drawRow(size_t row,const FloatRect& rect)const = 0;
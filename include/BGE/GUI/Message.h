@@ -5,6 +5,7 @@
 #include <string>
 #include <BGE/System/String.h>
 #include <BGE/System/NonCopyable.h>
+#include <BGE/System/Arena.h>
 
 namespace bge
 {
@@ -150,6 +151,8 @@ class BGE_EXPORT_API MessageListener
 {
 public:
     virtual ~MessageListener(){}
+
+    BGE_ARENA_ALLOCATED
 public:
     virtual bool dispatchMessage(const Message& message,Window* receiver)
     {
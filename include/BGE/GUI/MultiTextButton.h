@@ -29,9 +29,8 @@ public:
         return *it;
     }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-	virtual void deleteLater();
 public:
     Signal1<const String&> selectionChanged;
 protected:
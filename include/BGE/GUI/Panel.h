@@ -9,6 +9,7 @@ namespace bge
 
 class PanelDesc;
 class ButtonGroup;
+class SpatialGrid;
 
 class BGE_EXPORT_API Panel : public Window
 {
@@ -17,7 +18,11 @@ public:
     Panel(const FloatRect& rectangle = FloatRect(0,0,148,148),Window* parent = 0,const String& text = L"");
     virtual ~Panel();
 public:
+    //! arranges the children now,otherwise the layout pass does it before the next frame
     Panel& arrangeChildren();
+    //! the children are arranged again in the next layout pass
+    Panel& invalidateLayout();
+    bool isLayoutScheduled()const{return isLayoutScheduled_;}
     Panel& setLayout(Layout* layouter);
 
     virtual bool process(const Message& message);
@@ -27,16 +32,27 @@ public:
 
     virtual Vector2f recommendedSize() const;
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 protected:
     virtual Window& onDraw();
     virtual void onResize();
     virtual void onMove();
+    virtual void onChildGeometryChanged(Window* child);
+private:
+    SpatialGrid* childGrid();
 private:
     Layout* layouter_;
 	ButtonGroup* buttonGroup_;
     PanelDesc* renderDesc_;
+    //! children of the layout for hit-testing,shifted with the panel and rebuilt when the layout changes
+    SpatialGrid* grid_;
+    uint32_t gridRevision_;
+    bool isGridValid_;
+    //! geometry the children were last arranged or shifted for
+    Vector2f layoutPosition_;
+    Vector2f layoutSize_;
+    bool isLayoutScheduled_;
 };
 
 class BGE_EXPORT_API PanelDesc : public RenderDesc
@@ -54,7 +70,7 @@ public:
 public:
     virtual void draw(const FloatRect& area,Canvas* canvas)const;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
     RenderDesc* background_;
@@ -47,10 +47,10 @@ public:
 
     virtual Vector2f recommendedSize() const;
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-	virtual void deleteLater();
 protected:
+    virtual void destroy();
     virtual Window& onDraw();
 
     virtual void onResize();
@@ -98,7 +98,7 @@ public:
 
     float width() const { return width_; }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 private:
     RenderDesc* background_;
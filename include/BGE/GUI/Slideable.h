@@ -37,7 +37,7 @@ public:
 
     uint32_t range() const;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 public:
     Signal1<int> valueChanged;
@@ -31,10 +31,10 @@ public:
     virtual bool process(const Message& message);
     virtual Vector2f recommendedSize() const;
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-	virtual void deleteLater();
 protected:
+    virtual void destroy();
     virtual void onResize();
     virtual void onMove();
     virtual Window& onDraw();
@@ -68,7 +68,7 @@ public:
     Color tickColor() const { return tickColor_; }
     float tickWidth() const { return tickWidth_; }
 public:
-    bool loadProperty(TiXmlNode* node);
+    bool loadProperty(const PropertyNode& node);
     bool saveProperty(TiXmlNode* node);
 private:
     RenderDesc* background_;
@@ -20,10 +20,10 @@ public:
     virtual bool process(const Message& message);
     virtual Vector2f recommendedSize()const;
     virtual bool loadAppearance(const std::string& file);
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
-	virtual void deleteLater();
 protected:
+    virtual void destroy();
     virtual Window& onDraw();
     virtual void onResize();
     virtual void onMove();
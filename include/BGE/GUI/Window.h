@@ -42,6 +42,8 @@ public:
     virtual bool containsFocus() const { return isFocused(); }
 public:
     Window& render();
+    //! requests a redraw of the area covered by the window,for changes not caused by input or timers
+    Window& update();
 
     Window& addMessageListener(MessageListener* listener);
     Window& removeMessageListener(MessageListener* listener);
@@ -49,8 +51,8 @@ public:
     Window& show();
     Window& hide();
 
-    Window& enable() { isEnabled_ = true; return*this; }
-    Window& disable() { isEnabled_ = false; return*this; }
+    Window& enable();
+    Window& disable();
     bool isEnabled() const { return isEnabled_; }
 
     bool isVisible() const;
@@ -64,7 +66,7 @@ public:
     Window& setAsActiveWindow();
 
     virtual bool loadAppearance(const std::string& file) = 0;
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 
     virtual bool doesHierarchyContain(Window* other)const{return this == other;}
@@ -81,8 +83,12 @@ protected:
     virtual void onHide(){}
     virtual void onGainedFocus(){}
     virtual void onLostFocus(){}
+    //! called after a child window was moved or resized
+    virtual void onChildGeometryChanged(Window*){}
 protected:
     void setWidgetType(bool widget);
+private:
+    void notifyParent();
 private:
     MessageListeners messageListeners_;
     String text_;
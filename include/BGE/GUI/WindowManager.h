@@ -4,6 +4,7 @@
 #include <BGE/System/Math.h>
 #include <BGE/System/NonCopyable.h>
 #include <BGE/System/Sigslot.h>
+#include <BGE/System/TaskQueue.h>
 #include <BGE/Graphics/Color.h>
 #include <BGE/Graphics/Canvas.h>
 #include <BGE/GUI/Dock.h>
@@ -12,13 +13,32 @@ namespace bge
 {
 
 class Window;
+class Panel;
 class Timer;
 class Message;
 class PropertyScheme;
 class MouseClickMessage;
 
+//! layout work done for one frame
+struct LayoutStatistics
+{
+    LayoutStatistics():
+        arranged_(0),
+        shifted_(0)
+    {
+    }
+
+    //! layouts arranged,their children were measured and placed again
+    uint32_t arranged_;
+    //! layouts moved along with their panel,their children were only shifted
+    uint32_t shifted_;
+};
+
 class BGE_EXPORT_API WindowManager : NonCopyable
 {
+public:
+    //! wakes the event loop,called from the thread posting a task
+    typedef void (*WakeUp)();
 public:
     virtual ~WindowManager();
 public:
@@ -29,21 +49,62 @@ public:
 public:
     static WindowManager& instance();
 
-    virtual WindowManager& initialize(const std::string& font,bool autoDelete = false) = 0;
+    //! canvas is owned by window manager,the batched opengl canvas is used if it is null
+    virtual WindowManager& initialize(const std::string& font,bool autoDelete = false,Canvas* canvas = 0) = 0;
     virtual void terminate() = 0;
 
+    //! file is the xml saveWindow writes or its image made by CompiledDocument::compile
     virtual Window* createWindow(const std::string& file) = 0;
 	virtual bool saveWindow(Window* window,const std::string& file) = 0;
+    //! every window file is loaded into an arena of its own,the objects of a screen are freed in bulk when the last one is destroyed
+    virtual WindowManager& setLoadingArenas(bool arenas) = 0;
+    virtual bool isLoadingArenas() const = 0;
 
     virtual WindowManager& addWindow(Window* window) = 0;
     virtual Window* popUpWindow() const = 0;
     virtual WindowManager& removeAllWindows() = 0;
     virtual WindowManager& removeWindow(Window* window) = 0;
     virtual bool isTopLevelWindow(Window* window) const = 0;
+    //! started timers are triggered by update without being added,kept for older code
     virtual WindowManager& addTimer(Timer* timer) = 0;
+    //! stops the timer
     virtual WindowManager& removeTimer(Timer* timer) = 0;
     virtual WindowManager& checkForWindowBelowCursor() = 0;
     virtual const WindowManager& update() const = 0;
+    //! marks the screen as changed so the next frame is rendered
+    virtual WindowManager& invalidate() = 0;
+    //! marks an area in screen coordinates as changed,only damaged areas are redrawn while the canvas keeps the last frame
+    virtual WindowManager& invalidate(const FloatRect& rectangle) = 0;
+    //! flashes redrawn areas with a translucent overlay
+    virtual WindowManager& setDamageDebugging(bool debugging) = 0;
+    virtual bool isDamageDebugging() const = 0;
+    //! triggers elapsed timers and returns true if anything changed since the last update
+    //! queued objects are destroyed here too,a teardown alone draws no frame
+    virtual bool needsUpdate() = 0;
+    //! seconds until the next deadline of the timer wheel,negative if no timer is running,zero while objects wait to be destroyed
+    virtual float idleTimeout() const = 0;
+    virtual uint64_t renderedFrames() const = 0;
+    virtual uint64_t skippedFrames() const = 0;
+    //! arranges the panel in the layout pass run before the next frame is drawn
+    virtual WindowManager& scheduleLayout(Panel* panel) = 0;
+    virtual WindowManager& cancelLayout(Panel* panel) = 0;
+    virtual WindowManager& countLayout(bool arranged) = 0;
+    //! layout work of the last frame drawn
+    virtual LayoutStatistics layoutStatistics() const = 0;
+    //! thread safe,the task runs on the ui thread when the next update starts
+    virtual WindowManager& post(TaskQueue::Task task) = 0;
+    //! thread safe,the tasks run in order without tasks of other threads in between
+    virtual WindowManager& post(std::vector<TaskQueue::Task> tasks) = 0;
+    //! seconds an update spends on posted tasks,the rest wait for the next update
+    virtual WindowManager& setTaskBudget(float seconds) = 0;
+    //! seconds a frame spends destroying objects,needsUpdate and update share them
+    //! large trees are torn down over several frames,an object started is finished so a frame may run over by one
+    virtual WindowManager& setDeletionBudget(float seconds) = 0;
+    //! destroys every object deleteLater queued,whatever the budget
+    virtual WindowManager& deleteQueuedObjects() = 0;
+    virtual size_t queuedDeletions() const = 0;
+    //! set by the device,glfwPostEmptyEvent for glfw
+    virtual WindowManager& setWakeUp(WakeUp wakeUp) = 0;
     virtual WindowManager& setMouseCapture(Window* window) = 0;
     virtual WindowManager& releaseMouseCapture() = 0;
     virtual Window* captureWindow() const = 0;
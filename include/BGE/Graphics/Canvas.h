@@ -11,6 +11,35 @@ namespace bge
 
 class TextRenderer;
 
+//! per-frame submission counters, collected between preRender and postRender
+struct CanvasStatistics
+{
+    CanvasStatistics():
+        drawCalls_(0),
+        vertices_(0)
+    {
+    }
+
+    uint32_t drawCalls_;
+    uint32_t vertices_;
+};
+
+//! font files held in memory by the canvas,every point size of a file shares them
+struct FontStatistics
+{
+    FontStatistics():
+        files_(0),
+        users_(0),
+        bytes_(0)
+    {
+    }
+
+    uint32_t files_;
+    //! text renderers reading from the files
+    uint32_t users_;
+    uint64_t bytes_;
+};
+
 class BGE_EXPORT_API Canvas : private NonCopyable
 {
 public:
@@ -35,12 +64,26 @@ public:
     virtual void registerImage(Image* image) = 0;
     virtual void unregisterImage(int32_t handle) = 0;
 	virtual TextRenderer* createText(const std::string& name,int point) = 0;
+    //! font files loaded for the text renderers created so far
+    virtual FontStatistics fontStatistics()const = 0;
 
     virtual void drawDroppedRectangle(const FloatRect& rectangle,const Color& color1,const Color& color2) = 0;
     virtual void drawRaisedRectangle(const FloatRect& rectangle,const Color& color1, const Color& color2) = 0;
 
     virtual void preRender(int width,int height) = 0;
     virtual void postRender() = 0;
+    //! submit queued geometry,call it before issuing opengl commands directly
+    virtual void flush() = 0;
+    //! counters of the last finished frame
+    virtual CanvasStatistics statistics()const = 0;
+
+    //! draws the frame kept by preserveFrame,returns false if there is none of the current size
+    virtual bool restoreFrame() = 0;
+    //! clears rectangle and confines drawing to it until the next call,clip rectangles are intersected with it
+    //! an empty rectangle removes the limit
+    virtual void setDamage(const FloatRect& rectangle) = 0;
+    //! keeps what has been drawn so far for the next restoreFrame
+    virtual void preserveFrame() = 0;
 };
 
 }
@@ -39,9 +39,9 @@ BGE_EXPORT_API bool operator !=(const Color& left, const Color& right);
 void BGE_EXPORT_API serialize(const ObjectNamer<Color>& object,TiXmlNode* node);
 
 template<>
-inline Color deserialize<>(const char* name,TiXmlNode* node)
+inline Color deserialize<>(const char* name,const PropertyNode& node)
 {
-    TiXmlNode* element = node->FirstChildElement(name);
+    PropertyNode element = node.firstChild(name);
     Color color;
     color.r_ = deserialize<float>("r",element);
     color.g_ = deserialize<float>("g",element);
@@ -30,6 +30,8 @@ public:
     virtual void preRender() = 0;
     virtual void swapBuffers() = 0;
     virtual void pollEvents() = 0;
+    //! sleeps until an event arrives or timeout seconds passed,negative timeout waits without limit
+    virtual void waitEvents(float timeout) = 0;
 };
 
 }
@@ -26,7 +26,7 @@ public:
 public:
     virtual void draw(const FloatRect& area,Canvas* canvas)const = 0;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 };
 
@@ -46,7 +46,7 @@ public:
 
     virtual void draw(const FloatRect& area,Canvas* canvas) const;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 private:
     Color color_;
@@ -96,7 +96,7 @@ public:
 
     virtual void draw(const FloatRect& area,Canvas* canvas) const;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 private:
     Color color1_;
@@ -156,7 +156,7 @@ public:
     }
     virtual void draw(const FloatRect& area,Canvas* canvas) const;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 private:
     RectangleStyle style_;
@@ -212,7 +212,7 @@ public:
 
     void reloadTextRenderer();
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 private:
     std::string fileName_;
@@ -244,7 +244,7 @@ public:
         return *this;
     }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 private:
     Color color_;
@@ -297,7 +297,7 @@ public:
         return *this;
     }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 private:
     FrameSection section_;
@@ -337,7 +337,7 @@ public:
     int left() const { return left_; }
     int right() const { return right_; }
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 protected:
     std::string fileName_;
@@ -359,7 +359,7 @@ public:
 public:
     virtual void draw(const FloatRect& area,Canvas* canvas) const;
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node,const char* name = 0);
 private:
     int leftOffset_;
@@ -367,15 +367,15 @@ private:
 };
 
 #define CREATE_BY_NODE(x,node,target)\
-    TiXmlElement* x = node->FirstChildElement(#x);\
+    PropertyNode x = node.firstChild(#x);\
     if(x)\
     {\
-        std::string classname = x->Attribute("class");\
-        if(!classname.empty())\
+        Rtti* x##Rtti = x.rtti();\
+        if(x##Rtti)\
         {\
             if(x##_)\
                 x##_->deleteLater();\
-            x##_ = Object::castTo<target>(Rtti::rttiByObjectName(classname)->createObject());\
+            x##_ = Object::castTo<target>(x##Rtti->createObject());\
             if(x##_)\
                 x##_->loadProperty(x);\
         }\
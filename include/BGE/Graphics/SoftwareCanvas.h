@@ -0,0 +1,107 @@
+#ifndef BGE_GRAPHICS_SOFTWARECANVAS_H
+#define BGE_GRAPHICS_SOFTWARECANVAS_H
+#include <BGE/Graphics/Canvas.h>
+#include <map>
+#include <string>
+#include <vector>
+
+struct FT_LibraryRec_;
+
+namespace bge
+{
+
+class SoftwareTextRenderer;
+
+namespace Font
+{
+class FontRegistry;
+}
+
+//! canvas rasterizing on the cpu into a caller owned buffer,no opengl context is needed
+//! pixels are stored as r,g,b,a bytes,rows are stride bytes apart
+class BGE_EXPORT_API SoftwareCanvas : public Canvas
+{
+public:
+    SoftwareCanvas(uint8_t* buffer,int width,int height,int stride = 0);
+    ~SoftwareCanvas();
+public:
+    SoftwareCanvas& setBuffer(uint8_t* buffer,int width,int height,int stride = 0);
+    uint8_t* buffer()const{return buffer_;}
+    int width()const{return width_;}
+    int height()const{return height_;}
+    int stride()const{return stride_;}
+    //! fills the whole buffer ignoring clip rectangle and blending,damaged areas are cleared with the same color
+    SoftwareCanvas& clear(const Color& color);
+    //! pixels written in the last finished frame
+    uint64_t pixels()const{return lastPixels_;}
+public:
+    void drawLine(const Vector2f& start,const Vector2f& end);
+    void drawRectangle(const FloatRect& rectangle,bool filled);
+    void drawGradientFilledRectangle(const FloatRect& rectangle,const Color& color1,const Color& color2,bool horizontal);
+    void drawCircleSegment(const Vector2f& center,float radius,float t1,float t2,uint32_t numSegments,bool filled);
+    void drawCircle(const Vector2f& center,float radius,uint32_t numSegments,bool filled);
+    void drawRoundedRectangle(const FloatRect& rectangle,float radius,bool filled);
+    void enableClipRectangle(const FloatRect& rectangle);
+    void disableClipRectangle();
+    void setColor(const Color& color);
+    void setLineWidth(float width);
+    float maximumLineWidth()const;
+    float lineWidth()const{return lineWidth_;}
+    void drawTriangle(const Vector2f& p1,const Vector2f& p2,const Vector2f& p3,bool filled);
+    void drawImage(Image* image,const FloatRect& rect,bool tiled,float minx,float miny,float maxx,float maxy);
+    void enableTexturing(Image* image);
+    void disableTexturing();
+    //! images are sampled from their own pixels,there is nothing to upload or release
+    void registerImage(Image* image);
+    void unregisterImage(int32_t handle);
+    TextRenderer* createText(const std::string& name,int point);
+    FontStatistics fontStatistics()const;
+
+    void drawDroppedRectangle(const FloatRect& rectangle,const Color& color1,const Color& color2);
+    void drawRaisedRectangle(const FloatRect& rectangle,const Color& color1,const Color& color2);
+
+    void preRender(int width,int height);
+    void postRender();
+    void flush(){}
+    CanvasStatistics statistics()const{return lastStatistics_;}
+
+    //! the buffer itself keeps the previous frame as long as it is not replaced
+    bool restoreFrame(){return framePreserved_;}
+    void setDamage(const FloatRect& rectangle);
+    void preserveFrame(){framePreserved_ = true;}
+private:
+    friend class SoftwareTextRenderer;
+
+    void fillConvex(const Vector2f* points,size_t count);
+    void fillSpan(int y,int x0,int x1,const uint8_t* color);
+    void blendPixel(uint8_t* pixel,const uint8_t* color,uint32_t alpha);
+    void blendMask(int x,int y,const uint8_t* mask,int width,int height,int pitch);
+    void packColor(const Color& color,uint8_t* packed)const;
+    uint8_t* pixelAt(int x,int y)const{return buffer_ + y * stride_ + x * 4;}
+private:
+    uint8_t* buffer_;
+    int width_;
+    int height_;
+    int stride_;
+    int clipLeft_,clipTop_,clipRight_,clipBottom_;
+    int damageLeft_,damageTop_,damageRight_,damageBottom_;
+    uint8_t background_[4];
+    bool framePreserved_;
+    uint8_t color_[4];
+    float lineWidth_;
+    Image* texture_;
+    //! texel offsets of the columns drawImage is filling
+    std::vector<size_t> columns_;
+    FT_LibraryRec_* library_;
+    //! font files shared by the text renderers of all sizes
+    Font::FontRegistry* fontRegistry_;
+    std::map<std::string,SoftwareTextRenderer*> fonts_;
+    CanvasStatistics statistics_;
+    CanvasStatistics lastStatistics_;
+    uint64_t pixels_;
+    uint64_t lastPixels_;
+};
+
+}
+
+#endif
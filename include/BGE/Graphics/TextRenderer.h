@@ -10,6 +10,44 @@
 namespace bge
 {
 
+//! kerning lookups answered from the cache and those which had to ask the font
+struct KerningStatistics
+{
+    KerningStatistics():
+        hits_(0),
+        misses_(0)
+    {
+    }
+
+    uint64_t hits_;
+    uint64_t misses_;
+};
+
+//! use of the textures glyphs are cached in
+struct GlyphAtlasStatistics
+{
+    GlyphAtlasStatistics():
+        pages_(0),
+        bytes_(0),
+        budget_(0),
+        glyphs_(0),
+        occupancy_(0.0f),
+        evictions_(0),
+        defragmentations_(0)
+    {
+    }
+
+    uint32_t pages_;
+    uint64_t bytes_;
+    uint64_t budget_;
+    //! glyphs currently held in the textures
+    uint32_t glyphs_;
+    //! share of the texels covered by glyphs and their padding
+    float occupancy_;
+    uint64_t evictions_;
+    uint32_t defragmentations_;
+};
+
 class TextRenderer
 {
 protected:
@@ -27,6 +65,12 @@ public:
     virtual float width(const String& string) const = 0;
 
     virtual size_t hitCharacterIndex(const String& string,float offset) const = 0;
+    //! counters since the renderer was created,renderers without a kerning cache report zero
+    virtual KerningStatistics kerningStatistics() const { return KerningStatistics(); }
+    //! bytes of texture memory the cached glyphs may take,the least recently used ones are evicted beyond
+    //! the opengl renderer passes it to the atlas of its type face,renderers without an atlas ignore it
+    virtual TextRenderer& setAtlasBudget(size_t) { return *this; }
+    virtual GlyphAtlasStatistics atlasStatistics() const { return GlyphAtlasStatistics(); }
 private:
     std::string fontName_;
     size_t      pointSize_;
@@ -0,0 +1,81 @@
+#ifndef BGE_SYSTEM_ARENA_H
+#define BGE_SYSTEM_ARENA_H
+#include <BGE/Config.h>
+#include <BGE/System/NonCopyable.h>
+#include <atomic>
+#include <cstddef>
+
+//! objects of the class are allocated from the current arena of the thread creating them,or from the heap
+#define BGE_ARENA_ALLOCATED \
+public:\
+    static void* operator new(size_t size){return bge::Arena::allocateObject(size);}\
+    static void operator delete(void* memory){bge::Arena::freeObject(memory);}
+
+namespace bge
+{
+
+//! memory held by arenas and the objects allocated through them
+struct ArenaStatistics
+{
+    ArenaStatistics():
+        arenas_(0),
+        blocks_(0),
+        bytes_(0),
+        objects_(0),
+        heapObjects_(0)
+    {
+    }
+
+    //! arenas still open or holding objects
+    uint32_t arenas_;
+    uint32_t blocks_;
+    uint64_t bytes_;
+    //! live objects placed in an arena
+    uint32_t objects_;
+    //! live objects allocated one by one from the heap
+    uint32_t heapObjects_;
+};
+
+//! a monotonic region,the objects allocated while it is current are released in bulk
+//! destroying one of them runs its destructor,the memory is returned with the last one
+class BGE_EXPORT_API Arena : NonCopyable
+{
+public:
+    static Arena* create(size_t blockSize = 64 * 1024);
+    //! no scope may use the arena after,it is deleted once its objects are destroyed
+    void close();
+public:
+    //! the arena objects of the calling thread are allocated from,null for the heap
+    static Arena* current();
+    static void* allocateObject(size_t size);
+    static void freeObject(void* memory);
+    static ArenaStatistics statistics();
+private:
+    struct Block;
+private:
+    Arena(size_t blockSize);
+    ~Arena();
+    void* allocate(size_t size);
+    void release();
+private:
+    Block* blocks_;
+    char* position_;
+    char* end_;
+    size_t blockSize_;
+    //! one for each live object,one more until the arena is closed
+    std::atomic<size_t> references_;
+};
+
+//! makes an arena current for the calling thread,the one before is restored at the end of the scope
+class BGE_EXPORT_API ArenaScope : NonCopyable
+{
+public:
+    ArenaScope(Arena* arena);
+    ~ArenaScope();
+private:
+    Arena* previous_;
+};
+
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef BGE_SYSTEM_COMPILEDDOCUMENT_H
+#define BGE_SYSTEM_COMPILEDDOCUMENT_H
+#include <BGE/Config.h>
+#include <BGE/System/NonCopyable.h>
+#include <BGE/System/TinyXml.h>
+#include <BGE/System/PropertyNode.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace bge
+{
+
+class Rtti;
+struct ImageTables;
+
+//! a window description compiled offline from the xml WindowManager::saveWindow writes
+//! elements,attributes and texts are kept in document order,every name and text is stored once in a string table
+//! the class attributes are gathered in a table of their own and resolved once per class when the image is loaded
+//! the loaders read the image through PropertyNode,no node is built and every class comes from the table
+class BGE_EXPORT_API CompiledDocument : NonCopyable
+{
+public:
+    //! comments,declarations and unknown nodes are left out
+    static bool compile(const TiXmlDocument& document,std::vector<char>& image);
+    //! loads the xml file source and writes its image to target
+    static bool compile(const std::string& source,const std::string& target);
+public:
+    CompiledDocument();
+    ~CompiledDocument();
+public:
+    //! maps a local file,a file of the resource package is read
+    //! fails quietly when the file is not an image,it may be xml
+    bool load(const std::string& file);
+    //! adopts a copy of an image built in memory
+    bool load(const std::vector<char>& image);
+    void close();
+    bool isLoaded()const{return image_ != 0;}
+
+    //! the first element under the document,what loadProperty of the window reads
+    //! valid while the image stays loaded
+    PropertyNode rootElement()const;
+    //! creates the nodes of the image under document,no text is parsed
+    //! for tools comparing an image with its xml,loading windows does not need it
+    bool build(TiXmlDocument& document)const;
+private:
+    friend class PropertyNode;
+    //! the queries of PropertyNode,indices are those of the nodes in the image
+    PropertyNode firstChild(uint32_t index,const char* name)const;
+    PropertyNode nextSibling(uint32_t index,const char* name)const;
+    const char* name(uint32_t index)const;
+    const char* attribute(uint32_t index,const char* name)const;
+    const char* text(uint32_t index)const;
+    Rtti* rtti(uint32_t index)const;
+private:
+    bool open(const char* image,size_t size);
+    bool map(const std::string& file);
+    void unmap();
+private:
+    const char* image_;
+    size_t size_;
+    //! the memory of a mapped file,or of an image read from the resource package
+    void* mapping_;
+    std::vector<char> buffer_;
+    //! located when the image is opened
+    ImageTables* tables_;
+    std::vector<Rtti*> classes_;
+};
+
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef BGE_SYSTEM_DELETIONQUEUE_H
+#define BGE_SYSTEM_DELETIONQUEUE_H
+#include <BGE/Config.h>
+#include <BGE/System/NonCopyable.h>
+#include <cstddef>
+#include <deque>
+
+namespace bge
+{
+
+class Object;
+
+//! objects whose deleteLater was called,destroyed by the owner of the queue between frames
+//! a destroyed object hands its children to the queue,large trees are torn down over several passes
+//! an object with many children hands them a batch at a time before it is destroyed itself
+class BGE_EXPORT_API DeletionQueue : NonCopyable
+{
+public:
+    //! registers the queue deleteLater uses on the calling thread,null makes it delete at once
+    static void setCurrent(DeletionQueue* queue);
+    static DeletionQueue* current();
+public:
+    DeletionQueue();
+    //! objects left are destroyed
+    ~DeletionQueue();
+public:
+    //! called by Object::deleteLater
+    DeletionQueue& push(Object* object);
+    //! called when a queued object is deleted directly
+    DeletionQueue& cancel(Object* object);
+
+    //! destroys the objects queued before the call,objects queued meanwhile wait for the next call
+    //! the budget is checked before each object but the first,a negative one destroys all of them
+    //! returns how many were destroyed
+    size_t destroy(float budget);
+    bool isEmpty()const{return objects_.empty();}
+    size_t size()const{return objects_.size();}
+private:
+    //! a cancelled object leaves a null
+    std::deque<Object*> objects_;
+    //! objects taken from the front so far,the position an object was queued at less it is its index
+    size_t taken_;
+};
+
+}
+
+#endif
@@ -6,6 +6,7 @@
 namespace bge
 {
 
+//! kept for older code,every line is logged as an error,see Log
 BGE_EXPORT_API std::ostream& err();
 
 }
@@ -0,0 +1,106 @@
+#ifndef BGE_SYSTEM_LOG_H
+#define BGE_SYSTEM_LOG_H
+#include <BGE/Config.h>
+#include <BGE/System/NonCopyable.h>
+#include <atomic>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+namespace bge
+{
+
+enum LogLevel
+{
+    LogLevel_debug = 0x00,
+    LogLevel_info,
+    LogLevel_warning,
+    LogLevel_error,
+    //! as a threshold,nothing is written
+    LogLevel_none
+};
+
+enum LogCategory
+{
+    LogCategory_general = 0x00,
+    LogCategory_system,
+    LogCategory_graphics,
+    LogCategory_font,
+    LogCategory_gui,
+    LogCategory_count
+};
+
+//! messages are queued without locking and written by a background thread
+//! a message that finds the queue full is dropped and counted
+class BGE_EXPORT_API Log : NonCopyable
+{
+public:
+    //! longest message,longer ones are cut
+    static const size_t maxMessageLength = 240;
+public:
+    static Log& instance();
+public:
+    bool isEnabled(LogCategory category,LogLevel level)const
+    {
+        return int(level) >= levels_[category].load(std::memory_order_relaxed);
+    }
+    LogLevel level(LogCategory category)const{return LogLevel(levels_[category].load(std::memory_order_relaxed));}
+    //! threshold of all categories
+    Log& setLevel(LogLevel level);
+    Log& setLevel(LogCategory category,LogLevel level);
+
+    //! empty for stderr,the file is created again
+    virtual bool setOutput(const std::string& file) = 0;
+    virtual void write(LogCategory category,LogLevel level,const char* text,size_t length) = 0;
+    //! returns after every queued message was written
+    virtual void flush() = 0;
+    virtual uint64_t droppedMessages()const = 0;
+protected:
+    Log();
+    virtual ~Log();
+private:
+    std::atomic<int> levels_[LogCategory_count];
+};
+
+//! formats one message on the stack,queues it when destroyed
+class BGE_EXPORT_API LogMessage : NonCopyable
+{
+public:
+    LogMessage(LogCategory category,LogLevel level);
+    ~LogMessage();
+public:
+    std::ostream& stream(){return stream_;}
+private:
+    class Buffer : public std::streambuf
+    {
+    public:
+        Buffer(){setp(text_,text_ + Log::maxMessageLength);}
+        const char* text()const{return text_;}
+        size_t length()const{return size_t(pptr() - pbase());}
+    private:
+        char text_[Log::maxMessageLength];
+    };
+private:
+    LogCategory category_;
+    LogLevel level_;
+    Buffer buffer_;
+    std::ostream stream_;
+};
+
+}
+
+//! streams a message when the level is enabled,nothing after the macro is evaluated otherwise
+#define BGE_LOG(category,level)\
+    if(!bge::Log::instance().isEnabled(category,level)) ; else bge::LogMessage(category,level).stream()
+
+//! debug messages are compiled out of release builds,define BGE_LOG_KEEP_DEBUG to keep them
+#if !defined(BGE_DEBUG) && !defined(BGE_LOG_KEEP_DEBUG)
+    #define BGE_LOG_DEBUG(category) if(true) ; else bge::LogMessage(category,bge::LogLevel_debug).stream()
+#else
+    #define BGE_LOG_DEBUG(category) BGE_LOG(category,bge::LogLevel_debug)
+#endif
+#define BGE_LOG_INFO(category) BGE_LOG(category,bge::LogLevel_info)
+#define BGE_LOG_WARNING(category) BGE_LOG(category,bge::LogLevel_warning)
+#define BGE_LOG_ERROR(category) BGE_LOG(category,bge::LogLevel_error)
+
+#endif
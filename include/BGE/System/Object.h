@@ -2,11 +2,17 @@
 #ifndef BGE_SYSTEM_OBJECT_H
 #define BGE_SYSTEM_OBJECT_H
 #include <BGE/Config.h>
+#include <BGE/System/Arena.h>
+#include <BGE/System/DeletionQueue.h>
+#include <BGE/System/PropertyNode.h>
 #include <BGE/System/Deleter.h>
+#include <BGE/System/SmallVector.h>
 #include <BGE/System/TinyXml.h>
 #include <list>
 #include <string>
 #include <map>
+#include <type_traits>
+#include <unordered_map>
 
 #define RUNTIME_RTTI(object)\
     (bge::Rtti*)(&object::rtti##object)
@@ -14,6 +20,8 @@
 #define DECLARE_OBJECT(object)\
 public: \
 	static  const bge::Rtti rtti##object;\
+	typedef object RttiClass;\
+	static const bge::Rtti& classRtti(){return rtti##object;}\
 	virtual const bge::Rtti* getRtti()const;\
 	virtual std::string objectName()const;
 
@@ -51,6 +59,8 @@ public:
 	Object(Object* parent = NULL);
 //protected:
     virtual ~Object();
+
+    BGE_ARENA_ALLOCATED
 public:
     bool  isExactly(const Rtti& type)const;
     bool  isDerived(const Rtti& base)const;
@@ -65,57 +75,112 @@ public:
     Object* parent()const;
     void setParent(Object* parent);
 
-    Object* findChild(const std::string& name);
+    //! names separated by '/' are looked up among the children of the object found before
+    //! recursive searches the whole subtree for the first name,nearer objects first
+    //! if names repeat the child at the lowest position is returned,removing a child moves the last one to its place
+    Object* findChild(const std::string& name,bool recursive = false);
     bool hasChild(Object* obj);
 
 	void remove();
 	void removeAllChild();
 
     // no call.
+    //! the last child takes the place of the removed one,the order of the children is not kept
     void removeChild(Object* child);
     void insertChild(Object* child);
 public:
+    //! compares the rtti of the object,T must declare its own with DECLARE_OBJECT
 	template<class T>
-    static T* castTo(Object* o)
-	{
-	    return dynamic_cast<T*>(o);
-	}
+    static T* castTo(Object* o);
 
+    //! the object is destroyed by the deletion queue of the thread between frames,at once without one
+    //! it stays in the tree until then,it may be called from a slot of the object itself
     virtual void deleteLater();
+    bool isDeletionQueued()const{return isDeletionQueued_;}
 public:
-    virtual bool loadProperty(TiXmlNode* node);
+    virtual bool loadProperty(const PropertyNode& node);
     virtual bool saveProperty(TiXmlNode* node);
 protected:
     virtual void setWidgetType(bool widget);
+    //! detaches and deletes the object,the children are deleted later
+    //! overridden to release what must go before the children
+    virtual void destroy();
+private:
+    friend class DeletionQueue;
+private:
+    typedef SmallVector<Object*,4> ChildList;
+    typedef std::unordered_multimap<std::string,Object*> NameIndex;
+private:
+    Object* findDirectChild(const std::string& name);
+    Object* findDescendant(const std::string& name);
+    void changeName(const std::string& name);
+    void indexChild(Object* child);
+    void unindexChild(Object* child);
+    //! detaches the last count children and queues them,called by the queue before the object is destroyed
+    void handLastChildren(size_t count);
 private:
     Object* parent_;
+    //! position in the children of the parent
+    size_t childIndex_;
     std::string name_;
-	std::list<Object*>* children_;
+    ChildList children_;
+    //! built when a parent with many children is searched first,kept up to date after
+    NameIndex* nameIndex_;
     bool isWidget_;
+    bool isDeletionQueued_;
+    //! position in the deletion queue while it is queued
+    size_t deletionIndex_;
 private:
 	DECLARE_OBJECT(Object)
 };
 
 typedef Object* (* ObjectCreatePtr)();
 
+//! every rtti is static,registered by name when constructed and never changed after static initialization
+//! a class knows its ancestors by depth,isDerived takes one comparison
 class BGE_EXPORT_API Rtti
 {
+public:
+    //! deeper classes are checked by walking the parents
+    static const uint32_t maxDepth = 16;
 public:
     Rtti(const std::string &name,const Rtti* parent,uint32_t size,ObjectCreatePtr ptr);
 	~Rtti();
 public:
-    std::string name()const;
+    //! interned,the same string for every object of the class
+    const std::string& name()const;
+    uint32_t hash()const{return hash_;}
     uint32_t diskUsed()const;
+    //! number of ancestors
+    uint32_t depth()const{return depth_;}
 
     bool isExactly(const Rtti& type)const;
-    bool isDerived(const Rtti& type)const;
+    bool isDerived(const Rtti& type)const
+    {
+        if(type.depth_ > depth_)
+            return false;
+        if(type.depth_ < maxDepth)
+            return ancestors_[type.depth_] == &type;
+        return isDeeplyDerived(type);
+    }
 
     Object* createObject();
 
 	static const Rtti* first(){return first_;}
 	const Rtti* next()const{return next_;}
     const Rtti* parent()const{return parent_;}
+    //! null for unknown names
 	static Rtti* rttiByObjectName(const std::string & objectname);
+    //! null for unknown names and null
+	static Rtti* rttiByObjectName(const char* objectname);
+private:
+    Rtti(const Rtti&);
+    Rtti& operator=(const Rtti&);
+private:
+    static Rtti* find(const char* name,size_t length);
+    //! sets depth and ancestors once the parent has them,then does so for the classes derived
+    void link()const;
+    bool isDeeplyDerived(const Rtti& type)const;
 private:
     const std::string   name_;
     const Rtti*         parent_;
@@ -123,9 +188,21 @@ private:
 	ObjectCreatePtr     creator_;
     static Rtti*        first_;
 	Rtti*               next_;
-	static std::map<std::string,Rtti*> rttitable;
+    uint32_t            hash_;
+    mutable uint32_t    depth_;
+    //! false until linked,also while the rtti is not constructed yet
+    mutable bool        isLinked_;
+    //! ancestors_[n] is the ancestor of depth n,the class itself at depth_
+    mutable const Rtti* ancestors_[maxDepth];
 };
 
+template<class T>
+inline T* Object::castTo(Object* o)
+{
+    static_assert(std::is_same<typename T::RttiClass,T>::value,"castTo needs DECLARE_OBJECT in the class cast to");
+    return o && o->getRtti()->isDerived(T::classRtti()) ? static_cast<T*>(o) : NULL;
+}
+
 struct ObjectFactory
 {
     template<class Base,class Product>
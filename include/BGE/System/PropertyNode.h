@@ -0,0 +1,45 @@
+#ifndef BGE_SYSTEM_PROPERTYNODE_H
+#define BGE_SYSTEM_PROPERTYNODE_H
+#include <BGE/Config.h>
+#include <BGE/System/TinyXml.h>
+
+namespace bge
+{
+
+class Rtti;
+class CompiledDocument;
+
+//! an element read by loadProperty,either an element parsed from xml or a node of a compiled document
+//! it is a handle,the document behind it must outlive it
+//! a missing element is a null node,every query on it gives null
+class BGE_EXPORT_API PropertyNode
+{
+public:
+    PropertyNode();
+    //! anything but an element gives a null node
+    PropertyNode(TiXmlNode* node);
+    PropertyNode(const CompiledDocument* document,uint32_t index);
+public:
+    explicit operator bool()const{return element_ != 0 || document_ != 0;}
+
+    //! the first child element with the name,the first child element at all without one
+    PropertyNode firstChild(const char* name = 0)const;
+    //! the next element with the name under the same parent,the next element at all without one
+    PropertyNode nextSibling(const char* name = 0)const;
+
+    const char* name()const;
+    //! null if the element has no such attribute
+    const char* attribute(const char* name)const;
+    //! the text of the first child,a space if it is not a text
+    const char* text()const;
+    //! the class named by the class attribute,a compiled document resolved it when it was loaded
+    Rtti* rtti()const;
+private:
+    TiXmlElement* element_;
+    const CompiledDocument* document_;
+    uint32_t index_;
+};
+
+}
+
+#endif
@@ -3,6 +3,7 @@
 #define BGE_SYSTEM_Serialization_H
 #include <BGE/Config.h>
 #include <BGE/System/TinyXml.h>
+#include <BGE/System/PropertyNode.h>
 #include <BGE/System/Math.h>
 #include <BGE/System/String.h>
 #include <BGE/System/Enum.h>
@@ -82,34 +83,33 @@ void serializeContainer(const ObjectNamer<Container>& object,TiXmlNode* node)
         serializeContainer(TAGGED_OBJECT(x),node);\
     }
 
+//! numbers are read from the text of the element in place
 template<class T>
-inline T deserialize(const char* name,TiXmlNode* node)
+inline T deserialize(const char* name,const PropertyNode& node)
 {
-    TiXmlElement* element = node->FirstChildElement(name);
+    PropertyNode element = node.firstChild(name);
 	if(!element)
 		return T();
-    std::string value = element->GetText();
-    return fromString<T>(value);
+    return fromString<T>(element.text());
 }
 
 template<class Container,class T>
-inline Container deserializeContainer(const char* name,TiXmlNode* node)
+inline Container deserializeContainer(const char* name,const PropertyNode& node)
 {
     Container container;
-    TiXmlElement* element = node->FirstChildElement(name);
+    PropertyNode element = node.firstChild(name).firstChild();
     while(element)
     {
-        std::string value = element->GetText();
-        container.push_back(fromString<T>(value));
-        element = element->NextSiblingElement();
+        container.push_back(fromString<T>(element.text()));
+        element = element.nextSibling();
     }
     return container;
 }
 
 template<>
-inline Vector2<float> deserialize<>(const char* name,TiXmlNode* node)
+inline Vector2<float> deserialize<>(const char* name,const PropertyNode& node)
 {
-    TiXmlNode* element = node->FirstChildElement(name);
+    PropertyNode element = node.firstChild(name);
     Vector2<float> vec2;
     vec2.x_ = deserialize<float>("x",element);
     vec2.y_ = deserialize<float>("y",element);
@@ -117,9 +117,19 @@ inline Vector2<float> deserialize<>(const char* name,TiXmlNode* node)
 }
 
 template<>
-inline Vector3<float> deserialize<>(const char* name,TiXmlNode* node)
+inline Vector2i deserialize<>(const char* name,const PropertyNode& node)
 {
-    TiXmlNode* element = node->FirstChildElement(name);
+    PropertyNode element = node.firstChild(name);
+    Vector2i vec2;
+    vec2.x_ = deserialize<int>("x",element);
+    vec2.y_ = deserialize<int>("y",element);
+    return vec2;
+}
+
+template<>
+inline Vector3<float> deserialize<>(const char* name,const PropertyNode& node)
+{
+    PropertyNode element = node.firstChild(name);
     Vector3<float> vec3;
     vec3.x_ = deserialize<float>("x",element);
     vec3.y_ = deserialize<float>("y",element);
@@ -128,12 +138,12 @@ inline Vector3<float> deserialize<>(const char* name,TiXmlNode* node)
 }
 
 template<>
-inline String deserialize(const char* name,TiXmlNode* node)
+inline String deserialize(const char* name,const PropertyNode& node)
 {
-    TiXmlElement* element = node->FirstChildElement(name);
-    std::string text = element->GetText();
+    PropertyNode element = node.firstChild(name);
 	String value;
-	splitAndConvert(text,',',value);
+	if(element)
+	    splitAndConvert(element.text(),',',value);
 	return value;
 }
 
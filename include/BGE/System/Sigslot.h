@@ -2,8 +2,17 @@
 #ifndef BGE_SIGSLOT_H
 #define BGE_SIGSLOT_H
 #include <BGE/Config.h>
-#include <set>
-#include <list>
+#include <BGE/System/SmallVector.h>
+#include <BGE/System/TaskQueue.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////
 /// ļԴsigslot
@@ -15,1347 +24,722 @@ namespace bge
 
 class SlotHolder;
 
-class BasicConnection0
+//! how a connected slot is called
+enum ConnectionType
 {
-public:
-    virtual SlotHolder* targetSlotHolder() const = 0;
-    virtual void emit() = 0;
-    virtual BasicConnection0* clone() = 0;
-	virtual BasicConnection0* duplicate(SlotHolder* newTarget) = 0;
-};
-
-template<class Type1>
-class BasicConnection1
-{
-public:
-	virtual SlotHolder* targetSlotHolder() const = 0;
-	virtual void emit(Type1) = 0;
-	virtual BasicConnection1<Type1>* clone() = 0;
-	virtual BasicConnection1<Type1>* duplicate(SlotHolder* newTarget) = 0;
-};
-
-template<class Type1, class Type2>
-class BasicConnection2
-{
-public:
-	virtual SlotHolder* targetSlotHolder() const = 0;
-	virtual void emit(Type1, Type2) = 0;
-	virtual BasicConnection2<Type1, Type2>* clone() = 0;
-	virtual BasicConnection2<Type1, Type2>* duplicate(SlotHolder* newTarget) = 0;
-};
-
-template<class Type1, class Type2, class Type3>
-class BasicConnection3
-{
-public:
-	virtual SlotHolder* targetSlotHolder() const = 0;
-	virtual void emit(Type1, Type2, Type3) = 0;
-	virtual BasicConnection3<Type1, Type2, Type3>* clone() = 0;
-	virtual BasicConnection3<Type1, Type2, Type3>* duplicate(SlotHolder* newTarget) = 0;
-};
-
-template<class Type1, class Type2, class Type3, class Type4>
-class BasicConnection4
-{
-public:
-	virtual SlotHolder* targetSlotHolder() const = 0;
-    virtual void emit(Type1, Type2, Type3, Type4) = 0;
-	virtual BasicConnection4<Type1, Type2, Type3, Type4>* clone() = 0;
-	virtual BasicConnection4<Type1, Type2, Type3, Type4>* duplicate(SlotHolder* newTarget) = 0;
-};
-
-template<class Type1, class Type2, class Type3, class Type4, class Type5>
-class BasicConnection5
-{
-public:
-	virtual SlotHolder* targetSlotHolder() const = 0;
-    virtual void emit(Type1, Type2, Type3, Type4, Type5) = 0;
-	virtual BasicConnection5<Type1, Type2, Type3, Type4, Type5>* clone() = 0;
-	virtual BasicConnection5<Type1, Type2, Type3, Type4, Type5>* duplicate(SlotHolder* newTarget) = 0;
-};
-
-class BasicSignal
-{
-public:
-    virtual ~BasicSignal() {}
-	virtual void disconnectSlot(SlotHolder* slot) = 0;
-	virtual void duplicateSlot(const SlotHolder* oldSlot, SlotHolder* newSlot) = 0;
-};
-
-class BGE_EXPORT_API SlotHolder
-{
-private:
-	typedef std::set<BasicSignal*> SenderSet;
-	typedef SenderSet::const_iterator const_iterator;
-public:
-	SlotHolder() {}
-
-	SlotHolder(const SlotHolder& holder)
-	{
-		const_iterator it    = holder.senders_.begin();
-		const_iterator itEnd = holder.senders_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->duplicateSlot(&holder, this);
-			senders_.insert(*it);
-			++it;
-		}
-	}
-
-	void connectTo(BasicSignal* sender)
-	{
-		senders_.insert(sender);
-	}
-
-	void disconnectFrom(BasicSignal* sender)
-	{
-		senders_.erase(sender);
-	}
-
-	virtual ~SlotHolder()
-	{
-		disconnectAll();
-	}
-
-	void disconnectAll()
-	{
-		const_iterator it = senders_.begin();
-		const_iterator itEnd = senders_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->disconnectSlot(this);
-			++it;
-		}
-
-		senders_.erase(senders_.begin(), senders_.end());
-	}
-private:
-    SenderSet senders_;
-};
-
-class BasicSignal0 : public BasicSignal
-{
-public:
-	typedef std::list<BasicConnection0 *>  ConnectionList;
-
-	BasicSignal0() {}
-
-	BasicSignal0(const BasicSignal0& s) : BasicSignal(s)
-	{
-        ConnectionList::const_iterator it = s.connectedSlots_.begin();
-	    ConnectionList::const_iterator itEnd = s.connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->connectTo(this);
-			connectedSlots_.push_back((*it)->clone());
-		    ++it;
-		}
-	}
-
-    ~BasicSignal0()
-	{
-		disconnectAll();
-	}
-
-	void disconnectAll()
-	{
-        ConnectionList::const_iterator it = connectedSlots_.begin();
-		ConnectionList::const_iterator itEnd = connectedSlots_.end();
-
-	    while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->disconnectFrom(this);
-			delete *it;
-            ++it;
-		}
-
-	    connectedSlots_.erase(connectedSlots_.begin(), connectedSlots_.end());
-	}
-
-	void disconnect(SlotHolder* slotHolder)
-	{
-		ConnectionList::iterator it = connectedSlots_.begin();
-		ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			if((*it)->targetSlotHolder() == slotHolder)
-		    {
-				delete *it;
-				connectedSlots_.erase(it);
-				slotHolder->disconnectFrom(this);
-				return;
-			}
-
-		    ++it;
-		}
-	}
-
-	void disconnectSlot(SlotHolder* slot)
-	{
-		ConnectionList::iterator it = connectedSlots_.begin();
-		ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			ConnectionList::iterator itNext = it;
-			++itNext;
-
-		    if((*it)->targetSlotHolder() == slot)
-			{
-				connectedSlots_.erase(it);
-				//!            delete *it;
-			}
-
-			it = itNext;
-		}
-	}
-
-	void duplicateSlot(const SlotHolder* oldTarget, SlotHolder* newTarget)
-	{
-		ConnectionList::iterator it = connectedSlots_.begin();
-		ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-		    if((*it)->targetSlotHolder() == oldTarget)
-			{
-			    connectedSlots_.push_back((*it)->duplicate(newTarget));
-			}
-
-			++it;
-		}
-	}
-protected:
-    ConnectionList connectedSlots_;
-};
-
-template<class Type1>
-class BasicSignal1 : public BasicSignal
-{
-public:
-	typedef std::list<BasicConnection1<Type1> *>  ConnectionList;
-
-	BasicSignal1(){}
-
-    BasicSignal1(const BasicSignal1<Type1>& s) : BasicSignal(s)
-	{
-		typename ConnectionList::const_iterator it = s.connectedSlots_.begin();
-		typename ConnectionList::const_iterator itEnd = s.connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->connectTo(this);
-			connectedSlots_.push_back((*it)->clone());
-            ++it;
-		}
-	}
-
-	void duplicateSlot(const SlotHolder* oldTarget, SlotHolder* newTarget)
-	{
-        typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-            if((*it)->targetSlotHolder() == oldTarget)
-			{
-				connectedSlots_.push_back((*it)->duplicate(newTarget));
-			}
-
-			++it;
-		}
-	}
-
-	~BasicSignal1()
-	{
-		disconnectAll();
-	}
-
-	void disconnectAll()
-	{
-        typename ConnectionList::const_iterator it = connectedSlots_.begin();
-	    typename ConnectionList::const_iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->disconnectFrom(this);
-			delete *it;
-			++it;
-		}
-
-		connectedSlots_.erase(connectedSlots_.begin(), connectedSlots_.end());
-	}
-
-	void disconnect(SlotHolder* slotHolder)
-	{
-        typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			if((*it)->targetSlotHolder() == slotHolder)
-			{
-				delete *it;
-				connectedSlots_.erase(it);
-				slotHolder->disconnectFrom(this);
-				return;
-			}
-
-			++it;
-		}
-	}
-
-	void disconnectSlot(SlotHolder* slot)
-	{
-        typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			typename ConnectionList::iterator itNext = it;
-			++itNext;
-
-			if((*it)->targetSlotHolder() == slot)
-			{
-			    connectedSlots_.erase(it);
-				//            delete *it;
-			}
-
-			it = itNext;
-		}
-	}
-protected:
-	ConnectionList connectedSlots_;
-};
-
-template<class Type1, class Type2>
-class BasicSignal2 : public BasicSignal
-{
-public:
-    typedef std::list<BasicConnection2<Type1, Type2> *> ConnectionList;
-
-    BasicSignal2() {}
-
-    BasicSignal2(const BasicSignal2<Type1, Type2>& s) : BasicSignal(s)
-    {
-        typename ConnectionList::const_iterator it = s.connectedSlots_.begin();
-        typename ConnectionList::const_iterator itEnd = s.connectedSlots_.end();
-
-        while(it != itEnd)
-        {
-            (*it)->targetSlotHolder()->connectTo(this);
-            connectedSlots_.push_back((*it)->clone());
-            ++it;
-        }
-    }
-
-    void duplicateSlot(const SlotHolder* oldTarget, SlotHolder* newTarget)
-    {
-        typename ConnectionList::iterator it = connectedSlots_.begin();
-        typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-        while(it != itEnd)
-        {
-            if((*it)->targetSlotHolder() == oldTarget)
-            {
-                connectedSlots_.push_back((*it)->duplicate(newTarget));
-            }
-
-            ++it;
-        }
-    }
-
-    ~BasicSignal2()
-    {
-        disconnectAll();
-    }
-
-    void disconnectAll()
-    {
-	    typename ConnectionList::const_iterator it = connectedSlots_.begin();
-		typename ConnectionList::const_iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->disconnectFrom(this);
-			delete *it;
-            ++it;
-		}
-
-		connectedSlots_.erase(connectedSlots_.begin(), connectedSlots_.end());
-    }
-
-    void disconnect(SlotHolder* slotHolder)
-    {
-        typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			if((*it)->targetSlotHolder() == slotHolder)
-			{
-				delete *it;
-				connectedSlots_.erase(it);
-				slotHolder->disconnectFrom(this);
-				return;
-			}
-            ++it;
-		}
-	}
-
-	void disconnectSlot(SlotHolder* slot)
-	{
-        typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			typename ConnectionList::iterator itNext = it;
-			++itNext;
-
-			if((*it)->targetSlotHolder() == slot)
-			{
-				connectedSlots_.erase(it);
-				//  delete *it;
-			}
-
-			it = itNext;
-		}
-	}
-
-protected:
-	ConnectionList connectedSlots_;
-};
-
-template<class Type1, class Type2, class Type3>
-class BasicSignal3 : public BasicSignal
-{
-public:
-	typedef std::list<BasicConnection3<Type1, Type2, Type3> *> ConnectionList;
-
-	BasicSignal3() {}
-
-	BasicSignal3(const BasicSignal3<Type1, Type2, Type3>& s) : BasicSignal(s)
-	{
-		typename ConnectionList::const_iterator it = s.connectedSlots_.begin();
-		typename ConnectionList::const_iterator itEnd = s.connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->connectTo(this);
-			connectedSlots_.push_back((*it)->clone());
-            ++it;
-		}
-	}
-
-	void duplicateSlot(const SlotHolder* oldTarget, SlotHolder* newTarget)
-	{
-        typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			if((*it)->targetSlotHolder() == oldTarget)
-			{
-				connectedSlots_.push_back((*it)->duplicate(newTarget));
-			}
-			++it;
-		}
-	}
-
-	~BasicSignal3()
-	{
-		disconnectAll();
-	}
-
-	void disconnectAll()
-	{
-		typename ConnectionList::const_iterator it = connectedSlots_.begin();
-		typename ConnectionList::const_iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->disconnectFrom(this);
-			delete *it;
-			++it;
-		}
-
-		connectedSlots_.erase(connectedSlots_.begin(), connectedSlots_.end());
-	}
-
-	void disconnect(SlotHolder* slotHolder)
-	{
-		typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			if((*it)->targetSlotHolder() == slotHolder)
-			{
-				delete *it;
-				connectedSlots_.erase(it);
-				slotHolder->disconnectFrom(this);
-				return;
-			}
-
-			++it;
-		}
-	}
-
-	void disconnectSlot(SlotHolder* slot)
-	{
-		typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			typename ConnectionList::iterator itNext = it;
-			++itNext;
-
-			if((*it)->targetSlotHolder() == slot)
-			{
-				connectedSlots_.erase(it);
-				//            delete *it;
-			}
-		    it = itNext;
-		}
-	}
-
-protected:
-	ConnectionList connectedSlots_;
-};
-
-template<class Type1, class Type2, class Type3, class Type4>
-class BasicSignal4 : public BasicSignal
-{
-public:
-	typedef std::list<BasicConnection4<Type1,Type2,Type3,Type4> *> ConnectionList;
-
-	BasicSignal4(){}
-
-	BasicSignal4(const BasicSignal4<Type1,Type2,Type3,Type4>& s):BasicSignal(s)
-	{
-		typename ConnectionList::const_iterator it = s.connectedSlots_.begin();
-		typename ConnectionList::const_iterator itEnd = s.connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->connectTo(this);
-			connectedSlots_.push_back((*it)->clone());
-            ++it;
-		}
-	}
-
-	void duplicateSlot(const SlotHolder* oldTarget, SlotHolder* newTarget)
-	{
-		typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			if((*it)->targetSlotHolder() == oldTarget)
-			{
-				connectedSlots_.push_back((*it)->duplicate(newTarget));
-			}
-
-			++it;
-		}
-	}
-
-	~BasicSignal4()
-	{
-		disconnectAll();
-	}
-
-	void disconnectAll()
-	{
-		typename ConnectionList::const_iterator it = connectedSlots_.begin();
-		typename ConnectionList::const_iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->disconnectFrom(this);
-			delete *it;
-            ++it;
-		}
-
-		connectedSlots_.erase(connectedSlots_.begin(), connectedSlots_.end());
-	}
-
-	void disconnect(SlotHolder* slotHolder)
-	{
-		typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			if((*it)->targetSlotHolder() == slotHolder)
-			{
-				delete *it;
-				connectedSlots_.erase(it);
-				slotHolder->disconnectFrom(this);
-				return;
-			}
-
-			++it;
-		}
-	}
-
-	void disconnectSlot(SlotHolder* slot)
-	{
-		typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			typename ConnectionList::iterator itNext = it;
-			++itNext;
-
-			if((*it)->targetSlotHolder() == slot)
-			{
-				connectedSlots_.erase(it);
-				//  delete *it;
-			}
-
-			it = itNext;
-		}
-	}
-
-protected:
-	ConnectionList connectedSlots_;
-};
-
-template<class Type1, class Type2, class Type3, class Type4, class Type5>
-class BasicSignal5 : public BasicSignal
-{
-public:
-	typedef std::list<BasicConnection5<Type1,Type2,Type3,Type4,Type5>*>  ConnectionList;
-
-	BasicSignal5(){}
-    BasicSignal5(const BasicSignal5<Type1, Type2, Type3, Type4, Type5>& s) : BasicSignal(s)
-	{
-		typename ConnectionList::const_iterator it = s.connectedSlots_.begin();
-		typename ConnectionList::const_iterator itEnd = s.connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->connectTo(this);
-			connectedSlots_.push_back((*it)->clone());
-            ++it;
-		}
-	}
-
-	void duplicateSlot(const SlotHolder* oldTarget, SlotHolder* newTarget)
-	{
-		typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			if((*it)->targetSlotHolder() == oldTarget)
-			{
-				connectedSlots_.push_back((*it)->duplicate(newTarget));
-			}
-
-			++it;
-		}
-	}
-
-	~BasicSignal5()
-	{
-		disconnectAll();
-	}
-
-	void disconnectAll()
-	{
-		typename ConnectionList::const_iterator it = connectedSlots_.begin();
-		typename ConnectionList::const_iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			(*it)->targetSlotHolder()->disconnectFrom(this);
-			delete *it;
-            ++it;
-		}
-
-		connectedSlots_.erase(connectedSlots_.begin(), connectedSlots_.end());
-	}
-
-	void disconnect(SlotHolder* slotHolder)
-	{
-		typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			if((*it)->targetSlotHolder() == slotHolder)
-			{
-				delete *it;
-				connectedSlots_.erase(it);
-				slotHolder->disconnectFrom(this);
-				return;
-			}
-
-			++it;
-		}
-	}
-
-	void disconnectSlot(SlotHolder* slot)
-	{
-		typename ConnectionList::iterator it = connectedSlots_.begin();
-		typename ConnectionList::iterator itEnd = connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			typename ConnectionList::iterator itNext = it;
-			++itNext;
-
-			if((*it)->targetSlotHolder() == slot)
-			{
-				connectedSlots_.erase(it);
-				//  delete *it;
-			}
-
-			it = itNext;
-		}
-	}
-protected:
-	ConnectionList connectedSlots_;
-};
-
-template<class TargetType>
-class Connection0 : public BasicConnection0
-{
-public:
-	Connection0()
-	{
-		object_ = 0;
-		memberFunction_ = 0;
-		voidMemberFunction_ = 0;
-	}
-
-	Connection0(TargetType* anObject, void (TargetType::*aMemberFunction)())
-	{
-		object_ = anObject;
-		memberFunction_ = 0;
-		voidMemberFunction_ = aMemberFunction;
-	}
-
-	Connection0(TargetType* anObject, TargetType& (TargetType::*aMemberFunction)())
-	{
-		object_ = anObject;
-		memberFunction_ = aMemberFunction;
-	}
-
-	virtual BasicConnection0* clone()
-	{
-		return new Connection0<TargetType>(*this);
-	}
-
-	virtual BasicConnection0* duplicate(SlotHolder* newTarget)
-	{
-		return new Connection0<TargetType>((TargetType *)newTarget, memberFunction_);
-	}
-
-	virtual void emit()
-	{
-		if(memberFunction_ != 0)
-			(object_->*memberFunction_)();
-		else
-			(object_->*voidMemberFunction_)();
-	}
-
-	virtual SlotHolder* targetSlotHolder() const
-	{
-		return object_;
-	}
-
-private:
-    TargetType* object_;
-	TargetType& (TargetType::* memberFunction_)();
-	void (TargetType::* voidMemberFunction_)();
-};
-
-template<class TargetType, class Type1>
-class Connection1 : public BasicConnection1<Type1>
-{
-public:
-	Connection1()
-	{
-		object_ = 0;
-		memberFunction_ = 0;
-		voidMemberFunction_ = 0;
-	}
-
-	Connection1(TargetType* anObject, void (TargetType::*aMemberFunction)(Type1))
-	{
-		object_ = anObject;
-		memberFunction_ = 0;
-		voidMemberFunction_ = aMemberFunction;
-	}
-
-	Connection1(TargetType* anObject, TargetType& (TargetType::*aMemberFunction)(Type1))
-	{
-		object_ = anObject;
-		voidMemberFunction_ = 0;
-		memberFunction_ = aMemberFunction;
-	}
-
-	virtual BasicConnection1<Type1>* clone()
-	{
-		return new Connection1<TargetType, Type1>(*this);
-	}
-
-    virtual BasicConnection1<Type1>* duplicate(SlotHolder* newTarget)
-	{
-		return new Connection1<TargetType, Type1>((TargetType *)newTarget, memberFunction_);
-	}
-
-	virtual void emit(Type1 a1)
-	{
-		if(memberFunction_ != 0)
-			(object_->*memberFunction_)(a1);
-		else
-			(object_->*voidMemberFunction_)(a1);
-	}
-
-	virtual SlotHolder* targetSlotHolder() const
-	{
-		return object_;
-	}
-
-private:
-	TargetType* object_;
-	void (TargetType::* voidMemberFunction_)(Type1);
-	TargetType& (TargetType::* memberFunction_)(Type1);
-};
-
-template<class TargetType, class Type1, class Type2>
-class Connection2 : public BasicConnection2<Type1, Type2>
-{
-public:
-	Connection2()
-	{
-		object_ = 0;
-		memberFunction_ = 0;
-		voidMemberFunction_ = 0;
-	}
-
-	Connection2(TargetType* anObject, void (TargetType::*aMemberFunction)(Type1, Type2))
-	{
-		object_ = anObject;
-		memberFunction_ = 0;
-		voidMemberFunction_ = aMemberFunction;
-	}
-
-	Connection2(TargetType* anObject, TargetType& (TargetType::*aMemberFunction)(Type1, Type2))
-	{
-		object_ = anObject;
-		voidMemberFunction_ = 0;
-		memberFunction_ = aMemberFunction;
-	}
-
-	virtual BasicConnection2<Type1, Type2>* clone()
-	{
-		return new Connection2<TargetType, Type1, Type2>(*this);
-	}
-
-    virtual BasicConnection2<Type1, Type2>* duplicate(SlotHolder* newTarget)
-	{
-		return new Connection2<TargetType, Type1, Type2>((TargetType *)newTarget, memberFunction_);
-	}
-
-	virtual void emit(Type1 a1, Type2 a2)
-	{
-		if(memberFunction_ != 0)
-			(object_->*memberFunction_)(a1, a2);
-		else
-			(object_->*voidMemberFunction_)(a1, a2);
-	}
-
-	virtual SlotHolder* targetSlotHolder() const
-	{
-		return object_;
-	}
-
-private:
-	TargetType* object_;
-    void (TargetType::* voidMemberFunction_)(Type1, Type2);
-	TargetType& (TargetType::* memberFunction_)(Type1, Type2);
+    //! on the emitting thread,before emit returns
+    ConnectionType_direct = 0x00,
+    //! the arguments are copied and the slot is called by the task queue of the thread the slot holder was created on
+    ConnectionType_queued
 };
 
-template<class TargetType, class Type1, class Type2, class Type3>
-class Connection3 : public BasicConnection3<Type1, Type2, Type3>
+//! an object pointer and a thunk calling a member function stored inline,copied bitwise
+template<class... Types>
+class Delegate
 {
 public:
-	Connection3()
-	{
-		object_ = 0;
-	    memberFunction_ = 0;
-		voidMemberFunction_ = 0;
-	}
-
-	Connection3(TargetType* anObject, void (TargetType::*aMemberFunction)(Type1, Type2, Type3))
-	{
-		object_ = anObject;
-		memberFunction_ = 0;
-		voidMemberFunction_ = aMemberFunction;
-	}
+    typedef void (*Thunk)(const Delegate<Types...>& delegate, Types... arguments);
+public:
+    Delegate():
+        object_(0),
+        thunk_(0)
+    {
+    }
 
-	Connection3(TargetType* anObject, TargetType& (TargetType::*aMemberFunction)(Type1, Type2, Type3))
-	{
-		object_ = anObject;
-		voidMemberFunction_ = 0;
-		memberFunction_ = aMemberFunction;
-	}
+    //! the member function returns void or the object
+    template<class TargetType, class MemberFunction>
+    Delegate(TargetType* object, MemberFunction function):
+        object_(object),
+        thunk_(&callMember<TargetType, MemberFunction>)
+    {
+        static_assert(sizeof(MemberFunction) <= sizeof(Storage), "member function pointer too large");
+        memcpy(&function_, &function, sizeof(MemberFunction));
+    }
 
-	virtual BasicConnection3<Type1, Type2, Type3>* clone()
-	{
-		return new Connection3<TargetType, Type1, Type2, Type3>(*this);
-	}
+    //! thunk is called with the delegate,object is whatever it expects
+    static Delegate<Types...> fromThunk(void* object, Thunk thunk)
+    {
+        Delegate<Types...> delegate;
+        delegate.object_ = object;
+        delegate.thunk_ = thunk;
+        return delegate;
+    }
+public:
+    void* object()const{return object_;}
+    bool isEmpty()const{return thunk_ == 0;}
 
-	virtual BasicConnection3<Type1, Type2, Type3>* duplicate(SlotHolder* newTarget)
-	{
-		return new Connection3<TargetType, Type1, Type2, Type3>((TargetType *)newTarget, memberFunction_);
-	}
+    //! calls the member function of the object at the same place in newHolder as the current one in oldHolder
+    void retarget(const void* oldHolder, void* newHolder)
+    {
+        object_ = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(object_) - reinterpret_cast<intptr_t>(oldHolder) +
+            reinterpret_cast<intptr_t>(newHolder));
+    }
 
-	virtual void emit(Type1 a1, Type2 a2, Type3 a3)
-	{
-		if(memberFunction_ != 0)
-			(object_->*memberFunction_)(a1, a2, a3);
-		else
-			(object_->*voidMemberFunction_)(a1, a2, a3);
-	}
+    void operator()(Types... arguments)const
+    {
+        thunk_(*this, std::forward<Types>(arguments)...);
+    }
+private:
+    template<class TargetType, class MemberFunction>
+    static void callMember(const Delegate<Types...>& delegate, Types... arguments)
+    {
+        MemberFunction function;
+        memcpy(&function, &delegate.function_, sizeof(MemberFunction));
+        (static_cast<TargetType*>(delegate.object_)->*function)(std::forward<Types>(arguments)...);
+    }
+private:
+    //! room for a member function pointer of any inheritance model
+    union Storage
+    {
+        void* pointer_;
+        long long number_;
+        char bytes_[24];
+    };
+
+    void* object_;
+    Thunk thunk_;
+    Storage function_;
+};
 
-	virtual SlotHolder* targetSlotHolder() const
-	{
-		return object_;
-	}
+class BasicSignal;
 
+//! an emission on a thread other than the one that created the signal,counted atomically
+//! emissions of a thread nest like the calls
+class BGE_EXPORT_API SignalEmission
+{
+public:
+    explicit SignalEmission(BasicSignal* signal);
+    ~SignalEmission();
+public:
+    //! a slot destroyed the signal,the emission must not touch it any more
+    bool isSignalDestroyed()const{return isSignalDestroyed_;}
+private:
+    SignalEmission(const SignalEmission&);
+    SignalEmission& operator=(const SignalEmission&);
 private:
-	TargetType* object_;
-	void (TargetType::* voidMemberFunction_)(Type1, Type2, Type3);
-	TargetType& (TargetType::* memberFunction_)(Type1, Type2, Type3);
+    friend class BasicSignal;
+    BasicSignal* signal_;
+    SignalEmission* previous_;
+    bool isSignalDestroyed_;
 };
 
-template<class TargetType, class Type1, class Type2, class Type3, class Type4>
-class Connection4 : public BasicConnection4<Type1, Type2, Type3, Type4>
+//! connecting,disconnecting and destroying signals and slot holders are serialized by one mutex,no slot is called with it held
+//! emitting takes no lock,connections removed while an emission runs are skipped by it
+//! until another thread uses the signal its connections are changed in place,later the list is copied on change
+//! replaced lists are deleted by the thread that created the signal once no emission runs
+//! a direct slot runs on the emitting thread,a slot holder used by other threads should be connected queued
+class BGE_EXPORT_API BasicSignal
 {
 public:
-	Connection4()
-	{
-		object_ = 0;
-		memberFunction_ = 0;
-		voidMemberFunction_ = 0;
-	}
-
-	Connection4(TargetType* anObject, void (TargetType::*aMemberFunction)(Type1,
-		Type2, Type3, Type4))
-	{
-		object_ = anObject;
-		memberFunction_ = 0;
-		voidMemberFunction_ = aMemberFunction;
-	}
-
-	Connection4(TargetType* anObject, TargetType& (TargetType::*aMemberFunction)(Type1,
-		Type2, Type3, Type4))
-	{
-		object_ = anObject;
-		voidMemberFunction_ = 0;
-		memberFunction_ = aMemberFunction;
-	}
-
-	virtual BasicConnection4<Type1, Type2, Type3, Type4>* clone()
-	{
-		return new Connection4<TargetType, Type1, Type2, Type3, Type4>(*this);
-	}
+    BasicSignal():
+        emitting_(0),
+        hasRetired_(false),
+        isShared_(false),
+        thread_(std::this_thread::get_id()),
+        ownerEmission_(0)
+    {
+    }
 
-	virtual BasicConnection4<Type1, Type2, Type3, Type4>* duplicate(SlotHolder* newTarget)
-	{
-		return new Connection4<TargetType, Type1, Type2, Type3, Type4>((TargetType *)newTarget, memberFunction_);
-	}
+    BasicSignal(const BasicSignal&):
+        emitting_(0),
+        hasRetired_(false),
+        isShared_(false),
+        thread_(std::this_thread::get_id()),
+        ownerEmission_(0)
+    {
+    }
 
-	virtual void emit(Type1 a1, Type2 a2, Type3 a3, Type4 a4)
-	{
-		if(memberFunction_ != 0)
-			(object_->*memberFunction_)(a1, a2, a3, a4);
-		else
-			(object_->*voidMemberFunction_)(a1, a2, a3, a4);
-	}
+    virtual ~BasicSignal() {}
+    //! the connection mutex is held
+	virtual void disconnectSlot(SlotHolder* slot) = 0;
+    //! the connection mutex is held
+	virtual void duplicateSlot(const SlotHolder* oldSlot, SlotHolder* newSlot) = 0;
+protected:
+    //! an emission on the thread that created the signal,it takes no atomic operation
+    class OwnerEmission
+    {
+    public:
+        explicit OwnerEmission(BasicSignal* signal):
+            signal_(signal),
+            previous_(signal->ownerEmission_),
+            isSignalDestroyed_(false)
+        {
+            signal_->ownerEmission_ = this;
+        }
 
-	virtual SlotHolder* targetSlotHolder() const
-	{
-		return object_;
-	}
+        ~OwnerEmission()
+        {
+            if(isSignalDestroyed_)
+                return;
+            signal_->ownerEmission_ = previous_;
+            if(!previous_ && signal_->hasRetired_.load(std::memory_order_relaxed))
+                signal_->reclaimRetired();
+        }
 
+        bool isSignalDestroyed()const{return isSignalDestroyed_;}
+    private:
+        OwnerEmission(const OwnerEmission&);
+        OwnerEmission& operator=(const OwnerEmission&);
+    private:
+        friend class BasicSignal;
+        BasicSignal* signal_;
+        OwnerEmission* previous_;
+        bool isSignalDestroyed_;
+    };
+protected:
+    bool isOwnerThread()const{return std::this_thread::get_id() == thread_;}
+    bool isOwnerEmitting()const{return ownerEmission_ != 0;}
+    //! true on the thread that created the signal while no emission runs,the connection mutex is held
+    bool isQuiescent()const{return isOwnerThread() && ownerEmission_ == 0 && emitting_.load() == 0;}
+    //! true while only the thread that created the signal used it,the connection mutex is held
+    bool changesInPlace()
+    {
+        if(!isOwnerThread())
+            isShared_.store(true);
+        return !isShared_.load(std::memory_order_relaxed);
+    }
+    //! called by another thread before it reads the connections
+    void share();
+    //! called first by the destructor,stops the emissions of this thread and waits for the others
+    void finishEmissions();
+    //! locks the connection mutex and calls reclaim
+    void reclaimRetired();
+    //! deletes replaced lists and removed connections if the signal is quiescent,the connection mutex is held
+    virtual void reclaim() = 0;
+protected:
+    friend class SignalEmission;
+    std::atomic<int> emitting_;
+    std::atomic<bool> hasRetired_;
+    std::atomic<bool> isShared_;
 private:
-	TargetType* object_;
-	void (TargetType::* voidMemberFunction_)(Type1, Type2, Type3, Type4);
-	TargetType& (TargetType::* memberFunction_)(Type1, Type2, Type3, Type4);
+    std::thread::id thread_;
+    OwnerEmission* ownerEmission_;
 };
 
-template<class TargetType, class Type1, class Type2, class Type3, class Type4, class Type5>
-class Connection5 : public BasicConnection5<Type1, Type2, Type3, Type4, Type5>
+class BGE_EXPORT_API SlotHolder
 {
+private:
+	typedef SmallVector<BasicSignal*, 4> SenderList;
 public:
-	Connection5()
-	{
-		object_ = 0;
-		memberFunction_ = 0;
-		voidMemberFunction_ = 0;
-	}
+    //! guards every connection list and sender list
+    static std::mutex& connectionMutex();
+public:
+	SlotHolder():
+        thread_(std::this_thread::get_id())
+    {
+    }
 
-	Connection5(TargetType* anObject, void (TargetType::*aMemberFunction)(Type1,
-		Type2, Type3, Type4, Type5))
+	SlotHolder(const SlotHolder& holder):
+        thread_(std::this_thread::get_id())
 	{
-		object_ = anObject;
-		memberFunction_ = 0;
-		voidMemberFunction_ = aMemberFunction;
+        std::lock_guard<std::mutex> lock(connectionMutex());
+		for(size_t i = 0;i < holder.senders_.size();i++)
+		{
+			holder.senders_[i]->duplicateSlot(&holder, this);
+			senders_.push_back(holder.senders_[i]);
+		}
 	}
 
-	Connection5(TargetType* anObject, TargetType& (TargetType::*aMemberFunction)(Type1,
-		Type2, Type3, Type4, Type5))
+	virtual ~SlotHolder()
 	{
-		object_ = anObject;
-		voidMemberFunction_ = 0;
-		memberFunction_ = aMemberFunction;
+		disconnectAll();
 	}
 
-	virtual BasicConnection5<Type1, Type2, Type3, Type4,Type5>* clone()
+    //! the connection mutex is held
+	void connectTo(BasicSignal* sender)
 	{
-		return new Connection5<TargetType, Type1, Type2, Type3, Type4,Type5>(*this);
+		for(size_t i = 0;i < senders_.size();i++)
+		{
+		    if(senders_[i] == sender)
+		        return;
+		}
+		senders_.push_back(sender);
 	}
 
-	virtual BasicConnection5<Type1, Type2, Type3, Type4,Type5>* duplicate(SlotHolder* newTarget)
+    //! the connection mutex is held
+	void disconnectFrom(BasicSignal* sender)
 	{
-		return new Connection5<TargetType, Type1, Type2, Type3, Type4,Type5>((TargetType *)newTarget, memberFunction_);
+		for(size_t i = 0;i < senders_.size();i++)
+		{
+		    if(senders_[i] == sender)
+		    {
+		        senders_.erase(i);
+		        return;
+		    }
+		}
 	}
 
-	virtual void emit(Type1 a1, Type2 a2, Type3 a3, Type4 a4, Type5 a5)
+	void disconnectAll()
 	{
-		if(memberFunction_ != 0)
-			(object_->*memberFunction_)(a1, a2, a3, a4, a5);
-		else
-			(object_->*voidMemberFunction_)(a1, a2, a3, a4, a5);
+        std::lock_guard<std::mutex> lock(connectionMutex());
+		for(size_t i = 0;i < senders_.size();i++)
+			senders_[i]->disconnectSlot(this);
+		senders_.clear();
 	}
 
-	virtual SlotHolder* targetSlotHolder() const
-	{
-		return object_;
-	}
+    //! queued slots are called by the task queue of this thread
+    std::thread::id thread()const{return thread_;}
 private:
-	TargetType* object_;
-	void (TargetType::* voidMemberFunction_)(Type1, Type2, Type3, Type4, Type5);
-	TargetType& (TargetType::* memberFunction_)(Type1, Type2, Type3, Type4, Type5);
+    SenderList senders_;
+    std::thread::id thread_;
 };
 
-class Signal0 : public BasicSignal0
+//! shared by a queued connection and the calls it posted,a call is dropped if the connection is gone by then
+class QueuedTarget : public std::enable_shared_from_this<QueuedTarget>
 {
 public:
-	typedef BasicSignal0::ConnectionList ConnectionList;
-public:
-	Signal0() {}
-	Signal0(const Signal0& s) : BasicSignal0(s) {}
-
-	template<class TargetType>
-	void connect(TargetType* slotHolder, void (TargetType::*aMemberFunction)())
-	{
-		Connection0<TargetType>* conn =
-			new Connection0<TargetType>(slotHolder, aMemberFunction);
-		connectedSlots_.push_back(conn);
-		slotHolder->connectTo(this);
-	}
-
-	template<class TargetType>
-	void connect(TargetType* slotHolder, TargetType& (TargetType::*aMemberFunction)())
-	{
-		Connection0<TargetType>* conn =
-			new Connection0<TargetType>(slotHolder, aMemberFunction);
-		connectedSlots_.push_back(conn);
-		slotHolder->connectTo(this);
-	}
-
-    void emit()
-	{
-		ConnectionList::const_iterator itNext, it = connectedSlots_.begin();
-		ConnectionList::const_iterator itEnd = connectedSlots_.end();
+    explicit QueuedTarget(std::thread::id thread):
+        isConnected_(true),
+        thread_(thread)
+    {
+    }
 
-		while(it != itEnd)
-		{
-			itNext = it;
-			++itNext;
-			(*it)->emit();
-			it = itNext;
-		}
-	}
+    virtual ~QueuedTarget() {}
 
-	void operator()()
-	{
-		emit();
-	}
+    bool isConnected()const{return isConnected_.load(std::memory_order_acquire);}
+    void disconnect(){isConnected_.store(false, std::memory_order_release);}
+    std::thread::id thread()const{return thread_;}
+    //! the same call on newHolder,newHolder is a copy of oldHolder
+    virtual std::shared_ptr<QueuedTarget> duplicate(const SlotHolder* oldHolder, SlotHolder* newHolder)const = 0;
+private:
+    std::atomic<bool> isConnected_;
+    std::thread::id thread_;
 };
 
-template<class Type1>
-class Signal1 : public BasicSignal1<Type1>
+template<class... Types>
+class QueuedCall : public QueuedTarget
 {
-    //dev c++» connectedSlots_ûж,
-    std::list<BasicConnection1<Type1> *> connectedSlots_;
-public:
-    typedef typename BasicSignal1<Type1>::ConnectionList ConnectionList;
 public:
-    Signal1() {}
-    Signal1(const Signal1<Type1>& s) : BasicSignal1<Type1>(s) {}
+    QueuedCall(const Delegate<Types...>& delegate, std::thread::id thread):
+        QueuedTarget(thread),
+        delegate_(delegate)
+    {
+    }
 
-    template<class TargetType>
-    void connect(TargetType* slotHolder, void (TargetType::*aMemberFunction)(Type1))
+    //! the thunk of the connection,its object is the queued target
+    static void post(const Delegate<Types...>& delegate, Types... arguments)
     {
-        Connection1<TargetType, Type1>* conn =
-            new Connection1<TargetType, Type1>(slotHolder, aMemberFunction);
-        connectedSlots_.push_back(conn);
-        slotHolder->connectTo(this);
+        QueuedCall<Types...>* call = static_cast<QueuedCall<Types...>*>(static_cast<QueuedTarget*>(delegate.object()));
+        // without a task queue on that thread nothing would ever deliver the call
+        TaskQueue* queue = TaskQueue::threadQueue(call->thread());
+        if(queue)
+            queue->post(std::bind(&QueuedCall<Types...>::deliver, std::static_pointer_cast<QueuedCall<Types...> >(call->shared_from_this()), arguments...));
+        else
+            call->deliver(arguments...);
     }
 
-    template<class TargetType>
-    void connect(TargetType* slotHolder, TargetType& (TargetType::*aMemberFunction)(Type1))
+    void deliver(Types... arguments)
     {
-        Connection1<TargetType, Type1>* conn =
-            new Connection1<TargetType, Type1>(slotHolder, aMemberFunction);
-        connectedSlots_.push_back(conn);
-        slotHolder->connectTo(this);
+        if(isConnected())
+            delegate_(arguments...);
     }
 
-    void emit(Type1 a1)
+    std::shared_ptr<QueuedTarget> duplicate(const SlotHolder* oldHolder, SlotHolder* newHolder)const
     {
-        typename ConnectionList::const_iterator itNext, it = connectedSlots_.begin();
-        typename ConnectionList::const_iterator itEnd = connectedSlots_.end();
+        Delegate<Types...> delegate(delegate_);
+        delegate.retarget(oldHolder, newHolder);
+        return std::make_shared<QueuedCall<Types...> >(delegate, newHolder->thread());
+    }
+private:
+    Delegate<Types...> delegate_;
+};
 
-        while(it != itEnd)
-        {
-            itNext = it;
-            ++itNext;
+//! one connected slot,stored by value in the connection list
+template<class... Types>
+class SignalConnection
+{
+public:
+    SignalConnection(const Delegate<Types...>& delegate, SlotHolder* slotHolder):
+        delegate_(delegate),
+        slotHolder_(slotHolder),
+        isConnected_(true)
+    {
+    }
 
-            (*it)->emit(a1);
-            it = itNext;
-        }
+    SignalConnection(const SignalConnection<Types...>& connection):
+        delegate_(connection.delegate_),
+        slotHolder_(connection.slotHolder_),
+        queued_(connection.queued_),
+        isConnected_(connection.isConnected())
+    {
     }
 
-    void operator()(Type1 a1)
+    SignalConnection<Types...>& operator=(const SignalConnection<Types...>& connection)
     {
-        emit(a1);
+        delegate_ = connection.delegate_;
+        slotHolder_ = connection.slotHolder_;
+        queued_ = connection.queued_;
+        // lists are assigned to only while no emission walks them
+        isConnected_.store(connection.isConnected(), std::memory_order_relaxed);
+        return *this;
     }
+
+    bool isConnected()const{return isConnected_.load(std::memory_order_acquire);}
+
+    //! emissions walking a list holding this copy skip it from now on,posted calls are dropped
+    void disconnect()
+    {
+        isConnected_.store(false, std::memory_order_release);
+        if(queued_)
+            queued_->disconnect();
+    }
+public:
+    Delegate<Types...> delegate_;
+    SlotHolder* slotHolder_;
+    //! set for queued connections,the object of the delegate
+    std::shared_ptr<QueuedTarget> queued_;
+private:
+    std::atomic<bool> isConnected_;
 };
 
-template<class Type1, class Type2>
-class Signal2 : public BasicSignal2<Type1, Type2>
+//! the first connections are stored in the signal,connecting and emitting them allocates nothing
+template<class... Types>
+class Signal : public BasicSignal
 {
 public:
-	typedef typename BasicSignal2<Type1, Type2>::ConnectionList ConnectionList;
+    typedef Delegate<Types...> DelegateType;
+    typedef SignalConnection<Types...> Connection;
+	typedef SmallVector<Connection, 2> ConnectionList;
 public:
-	Signal2() {}
-    Signal2(const Signal2<Type1, Type2>& s) : BasicSignal2<Type1, Type2>(s) {}
-
-	template<class TargetType>
-	void connect(TargetType* slotHolder, void (TargetType::*aMemberFunction)(Type1, Type2))
-	{
-		Connection2<TargetType, Type1, Type2>* conn = new
-			Connection2<TargetType, Type1, Type2>(slotHolder, aMemberFunction);
-		BasicSignal2<Type1, Type2>::connectedSlots_.push_back(conn);
-		slotHolder->connectTo(this);
-	}
-
-	template<class TargetType>
-	void connect(TargetType* slotHolder, TargetType& (TargetType::*aMemberFunction)(Type1, Type2))
-	{
-		Connection2<TargetType, Type1, Type2>* conn = new
-			Connection2<TargetType, Type1, Type2>(slotHolder, aMemberFunction);
-		BasicSignal2<Type1, Type2>::connectedSlots_.push_back(conn);
-		slotHolder->connectTo(this);
-	}
+	Signal():
+        connectedSlots_(0)
+    {
+    }
 
-	void emit(Type1 a1, Type2 a2)
+	Signal(const Signal<Types...>& s):
+        BasicSignal(s),
+        connectedSlots_(0)
 	{
-		typename ConnectionList::const_iterator itNext, it = BasicSignal2<Type1, Type2>::connectedSlots_.begin();
-		typename ConnectionList::const_iterator itEnd = BasicSignal2<Type1, Type2>::connectedSlots_.end();
-
-		while(it != itEnd)
-		{
-			itNext = it;
-			++itNext;
+        std::lock_guard<std::mutex> lock(SlotHolder::connectionMutex());
+        const ConnectionList* list = s.connectedSlots_.load();
+        if(!list)
+            return;
 
-			(*it)->emit(a1, a2);
-            it = itNext;
+        for(size_t i = 0;i < list->size();i++)
+        {
+            if(!(*list)[i].isConnected())
+                continue;
+            SlotHolder* slotHolder = (*list)[i].slotHolder_;
+			slotHolder->connectTo(this);
+			inlineSlots_.push_back(duplicate((*list)[i], slotHolder, slotHolder));
 		}
+        if(!inlineSlots_.empty())
+            connectedSlots_.store(&inlineSlots_);
 	}
 
-	void operator()(Type1 a1, Type2 a2)
+    ~Signal()
 	{
-		emit(a1,a2);
+        finishEmissions();
+		disconnectAll();
+        std::lock_guard<std::mutex> lock(SlotHolder::connectionMutex());
+        deleteRetired();
+        ConnectionList* list = connectedSlots_.load();
+        if(list != &inlineSlots_)
+            delete list;
 	}
-};
-
-template<class Type1, class Type2, class Type3>
-class Signal3 : public BasicSignal3<Type1, Type2, Type3>
-{
-public:
-	typedef typename BasicSignal3<Type1, Type2, Type3>::ConnectionList ConnectionList;
-public:
-	Signal3() {}
-    Signal3(const Signal3<Type1, Type2, Type3>& s) : BasicSignal3<Type1, Type2, Type3>(s) {}
 
 	template<class TargetType>
-	void connect(TargetType* slotHolder, void (TargetType::*aMemberFunction)(Type1,Type2,Type3))
+	void connect(TargetType* slotHolder, void (TargetType::*aMemberFunction)(Types...), ConnectionType type = ConnectionType_direct)
 	{
-		Connection3<TargetType, Type1, Type2, Type3>* conn = new Connection3<TargetType, Type1, Type2, Type3>(slotHolder,aMemberFunction);
-		    BasicSignal2<Type1, Type2>::connectedSlots_.push_back(conn);
-		slotHolder->connectTo(this);
+        add(DelegateType(slotHolder, aMemberFunction), slotHolder, type);
 	}
 
 	template<class TargetType>
-	void connect(TargetType* slotHolder, TargetType& (TargetType::*aMemberFunction)(Type1, Type2, Type3))
+	void connect(TargetType* slotHolder, TargetType& (TargetType::*aMemberFunction)(Types...), ConnectionType type = ConnectionType_direct)
 	{
-		Connection3<TargetType,Type1,Type2,Type3>* conn = new Connection3<TargetType, Type1, Type2, Type3>(slotHolder,aMemberFunction);
-			BasicSignal2<Type1, Type2>::connectedSlots_.push_back(conn);
-		slotHolder->connectTo(this);
+        add(DelegateType(slotHolder, aMemberFunction), slotHolder, type);
 	}
 
-	void emit(Type1 a1, Type2 a2, Type3 a3)
+	void disconnectAll()
 	{
-		auto it = BasicSignal2<Type1, Type2>::connectedSlots_.begin();
-		auto itNext = it;
-		auto itEnd = BasicSignal2<Type1, Type2>::connectedSlots_.end();
+        std::lock_guard<std::mutex> lock(SlotHolder::connectionMutex());
+        ConnectionList* list = connectedSlots_.load();
+        if(!list)
+            return;
 
-		while(it != itEnd)
-		{
-			itNext = it;
-			++itNext;
-            (*it)->emit(a1, a2, a3);
-            it = itNext;
-		}
-	}
+        for(size_t i = 0;i < list->size();i++)
+        {
+            if((*list)[i].isConnected())
+			    (*list)[i].slotHolder_->disconnectFrom(this);
+        }
+        disconnectConnections(0);
 
-	void operator()(Type1 a1, Type2 a2, Type3 a3)
-	{
-		emit(a1,a2,a3);
+        if(!changesInPlace())
+            publish(0);
+        else if(isOwnerEmitting())
+            hasRetired_.store(true, std::memory_order_relaxed);
+        else
+            compact();
 	}
-};
-
-template<class Type1, class Type2, class Type3, class Type4>
-class Signal4 : public BasicSignal4<Type1, Type2, Type3, Type4>
-{
-public:
-    typedef typename BasicSignal4<Type1, Type2, Type3, Type4>::ConnectionList ConnectionList;
-public:
-	Signal4() {}
 
-	Signal4(const Signal4<Type1, Type2, Type3, Type4>& s)
-		: BasicSignal4<Type1, Type2, Type3, Type4>(s)
-	{}
-
-	template<class TargetType>
-	void connect(TargetType* slotHolder, void (TargetType::*aMemberFunction)(Type1,Type2, Type3, Type4))
+	void disconnect(SlotHolder* slotHolder)
 	{
-		Connection4<TargetType, Type1, Type2, Type3, Type4>*
-			conn = new Connection4<TargetType, Type1, Type2, Type3,Type4>(slotHolder, aMemberFunction);
-		BasicSignal4<Type1, Type2,Type3,Type4>::connectedSlots_.push_back(conn);
-		slotHolder->connectTo(this);
+        std::lock_guard<std::mutex> lock(SlotHolder::connectionMutex());
+        if(remove(slotHolder))
+            slotHolder->disconnectFrom(this);
 	}
 
-	template<class TargetType>
-	void connect(TargetType* slotHolder, TargetType& (TargetType::*aMemberFunction)(Type1,Type2, Type3, Type4))
+	void disconnectSlot(SlotHolder* slot)
 	{
-		Connection4<TargetType, Type1, Type2, Type3, Type4>*
-		conn = new Connection4<TargetType, Type1, Type2, Type3,
-		Type4>(slotHolder, aMemberFunction);
-		BasicSignal2<Type1, Type2>::connectedSlots_.push_back(conn);
-		slotHolder->connectTo(this);
+        remove(slot);
 	}
 
-	void emit(Type1 a1, Type2 a2, Type3 a3, Type4 a4)
+	void duplicateSlot(const SlotHolder* oldTarget, SlotHolder* newTarget)
 	{
-		auto it = BasicSignal4<Type1, Type2,Type3, Type4>::connectedSlots_.begin();
-		auto itNext = it;
-		auto itEnd = BasicSignal4<Type1, Type2,Type3, Type4>::connectedSlots_.end();
+        const ConnectionList* list = connectedSlots_.load();
+        if(!list)
+            return;
 
-		while(it != itEnd)
+        ConnectionList duplicates;
+        for(size_t i = 0;i < list->size();i++)
 		{
-			itNext = it;
-			++itNext;
+		    if((*list)[i].slotHolder_ == oldTarget && (*list)[i].isConnected())
+			    duplicates.push_back(duplicate((*list)[i], oldTarget, newTarget));
+		}
 
-			(*it)->emit(a1, a2, a3, a4);
+        for(size_t i = 0;i < duplicates.size();i++)
+            append(duplicates[i]);
+	}
 
-			it = itNext;
-		}
+    void emit(Types... arguments)
+	{
+        // nothing connected,the common case costs one load
+        if(!connectedSlots_.load(std::memory_order_acquire))
+            return;
+
+        if(isOwnerThread())
+        {
+            OwnerEmission emission(this);
+            callSlots(emission, arguments...);
+        }
+        else
+        {
+            share();
+            SignalEmission emission(this);
+            callSlots(emission, arguments...);
+        }
 	}
 
-	void operator()(Type1 a1, Type2 a2, Type3 a3, Type4 a4)
+	void operator()(Types... arguments)
 	{
-		emit(a1,a2,a3,a4);
+		emit(arguments...);
 	}
-};
+private:
+    template<class Emission>
+    void callSlots(const Emission& emission, Types... arguments)
+    {
+        const ConnectionList* list = connectedSlots_.load(std::memory_order_acquire);
+        if(!list)
+            return;
 
-template<class Type1, class Type2, class Type3, class Type4, class Type5>
-class Signal5 : public BasicSignal5<Type1, Type2, Type3, Type4, Type5>
-{
-public:
-    typedef typename BasicSignal5<Type1, Type2, Type3, Type4, Type5>::ConnectionList ConnectionList;
-public:
-    Signal5()
+        // slots connected by a slot are called by the next emission
+        const size_t count = list->size();
+        for(size_t i = 0;i < count;i++)
+        {
+            // a list changed in place may move while a slot runs,the connection is read again each time
+            const Connection& connection = (*list)[i];
+            if(!connection.isConnected())
+                continue;
+
+            const DelegateType delegate = connection.delegate_;
+            delegate(arguments...);
+            if(emission.isSignalDestroyed())
+                return;
+        }
+    }
+
+    //! a copy of the connection calling newHolder,queued ones get their own target
+    static Connection duplicate(const Connection& connection, const SlotHolder* oldHolder, SlotHolder* newHolder)
     {
+        Connection copy(connection.delegate_, newHolder);
+        if(connection.queued_)
+        {
+            copy.queued_ = connection.queued_->duplicate(oldHolder, newHolder);
+            copy.delegate_ = DelegateType::fromThunk(copy.queued_.get(), &QueuedCall<Types...>::post);
+        }
+        else
+            copy.delegate_.retarget(oldHolder, newHolder);
+        return copy;
+    }
+
+    void add(const DelegateType& delegate, SlotHolder* slotHolder, ConnectionType type)
+    {
+        Connection connection(delegate, slotHolder);
+        if(type == ConnectionType_queued)
+        {
+            connection.queued_ = std::make_shared<QueuedCall<Types...> >(delegate, slotHolder->thread());
+            connection.delegate_ = DelegateType::fromThunk(connection.queued_.get(), &QueuedCall<Types...>::post);
+        }
+
+        std::lock_guard<std::mutex> lock(SlotHolder::connectionMutex());
+        append(connection);
+		slotHolder->connectTo(this);
     }
 
-    Signal5(const Signal5<Type1, Type2, Type3, Type4, Type5>& s): BasicSignal5<Type1, Type2, Type3, Type4, Type5>(s)
+    //! the connection mutex is held
+    void append(const Connection& connection)
     {
+        // an emission running on this thread stops at the size it started with
+        if(changesInPlace())
+        {
+            inlineSlots_.push_back(connection);
+            connectedSlots_.store(&inlineSlots_);
+            return;
+        }
+
+        const ConnectionList* list = connectedSlots_.load();
+        ConnectionList* copy = list ? copyConnected(*list) : new ConnectionList();
+        copy->push_back(connection);
+        publish(copy);
     }
 
-    template<class TargetType>
-    void connect(TargetType* slotHolder, void (TargetType::*aMemberFunction)(Type1,
-        Type2, Type3, Type4, Type5))
+    //! returns true if a connection to the slot holder was removed,the connection mutex is held
+    bool remove(const SlotHolder* slotHolder)
     {
-        Connection5<TargetType, Type1, Type2, Type3, Type4,Type5>* conn = new Connection5<TargetType, Type1, Type2,
-            Type3, Type4, Type5>(slotHolder, aMemberFunction);
-        BasicSignal2<Type1, Type2>::connectedSlots_.push_back(conn);
-        slotHolder->connectTo(this);
+        const ConnectionList* list = connectedSlots_.load();
+        if(!list)
+            return false;
+
+        bool found = false;
+        for(size_t i = 0;i < list->size() && !found;i++)
+            found = (*list)[i].slotHolder_ == slotHolder && (*list)[i].isConnected();
+        if(!found)
+            return false;
+
+        disconnectConnections(slotHolder);
+        if(!changesInPlace())
+            publish(copyConnected(*list));
+        else if(isOwnerEmitting())
+            hasRetired_.store(true, std::memory_order_relaxed);
+        else
+            compact();
+        return true;
     }
 
-    template<class TargetType>
-    void connect(TargetType* slotHolder, TargetType& (TargetType::*aMemberFunction)(Type1,
-        Type2, Type3, Type4, Type5))
+    //! disconnects the connections to the slot holder,every one if null,in each list an emission may walk
+    void disconnectConnections(const SlotHolder* slotHolder)
     {
-        Connection5<TargetType, Type1, Type2, Type3, Type4,
-            Type5>* conn = new Connection5<TargetType, Type1, Type2,
-            Type3, Type4, Type5>(slotHolder, aMemberFunction);
-        BasicSignal5<Type1, Type2, Type3, Type4, Type5>::connectedSlots_.push_back(conn);
-        slotHolder->connectTo(this);
+        disconnectConnections(inlineSlots_, slotHolder);
+        ConnectionList* list = connectedSlots_.load();
+        if(list && list != &inlineSlots_)
+            disconnectConnections(*list, slotHolder);
+        for(size_t i = 0;i < retiredLists_.size();i++)
+            disconnectConnections(*retiredLists_[i], slotHolder);
     }
 
-    void emit(Type1 a1, Type2 a2, Type3 a3, Type4 a4, Type5 a5)
+    static void disconnectConnections(ConnectionList& list, const SlotHolder* slotHolder)
     {
-        auto it = BasicSignal5<Type1, Type2, Type3, Type4, Type5>::connectedSlots_.begin();
-        auto itNext = it;
-        auto itEnd = BasicSignal5<Type1, Type2, Type3, Type4, Type5>::connectedSlots_.end();
+        for(size_t i = 0;i < list.size();i++)
+        {
+            if(!slotHolder || list[i].slotHolder_ == slotHolder)
+                list[i].disconnect();
+        }
+    }
 
-        while(it != itEnd)
+    //! null if none is left
+    static ConnectionList* copyConnected(const ConnectionList& list)
+    {
+        ConnectionList* copy = new ConnectionList();
+        for(size_t i = 0;i < list.size();i++)
         {
-            itNext = it;
-            ++itNext;
+            if(list[i].isConnected())
+                copy->push_back(list[i]);
+        }
 
-            (*it)->emit(a1, a2, a3, a4, a5);
+        if(copy->empty())
+        {
+            delete copy;
+            copy = 0;
+        }
+        return copy;
+    }
 
-            it = itNext;
+    //! removes disconnected connections from the list changed in place
+    void compact()
+    {
+        size_t kept = 0;
+        for(size_t i = 0;i < inlineSlots_.size();i++)
+        {
+            if(!inlineSlots_[i].isConnected())
+                continue;
+            if(kept != i)
+                inlineSlots_[kept] = inlineSlots_[i];
+            kept ++;
         }
+
+        while(inlineSlots_.size() > kept)
+            inlineSlots_.pop_back();
+
+        if(inlineSlots_.empty())
+            connectedSlots_.store(0);
     }
 
-    void operator()(Type1 a1, Type2 a2, Type3 a3, Type4 a4, Type5 a5)
+    //! replaces the list of a shared signal,the old one goes once no emission walks it
+    void publish(ConnectionList* list)
     {
-        emit(a1,a2,a3,a4,a5);
+        ConnectionList* old = connectedSlots_.exchange(list);
+        if(old && old != &inlineSlots_)
+            retiredLists_.push_back(old);
+        hasRetired_.store(true, std::memory_order_relaxed);
+        reclaim();
     }
+
+    void reclaim()
+    {
+        if(!isQuiescent())
+            return;
+
+        deleteRetired();
+        if(!isShared_.load(std::memory_order_relaxed))
+            compact();
+        else if(connectedSlots_.load() != &inlineSlots_)
+            inlineSlots_.clear();
+    }
+
+    void deleteRetired()
+    {
+        for(size_t i = 0;i < retiredLists_.size();i++)
+            delete retiredLists_[i];
+        retiredLists_.clear();
+        hasRetired_.store(false, std::memory_order_relaxed);
+    }
+protected:
+    //! null if nothing is connected,the inline list until the signal is shared
+    std::atomic<ConnectionList*> connectedSlots_;
+private:
+    ConnectionList inlineSlots_;
+    std::vector<ConnectionList*> retiredLists_;
+};
+
+class Signal0 : public Signal<>
+{
+};
+
+template<class Type1>
+class Signal1 : public Signal<Type1>
+{
+};
+
+template<class Type1, class Type2>
+class Signal2 : public Signal<Type1, Type2>
+{
+};
+
+template<class Type1, class Type2, class Type3>
+class Signal3 : public Signal<Type1, Type2, Type3>
+{
+};
+
+template<class Type1, class Type2, class Type3, class Type4>
+class Signal4 : public Signal<Type1, Type2, Type3, Type4>
+{
+};
+
+template<class Type1, class Type2, class Type3, class Type4, class Type5>
+class Signal5 : public Signal<Type1, Type2, Type3, Type4, Type5>
+{
 };
 
 }
 
 #endif
-
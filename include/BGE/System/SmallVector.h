@@ -0,0 +1,133 @@
+#ifndef BGE_SYSTEM_SMALLVECTOR_H
+#define BGE_SYSTEM_SMALLVECTOR_H
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace bge
+{
+
+//! keeps the first Capacity elements inside the object,it allocates only beyond them
+//! elements are copied when the storage grows,pointers to them do not stay valid
+template<class Type,size_t Capacity>
+class SmallVector
+{
+public:
+    SmallVector():
+        data_(inlineData()),
+        size_(0),
+        capacity_(Capacity)
+    {
+    }
+
+    SmallVector(const SmallVector<Type,Capacity>& other):
+        data_(inlineData()),
+        size_(0),
+        capacity_(Capacity)
+    {
+        reserve(other.size_);
+        for(size_t i = 0;i < other.size_;i++)
+            push_back(other.data_[i]);
+    }
+
+    ~SmallVector()
+    {
+        clear();
+        if(!isInline())
+            ::operator delete(data_);
+    }
+
+    SmallVector<Type,Capacity>& operator=(const SmallVector<Type,Capacity>& other)
+    {
+        if(this != &other)
+        {
+            clear();
+            reserve(other.size_);
+            for(size_t i = 0;i < other.size_;i++)
+                push_back(other.data_[i]);
+        }
+        return *this;
+    }
+public:
+    size_t size()const{return size_;}
+    bool empty()const{return size_ == 0;}
+    size_t capacity()const{return capacity_;}
+    //! false once the elements were moved to the heap
+    bool isInline()const{return data_ == inlineData();}
+
+    Type* data(){return data_;}
+    const Type* data()const{return data_;}
+    Type& operator[](size_t index){return data_[index];}
+    const Type& operator[](size_t index)const{return data_[index];}
+    Type* begin(){return data_;}
+    Type* end(){return data_ + size_;}
+    const Type* begin()const{return data_;}
+    const Type* end()const{return data_ + size_;}
+
+    void reserve(size_t capacity)
+    {
+        if(capacity > capacity_)
+            grow(capacity,0);
+    }
+
+    void push_back(const Type& value)
+    {
+        if(size_ == capacity_)
+            grow(capacity_ * 2,&value);
+        else
+            new(data_ + size_) Type(value);
+        size_ ++;
+    }
+
+    void pop_back()
+    {
+        size_ --;
+        data_[size_].~Type();
+    }
+
+    //! keeps the order of the elements behind it
+    void erase(size_t index)
+    {
+        for(size_t i = index + 1;i < size_;i++)
+            data_[i - 1] = data_[i];
+        size_ --;
+        data_[size_].~Type();
+    }
+
+    void clear()
+    {
+        for(size_t i = 0;i < size_;i++)
+            data_[i].~Type();
+        size_ = 0;
+    }
+private:
+    Type* inlineData(){return reinterpret_cast<Type*>(&storage_);}
+    const Type* inlineData()const{return reinterpret_cast<const Type*>(&storage_);}
+
+    //! appended is copied behind the elements before they move,it may be one of them
+    void grow(size_t capacity,const Type* appended)
+    {
+        Type* data = static_cast<Type*>(::operator new(sizeof(Type) * capacity));
+        if(appended)
+            new(data + size_) Type(*appended);
+        for(size_t i = 0;i < size_;i++)
+        {
+            new(data + i) Type(data_[i]);
+            data_[i].~Type();
+        }
+
+        if(!isInline())
+            ::operator delete(data_);
+        data_ = data;
+        capacity_ = capacity;
+    }
+private:
+    Type* data_;
+    size_t size_;
+    size_t capacity_;
+    typename std::aligned_storage<sizeof(Type) * Capacity,std::alignment_of<Type>::value>::type storage_;
+};
+
+}
+
+#endif
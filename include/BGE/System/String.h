@@ -3,9 +3,12 @@
 #include <BGE/Config.h>
 #include <BGE/System/Err.h>
 #include <locale>
+#include <limits>
 #include <string>
 #include <cmath>
+#include <cstring>
 #include <sstream>
+#include <type_traits>
 
 namespace bge
 {
@@ -74,15 +77,96 @@ BGE_EXPORT_API bool operator >=(const String& left, const String& right);
 BGE_EXPORT_API String operator +(const String& left, const String& right);
 
 void BGE_EXPORT_API splitAndConvert(const std::string& s,char flag,String& string);
+void BGE_EXPORT_API splitAndConvert(const char* s,char flag,String& string);
+
+//! locale independent conversions of numbers,they neither allocate nor build a stream
+//! fromChars skips leading spaces as a stream does,returns the end of the number or first if none was read,value is kept then
+BGE_EXPORT_API const char* fromChars(const char* first,const char* last,int64_t& value);
+BGE_EXPORT_API const char* fromChars(const char* first,const char* last,uint64_t& value);
+BGE_EXPORT_API const char* fromChars(const char* first,const char* last,double& value);
+BGE_EXPORT_API const char* fromChars(const char* first,const char* last,float& value);
+//! toChars writes what a stream with the default format writes,without a terminating zero
+//! returns the end of the text,or first if it does not fit
+BGE_EXPORT_API char* toChars(char* first,char* last,int64_t value);
+BGE_EXPORT_API char* toChars(char* first,char* last,uint64_t value);
+BGE_EXPORT_API char* toChars(char* first,char* last,double value);
+BGE_EXPORT_API char* toChars(char* first,char* last,float value);
+
+//! arithmetic types other than bool,long double and the character types,the character types are read and written as characters
+template<typename T>
+struct IsNumber : std::integral_constant<bool,std::is_arithmetic<T>::value && !std::is_same<T,bool>::value &&
+    !std::is_same<T,char>::value && !std::is_same<T,signed char>::value && !std::is_same<T,unsigned char>::value &&
+    !std::is_same<T,wchar_t>::value && !std::is_same<T,char16_t>::value && !std::is_same<T,char32_t>::value &&
+    !std::is_same<T,long double>::value>
+{
+};
 
-template <typename T>
-inline std::string toString(const T& v)
+//! the other integers are read as 64 bit ones,a number out of their range is not read
+template<typename T>
+inline typename std::enable_if<IsNumber<T>::value && std::is_integral<T>::value,const char*>::type
+    fromChars(const char* first,const char* last,T& value)
+{
+    typedef typename std::conditional<std::is_signed<T>::value,int64_t,uint64_t>::type Wide;
+    Wide wide = 0;
+    const char* end = fromChars(first,last,wide);
+    if(end == first || wide < Wide(std::numeric_limits<T>::min()) || wide > Wide(std::numeric_limits<T>::max()))
+        return first;
+    value = T(wide);
+    return end;
+}
+
+template<typename T>
+inline typename std::enable_if<IsNumber<T>::value && std::is_integral<T>::value,char*>::type
+    toChars(char* first,char* last,T value)
+{
+    typedef typename std::conditional<std::is_signed<T>::value,int64_t,uint64_t>::type Wide;
+    return toChars(first,last,Wide(value));
+}
+
+namespace priv
+{
+
+template<typename T>
+inline std::string toString(const T& v,std::true_type)
+{
+    // the longest float is -1.23457e-308
+    char buffer[32];
+    return std::string(buffer,toChars(buffer,buffer + sizeof(buffer),v));
+}
+
+template<typename T>
+inline std::string toString(const T& v,std::false_type)
 {
     std::ostringstream  os;
     os << v;
     return os.str();
 }
 
+template<typename T>
+inline T fromString(const char* first,const char* last,std::true_type)
+{
+    T value = T();
+    fromChars(first,last,value);
+    return value;
+}
+
+template<typename T>
+inline T fromString(const char* first,const char* last,std::false_type)
+{
+    T ret;
+    std::istringstream is(std::string(first,last));
+    is >> ret;
+    return ret;
+}
+
+}
+
+template <typename T>
+inline std::string toString(const T& v)
+{
+    return priv::toString(v,IsNumber<T>());
+}
+
 inline String toBGEString(uint16_t value)
 {
     String s(value);
@@ -94,13 +178,35 @@ inline std::string toString(const bool& v)
     return v ? "true" : "false";
 }
 
+//! a number that cannot be read gives zero
 template <typename T>
 inline T fromString(const std::string& str)
 {
-    T ret;
-    std::istringstream is(str);
-    is >> ret;
-    return ret;
+    return priv::fromString<T>(str.data(),str.data() + str.size(),IsNumber<T>());
+};
+
+namespace priv
+{
+
+template<typename T>
+inline T fromString(const char* text,std::true_type)
+{
+    return fromString<T>(text,text + strlen(text),std::true_type());
+}
+
+template<typename T>
+inline T fromString(const char* text,std::false_type)
+{
+    return bge::fromString<T>(std::string(text));
+}
+
+}
+
+//! numbers are read in place,other types are read from a copy of text
+template <typename T>
+inline T fromString(const char* text)
+{
+    return priv::fromString<T>(text,IsNumber<T>());
 };
 
 template <>
@@ -0,0 +1,58 @@
+#ifndef BGE_SYSTEM_TASKQUEUE_H
+#define BGE_SYSTEM_TASKQUEUE_H
+#include <BGE/Config.h>
+#include <BGE/System/NonCopyable.h>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace bge
+{
+
+//! tasks posted by any thread are run by one consumer thread in the order they were posted
+//! posting takes one atomic exchange and never waits for the consumer or other producers
+class BGE_EXPORT_API TaskQueue : NonCopyable
+{
+public:
+    typedef std::function<void()> Task;
+public:
+    //! registers the queue run by the calling thread,null removes it
+    static void setThreadQueue(TaskQueue* queue);
+    //! the queue run by a thread,null if it runs none
+    static TaskQueue* threadQueue(std::thread::id thread);
+public:
+    TaskQueue();
+    //! tasks not run are discarded
+    ~TaskQueue();
+public:
+    void post(Task task);
+    //! the tasks run one after another,not interleaved with tasks of other threads
+    void post(std::vector<Task> tasks);
+
+    //! consumer only,runs tasks until the queue is empty or budget seconds passed,returns how many ran
+    size_t run(float budget);
+    //! consumer only,discards the tasks not run
+    void clear();
+    //! consumer only,false while a task is being posted
+    bool isEmpty()const;
+private:
+    struct Node
+    {
+        std::atomic<Node*> next_;
+        Task task_;
+    };
+private:
+    //! links first to last,already linked to each other,as one step
+    void push(Node* first,Node* last);
+    Node* pop();
+private:
+    std::atomic<Node*> head_;
+    Node* tail_;
+    Node stub_;
+};
+
+}
+
+#endif
@@ -5,10 +5,14 @@
 namespace bge
 {
 
+//! clocks are monotonic,they count from the first call and do not follow changes of the wall clock
 class BGE_EXPORT_API TimeManager
 {
 public:
+    //! seconds
     static float systemTime();
+    static uint64_t milliseconds();
+    static uint64_t nanoseconds();
 };
 
 }
@@ -2,35 +2,96 @@
 #ifndef BGE_SYSTEM_TIMER_H
 #define BGE_SYSTEM_TIMER_H
 #include <BGE/Config.h>
+#include <BGE/System/NonCopyable.h>
 #include <BGE/System/SigSlot.h>
 
 namespace bge
 {
 
-class BGE_EXPORT_API Timer
+class Timer;
+
+//! links a started timer into a slot of the timer wheel,a slot is a circular list around an empty link
+struct TimerLink
+{
+    TimerLink():
+        next_(this),
+        previous_(this),
+        timer_(0)
+    {
+    }
+
+    bool isEmpty()const{return next_ == this;}
+
+    TimerLink* next_;
+    TimerLink* previous_;
+    Timer* timer_;
+};
+
+//! triggers repeatedly every interval milliseconds once started,on the thread advancing the timer wheel
+class BGE_EXPORT_API Timer : NonCopyable
 {
 public:
     explicit Timer(uint32_t interval = 1000);
     virtual ~Timer();
 public:
-    int32_t  interval()const{return interval_;}
-    Timer& setInterval(uint32_t seconds)
-    {
-        interval_ = seconds;
-        return *this;
-    }
+    //! milliseconds
+    uint32_t interval()const{return interval_;}
+    //! a started timer is due interval milliseconds after it was started or last triggered
+    Timer& setInterval(uint32_t milliseconds);
 
     bool   isStarted()const{return isStarted_;}
-    bool   isElapsed();
+    //! TimeManager::milliseconds at which the timer triggers next
+    uint64_t deadline()const{return deadline_;}
 public:
     Timer& start();
     Timer& stop();
 public:
     Signal0 trigger;
 private:
+    friend class TimerWheel;
     uint32_t interval_;
     bool     isStarted_;
-    uint32_t lastTriggerTime_;
+    uint64_t lastTriggerTime_;
+    uint64_t deadline_;
+    TimerLink link_;
+};
+
+//! schedules the started timers,starting and stopping a timer take constant time
+//! a slot of the first level covers one millisecond,each further level covers a whole turn of the level below
+class BGE_EXPORT_API TimerWheel : NonCopyable
+{
+public:
+    //! deadline without a started timer
+    static const uint64_t never = ~uint64_t(0);
+public:
+    static TimerWheel& instance();
+public:
+    //! triggers the timers due until now,returns how many were triggered
+    uint32_t advance(uint64_t now);
+    //! TimeManager::milliseconds of the earliest deadline,never without a started timer
+    uint64_t nextDeadline()const;
+    uint32_t timerCount()const{return count_;}
+private:
+    friend class Timer;
+    TimerWheel();
+    void schedule(Timer* timer);
+    void cancel(Timer* timer);
+    //! moves the timers of a slot of an upper level down,returns the index of the slot
+    uint32_t cascade(uint32_t level);
+    static uint64_t earliestDeadline(const TimerLink& slot);
+private:
+    static const uint32_t rootBits = 8;
+    static const uint32_t levelBits = 6;
+    static const uint32_t rootSize = 1 << rootBits;
+    static const uint32_t levelSize = 1 << levelBits;
+    static const uint32_t levelCount = 4;
+    TimerLink root_[rootSize];
+    TimerLink levels_[levelCount][levelSize];
+    //! the next millisecond to be processed
+    uint64_t current_;
+    uint32_t count_;
+    mutable uint64_t nextDeadline_;
+    mutable bool isDeadlineValid_;
 };
 
 }
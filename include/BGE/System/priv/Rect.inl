@@ -59,8 +59,8 @@ bool Rect<T>::intersects(const Rect<T>& rectangle, Rect<T>& intersection) const
     // Compute the intersection boundaries
     T interLeft   = std::max(left_,         rectangle.left_);
     T interTop    = std::max(top_,          rectangle.top_);
-    T interRight  = std::min(left_ + width_, rectangle.left_ + rectangle.width);
-    T interBottom = std::min(top_ + height_, rectangle.top_ + rectangle.height);
+    T interRight  = std::min(left_ + width_, rectangle.left_ + rectangle.width_);
+    T interBottom = std::min(top_ + height_, rectangle.top_ + rectangle.height_);
 
     // If the intersection is valid (positive non zero area), then there is an intersection
     if ((interLeft < interRight) && (interTop < interBottom))
@@ -78,8 +78,8 @@ bool Rect<T>::intersects(const Rect<T>& rectangle, Rect<T>& intersection) const
 template <typename T>
 inline bool operator ==(const Rect<T>& left, const Rect<T>& right)
 {
-    return (left.left == right.left) && (left.width == right.width) &&
-           (left.top == right.top) && (left.height == right.height);
+    return (left.left_ == right.left_) && (left.width_ == right.width_) &&
+           (left.top_ == right.top_) && (left.height_ == right.height_);
 }
 
 template <typename T>
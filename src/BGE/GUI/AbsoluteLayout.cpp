@@ -22,6 +22,7 @@ Layout& AbsoluteLayout::addWindow(Window* window)
     {
         windows_.push_back(window);
         parent()->insertChild(window);
+        changed();
     }
     return *this;
 }
@@ -38,7 +39,8 @@ Layout& AbsoluteLayout::arrangeWithin()
 
 Layout& AbsoluteLayout::removeWindow(Window* window)
 {
-    windows_.remove(window);
+    eraseWindow(window);
+    changed();
     if(parent())
     {
         parent()->removeChild(window);
@@ -46,18 +48,20 @@ Layout& AbsoluteLayout::removeWindow(Window* window)
     return *this;
 }
 
-bool AbsoluteLayout::loadProperty(TiXmlNode* node)
+bool AbsoluteLayout::loadProperty(const PropertyNode& node)
 {
-    TiXmlElement* element = node->FirstChildElement("windows");
+    PropertyNode windows = node.firstChild("windows");
+    PropertyNode element = windows.firstChild("window");
     while(element)
     {
 		Window* window = parse(element);
 		if(window)
-			windows_.push_back(window);
-		element = element->NextSiblingElement();
+			addWindow(window);
+		element = element.nextSibling("window");
     }
+    changed();
 
-    TiXmlNode* window = node->FirstChildElement("Layout");
+    PropertyNode window = node.firstChild("Layout");
     Layout::loadProperty(window);
     return true;
 }
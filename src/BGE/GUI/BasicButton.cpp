@@ -12,7 +12,7 @@ namespace bge
 
 IMPLEMENT_OBJECT(ButtonGroup,Object)
 
-bool ButtonGroup::loadProperty(TiXmlNode* node)
+bool ButtonGroup::loadProperty(const PropertyNode& node)
 {
 	if(!parent())
 	{
@@ -20,19 +20,19 @@ bool ButtonGroup::loadProperty(TiXmlNode* node)
 		return false;
 	}
 
-	TiXmlElement* item = node->FirstChildElement("buttons");
+	PropertyNode item = node.firstChild("buttons");
 	if(item)
-		item = item->FirstChildElement("button");
+		item = item.firstChild("button");
     while(item)
     {
-		BasicButton* button = Object::castTo<BasicButton>(parent()->findChild(item->GetText()));
+		BasicButton* button = Object::castTo<BasicButton>(parent()->findChild(item.text()));
 		if(button)
 			buttons_.push_back(button);
 		else
 			err() << "ButtonGroup parse button failed.\n";
-		item = item->NextSiblingElement();
+		item = item.nextSibling();
     }
-    TiXmlNode* object = node->FirstChildElement("Object");
+    PropertyNode object = node.firstChild("Object");
     Object::loadProperty(object);
     return true;    
 }
@@ -281,7 +281,7 @@ BasicButtonDesc& BasicButton::buttonDesc() const
 
 WINDOW_LOAD_APPAREARANCE(BasicButton)
 
-bool BasicButton::loadProperty(TiXmlNode* node)
+bool BasicButton::loadProperty(const PropertyNode& node)
 {
 	std::string buttongroup_;
 	DESERIALIZE_OBJECT(buttongroup,node,std::string)
@@ -291,7 +291,7 @@ bool BasicButton::loadProperty(TiXmlNode* node)
 	    group_ = Object::castTo<ButtonGroup>(parent()->findChild(buttongroup_));
 	}
         
-	TiXmlNode* window = node->FirstChildElement("Window");
+	PropertyNode window = node.firstChild("Window");
     Window::loadProperty(window);
     return true;
 }
@@ -312,14 +312,6 @@ bool BasicButton::saveProperty(TiXmlNode* node)
     return true;
 }
 
-void BasicButton::deleteLater()
-{
-    if(renderDesc_)
-	    renderDesc_->deleteLater();
-    renderDesc_ = NULL;
-	Window::deleteLater();
-}
-
 ButtonStateDesc::ButtonStateDesc():
     background_(new SolidSurfaceDesc()),
     border_(new RectangleDesc()),
@@ -379,9 +371,9 @@ void ButtonStateDesc::draw(const FloatRect& area,Canvas* canvas)const
     }
 }
 
-bool ButtonStateDesc::loadProperty(TiXmlNode* node,const char* name)
+bool ButtonStateDesc::loadProperty(const PropertyNode& node,const char* name)
 {
-    TiXmlElement* this_ = node->FirstChildElement(name);
+    PropertyNode this_ = node.firstChild(name);
     if(!this_)
         return false;
 
@@ -427,9 +419,9 @@ Vector2f BasicButtonDesc::defaultTextSize() const
     return textDesc.textSize() + Vector2f(8.0f, 8.0f);
 }
 
-bool BasicButtonDesc::loadProperty(TiXmlNode* node)
+bool BasicButtonDesc::loadProperty(const PropertyNode& node)
 {
-    TiXmlElement* thisNode = node->FirstChildElement("ButtonDesc");
+    PropertyNode thisNode = node.firstChild("ButtonDesc");
     if(!thisNode)
         return false;
     
@@ -438,7 +430,7 @@ bool BasicButtonDesc::loadProperty(TiXmlNode* node)
     rollOverDesc_.loadProperty(thisNode,"rollOverDesc");
     rollOverOnDesc_.loadProperty(thisNode,"rollOverOnDesc");
   
-    TiXmlNode* desc = thisNode->FirstChildElement("RenderDesc");
+    PropertyNode desc = thisNode.firstChild("RenderDesc");
 	if(desc)
         RenderDesc::loadProperty(desc);
     return true;
@@ -27,6 +27,7 @@ Layout& BoxLayout::addWindow(Window* window)
     {
         windows_.push_back(window);
         parent()->insertChild(window);
+        changed();
     }
     else
         err() <<"parent is NULL.\n";
@@ -35,7 +36,8 @@ Layout& BoxLayout::addWindow(Window* window)
 
 Layout& BoxLayout::removeWindow(Window* window)
 {
-    windows_.remove(window);
+    eraseWindow(window);
+    changed();
     if(parent())
     {
         parent()->removeChild(window);
@@ -66,7 +68,7 @@ Layout& BoxLayout::arrangeWithin()
             windowHeight = (height - (spacing() * (numWindows + 1.0f))) / numWindows;
         }
 
-        for(std::list<Window*>::iterator it = windows_.begin(); it != windows_.end(); ++it)
+        for(std::vector<Window*>::iterator it = windows_.begin(); it != windows_.end(); ++it)
         {
             (*it)->setSize(Vector2f(windowWidth,windowHeight));
         }
@@ -76,7 +78,7 @@ Layout& BoxLayout::arrangeWithin()
     {
         const float parentCenter = window->position().y() + (height * 0.5f);
         float x = window->position().x() + space;
-        for(std::list<Window*>::iterator it = windows_.begin(); it != windows_.end(); ++it)
+        for(std::vector<Window*>::iterator it = windows_.begin(); it != windows_.end(); ++it)
         {
             Window* window = *it;
             const float y = parentCenter - (window->size().y() * 0.5f);
@@ -88,7 +90,7 @@ Layout& BoxLayout::arrangeWithin()
     {
         const float parentCenter = window->position().x() + (width * 0.5f);
         float y = window->position().y() + space;
-        for(std::list<Window*>::iterator it = windows_.begin(); it != windows_.end(); ++it)
+        for(std::vector<Window*>::iterator it = windows_.begin(); it != windows_.end(); ++it)
         {
             Window* window = *it;
             const float x = parentCenter - (window->size().x() * 0.5f);
@@ -100,19 +102,21 @@ Layout& BoxLayout::arrangeWithin()
     return *this;
 }
 
-bool BoxLayout::loadProperty(TiXmlNode* node)
+bool BoxLayout::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(justification,node,Orientation)
     DESERIALIZE_OBJECT(isChildSizeRespected,node,bool)
-    TiXmlElement* element = node->FirstChildElement("windows");
+    PropertyNode windows = node.firstChild("windows");
+    PropertyNode element = windows.firstChild("window");
     while(element)
     {
 		Window* window = parse(element);
 		if(window)
-			windows_.push_back(window);
-		element = element->NextSiblingElement();
+			addWindow(window);
+		element = element.nextSibling("window");
     }
-    TiXmlNode* window = node->FirstChildElement("Layout");
+    changed();
+    PropertyNode window = node.firstChild("Layout");
     Layout::loadProperty(window);
 	arrangeWithin();
     return true;
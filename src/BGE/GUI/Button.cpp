@@ -18,9 +18,9 @@ Window& Button::onDraw()
     return *this;
 }
 
-bool Button::loadProperty(TiXmlNode* node)
+bool Button::loadProperty(const PropertyNode& node)
 {
-    TiXmlNode* window = node->FirstChildElement("BasicButton");
+    PropertyNode window = node.firstChild("BasicButton");
     BasicButton::loadProperty(window);
     return true;
 }
@@ -62,10 +62,10 @@ Vector2f CheckBox::recommendedSize() const
 
 WINDOW_LOAD_APPAREARANCE(CheckBox)
 
-bool CheckBox::loadProperty(TiXmlNode* node)
+bool CheckBox::loadProperty(const PropertyNode& node)
 {
     //DESERIALIZE_OBJECT(value,node,int)
-    TiXmlNode* window = node->FirstChildElement("BasicButton");
+    PropertyNode window = node.firstChild("BasicButton");
     BasicButton::loadProperty(window);
     return true;
 }
@@ -79,7 +79,7 @@ bool CheckBox::saveProperty(TiXmlNode* node)
     return true;
 }
 
-IMPLEMENT_OBJECT(CheckBoxDesc,RenderDesc)
+IMPLEMENT_OBJECT(CheckBoxDesc,BasicButtonDesc)
 
 CheckBoxDesc::CheckBoxDesc():
     checked_(new DefaultCheckDesc()),
@@ -92,14 +92,14 @@ CheckBoxDesc::~CheckBoxDesc()
 {
 }
 
-bool CheckBoxDesc::loadProperty(TiXmlNode* node)
+bool CheckBoxDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("CheckBoxDesc");
+	PropertyNode thisNode = node.firstChild("CheckBoxDesc");
 	if(thisNode)
 	{
         CREATE_BY_NODE(unchecked,node,RenderDesc)
         CREATE_BY_NODE(checked,node,RenderDesc)
-		TiXmlNode* window = thisNode->FirstChildElement("RenderDesc");
+		PropertyNode window = thisNode.firstChild("RenderDesc");
 		RenderDesc::loadProperty(window);
 	}
 	return true;
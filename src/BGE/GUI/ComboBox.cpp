@@ -77,11 +77,25 @@ ComboBox::ComboBox(Window* parent,const FloatRect& rect):
 
 ComboBox::~ComboBox()
 {
+    if(listBox_)
+    {
+        closeDropDown();
+        WindowManager::instance().removeWindow(listBox_);
+        delete listBox_;
+    }
+    removeMessageListener(comboBoxMouseListener_);
+    delete comboBoxMouseListener_;
+}
+
+void ComboBox::destroy()
+{
+    // the list box is a child,it must be gone before the children are deleted
     closeDropDown();
     WindowManager::instance().removeWindow(listBox_);
+    listBox_->remove();
     delete listBox_;
-    removeMessageListener(comboBoxMouseListener_);
-    delete comboBoxMouseListener_;
+    listBox_ = 0;
+    Window::destroy();
 }
 
 ComboBox& ComboBox::addString(const String& string)
@@ -222,22 +236,12 @@ ComboBox& ComboBox::closeDropDown()
     return *this;
 }
 
-void ComboBox::deleteLater()
-{
-    closeDropDown();
-    WindowManager::instance().removeWindow(listBox_);
-    delete listBox_;
-    removeMessageListener(comboBoxMouseListener_);
-    delete comboBoxMouseListener_;
-	Window::deleteLater();
-}
-
 WINDOW_LOAD_APPAREARANCE(ComboBox)
 
-bool ComboBox::loadProperty(TiXmlNode* node)
+bool ComboBox::loadProperty(const PropertyNode& node)
 {
 	std::vector<String> item_;
-	TiXmlElement* items = node->FirstChildElement("strings");
+	PropertyNode items = node.firstChild("strings");
 	if(items)
 	{
 		DESERIALIZE_OBJECT_CONTAINER(item,items,std::vector<String>,String)
@@ -252,7 +256,7 @@ bool ComboBox::loadProperty(TiXmlNode* node)
 	if(numberOfStrings() != 0)
 		selectStringAt(0);
 
-    TiXmlNode* window = node->FirstChildElement("Window");
+    PropertyNode window = node.firstChild("Window");
     Window::loadProperty(window);
     return true;
 }
@@ -330,15 +334,15 @@ void ComboBoxDesc::draw(const FloatRect& area,Canvas* canvas) const
     canvas->setColor(Color(1, 1, 1, 1));
 }
 
-bool ComboBoxDesc::loadProperty(TiXmlNode* node)
+bool ComboBoxDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("ComboBoxDesc");
+	PropertyNode thisNode = node.firstChild("ComboBoxDesc");
 	if(thisNode)
 	{
 		CREATE_BY_NODE(background,node,RenderDesc)
 		CREATE_BY_NODE(border,node,RenderDesc)
 		CREATE_BY_NODE(textDesc,node,TextDesc)
-		TiXmlNode* desc = thisNode->FirstChildElement("RenderDesc");
+		PropertyNode desc = thisNode.firstChild("RenderDesc");
 		RenderDesc::loadProperty(desc);
 	}
     return true;
@@ -477,13 +477,13 @@ Window& EditField::onDraw()
 
 WINDOW_LOAD_APPAREARANCE(EditField)
 
-bool EditField::loadProperty(TiXmlNode* node)
+bool EditField::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(caretPosition,node,uint32_t)
     //DESERIALIZE_OBJECT(selection,node,Selection)
     DESERIALIZE_OBJECT(selectionStart,node,uint32_t)
     DESERIALIZE_OBJECT(xOffset,node,uint32_t)
-    TiXmlNode* window = node->FirstChildElement("Window");
+    PropertyNode window = node.firstChild("Window");
     Window::loadProperty(window);
     return true;
 }
@@ -500,14 +500,6 @@ bool EditField::saveProperty(TiXmlNode* node)
     return true;
 }
 
-void EditField::deleteLater()
-{
-    removeMessageListener(mouseListener_);
-    delete mouseListener_;
-    removeMessageListener(this);
-	Window::deleteLater();
-}
-
 EditFieldDesc& EditField::renderDesc() const
 {
     return (renderDesc_ != 0) ? *renderDesc_ : WindowManager::instance().propertyScheme()->editFieldDesc_;
@@ -530,15 +522,15 @@ EditFieldDesc::~EditFieldDesc()
     delete textDesc_;
 }
 
-bool EditFieldDesc::loadProperty(TiXmlNode* node)
+bool EditFieldDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("EditFieldDesc");
+	PropertyNode thisNode = node.firstChild("EditFieldDesc");
 	if(thisNode)
 	{
 		CREATE_BY_NODE(background,thisNode,RenderDesc)
 		CREATE_BY_NODE(border,thisNode,RenderDesc)
 		CREATE_BY_NODE(textDesc,thisNode,TextDesc)
-		TiXmlNode* window = thisNode->FirstChildElement("RenderDesc");
+		PropertyNode window = thisNode.firstChild("RenderDesc");
 		RenderDesc::loadProperty(window);
 	}
 	return true;
@@ -26,6 +26,7 @@ Layout& FlowLayout::addWindow(Window* window)
     {
         windows_.push_back(window);
         parent()->insertChild(window);
+        changed();
     }
     else
         err() << "parent is NULL.\n";
@@ -34,7 +35,8 @@ Layout& FlowLayout::addWindow(Window* window)
 
 Layout& FlowLayout::removeWindow(Window* window)
 {
-    windows_.remove(window);
+    eraseWindow(window);
+    changed();
     if(parent())
         parent()->removeChild(window);
     return *this;
@@ -49,8 +51,8 @@ Layout& FlowLayout::arrangeWithin()
     const float width = window_->size().x();
     const float height = window_->size().y();
 
-    std::list<Window*>::iterator first = windows_.begin();
-    std::list<Window*>::iterator last = first;
+    std::vector<Window*>::iterator first = windows_.begin();
+    std::vector<Window*>::iterator last = first;
 
     bool done = false;
 
@@ -112,7 +114,7 @@ Layout& FlowLayout::arrangeWithin()
             }
 
             float maxY = 0.0f;
-            for(std::list<Window*>::iterator it = first; it != last; ++it)
+            for(std::vector<Window*>::iterator it = first; it != last; ++it)
             {
                 Window* window = (*it);
                 window->setPosition(Vector2f(x, y) + window_->position());
@@ -128,18 +130,20 @@ Layout& FlowLayout::arrangeWithin()
     return *this;
 }
 
-bool FlowLayout::loadProperty(TiXmlNode* node)
+bool FlowLayout::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(alignment,node,Horizontal)
-    TiXmlElement* element = node->FirstChildElement("windows");
+    PropertyNode windows = node.firstChild("windows");
+    PropertyNode element = windows.firstChild("window");
     while(element)
     {
 		Window* window = parse(element);
 		if(window)
-			windows_.push_back(window);
-		element = element->NextSiblingElement();
+			addWindow(window);
+		element = element.nextSibling("window");
     }
-    TiXmlNode* window = node->FirstChildElement("Layout");
+    changed();
+    PropertyNode window = node.firstChild("Layout");
     Layout::loadProperty(window);
 	arrangeWithin();
     return true;
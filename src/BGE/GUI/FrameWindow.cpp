@@ -41,14 +41,6 @@ FrameWindow::~FrameWindow()
     delete mouseListener_;
 }
 
-void FrameWindow::deleteLater()
-{
-    removeMessageListener(mouseListener_);
-    delete mouseListener_;
-	mouseListener_ = NULL;
-    Window::deleteLater();
-}
-
 FloatRect FrameWindow::clientRectangle() const
 {
     FrameWindowDesc* renderDesc = renderDesc_;
@@ -169,24 +161,24 @@ void FrameWindow::onMove()
 
 WINDOW_LOAD_APPAREARANCE(FrameWindow)
 
-bool FrameWindow::loadProperty(TiXmlNode* node)
+bool FrameWindow::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(isMovable,node,bool)
-    TiXmlNode* window = node->FirstChildElement("Window");
+    PropertyNode window = node.firstChild("Window");
     Window::loadProperty(window);
     if(clientWindow_)
         clientWindow_->deleteLater();
 	clientWindow_ = NULL;
 
-    TiXmlElement* client = node->FirstChildElement("Client");
+    PropertyNode client = node.firstChild("Client");
     if(client)
     {
-        std::string classname = client->Attribute("class");
+        std::string classname = client.attribute("class");
 		if(classname != "Panel")
 			err()<<"FrameWindow 's clientWindow must to be Panel\n";
 		else
 		{
-			Object* object = Rtti::rttiByObjectName(classname)->createObject();
+			Object* object = client.rtti()->createObject();
 			if(object)
 			{
 				Panel* panel = Object::castTo<Panel>(object);
@@ -344,9 +336,9 @@ void FrameWindowDesc::draw(const FloatRect& area,Canvas* canvas)const
     canvas->setColor(Color(1, 1, 1, 1));
 }
 
-bool FrameWindowDesc::loadProperty(TiXmlNode* node)
+bool FrameWindowDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("FrameWindowDesc");
+	PropertyNode thisNode = node.firstChild("FrameWindowDesc");
 	if(thisNode)
 	{
 		CREATE_BY_NODE(topLeftDesc,thisNode,RenderDesc)
@@ -363,7 +355,7 @@ bool FrameWindowDesc::loadProperty(TiXmlNode* node)
 		DESERIALIZE_OBJECT(leftBorderWidth,thisNode,float)
 		DESERIALIZE_OBJECT(rightBorderWidth,thisNode,float)
 		DESERIALIZE_OBJECT(bottomBorderWidth,thisNode,float)
-		TiXmlNode* window = thisNode->FirstChildElement("RenderDesc");
+		PropertyNode window = thisNode.firstChild("RenderDesc");
 		RenderDesc::loadProperty(window);
 	}
     return true;
@@ -3,9 +3,6 @@
 #include <BGE/GUI/Window.h>
 #include <BGE/GUI/Layout.h>
 #include <algorithm>
-#if defined(_MSC_VER)
-#include <numeric>
-#endif
 
 namespace bge
 {
@@ -64,7 +61,10 @@ Layout& GridLayout::addWindow(Window* window,const LayoutInfo& inf)
 
 	    Cell cell(window,info);
 	    cells_.push_back(cell);
+	    windows_.push_back(window);
+	    isPlaced_ = false;
 		parent()->insertChild(window);
+		changed();
 	}
     else
         err() << "parent is NULL.\n";
@@ -73,18 +73,58 @@ Layout& GridLayout::addWindow(Window* window,const LayoutInfo& inf)
 
 Layout& GridLayout::removeWindow(Window* window)
 {
-    std::list<Cell>::iterator it;
-    for(it = cells_.begin(); it != cells_.end(); ++it)
+    for(auto it = cells_.begin(); it != cells_.end(); ++it)
     {
         if((*it).window_ == window)
+        {
+            cells_.erase(it);
             break;
+        }
     }
-    if(it != cells_.end())
-        cells_.erase(it);
+    eraseWindow(window);
+    isPlaced_ = false;
+    changed();
     parent()->removeChild(window);
     return *this;
 }
 
+// fixed tracks keep their size while they fit,the others share the space left equally
+static void layoutTracks(const std::vector<float>& sizes,uint32_t count,float total,std::vector<float>& offsets)
+{
+    float fixed = 0.0f;
+    uint32_t flexible = 0;
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        const float size = i < sizes.size() ? sizes[i] : 0.0f;
+        if(size == 0.0f)
+            flexible++;
+        else
+            fixed = std::min(fixed + size,total);
+    }
+
+    float share = 0.0f;
+    if(flexible > 0 && total - fixed > float(flexible))
+        share = (total - fixed) / float(flexible);
+
+    offsets.resize(count + 1);
+    float offset = 0.0f;
+    float used = 0.0f;
+    for(uint32_t i = 0; i < count; ++i)
+    {
+        offsets[i] = offset;
+        float size = i < sizes.size() ? sizes[i] : 0.0f;
+        if(size == 0.0f)
+            size = share;
+        else
+        {
+            size = std::max(std::min(size,total - used),0.0f);
+            used += size;
+        }
+        offset += size;
+    }
+    offsets[count] = offset;
+}
+
 Layout& GridLayout::arrangeWithin()
 {
     Window* window_ = (Window*)parent();
@@ -96,165 +136,49 @@ Layout& GridLayout::arrangeWithin()
 
     const Vector2f offset = window_->position() + border_;
 
-    const uint32_t numWindows = cells_.size();
-
-    if(numWindows > 0)
-    {
-        calculateBlocks();
+    if(cells_.empty())
+        return *this;
 
-        std::vector<float> colWidths = columnWidths_;
-        std::vector<float> rowHeights = rowHeights_;
+    if(!isPlaced_)
+        placeCells();
 
-        calculateColWidths(colWidths, width);
-        calculateRowHeights(rowHeights, height);
+    layoutTracks(columnWidths_,numCols_,width,columnOffsets_);
+    layoutTracks(rowHeights_,numRows_,height,rowOffsets_);
 
-        std::map<uint32_t, Block>::iterator it;
-        for(it = blockMap_.begin(); it != blockMap_.end(); ++it)
-        {
-            const Block& block = (*it).second;
-
-            if(block.windowStart)
-            {
-                auto xStartIt = colWidths.begin();
-                std::advance(xStartIt, block.col);
-
-                auto xEndIt = xStartIt;
-                std::advance(xEndIt, block.hSpan);
-
-                auto yStartIt = rowHeights.begin();
-                std::advance(yStartIt, block.row);
-
-                auto yEndIt = yStartIt;
-                std::advance(yEndIt, block.vSpan);
-
-                const float x = std::accumulate(colWidths.begin(),  xStartIt, 0.0f) + block.hSpace;
-                const float y = std::accumulate(rowHeights.begin(), yStartIt, 0.0f) + block.vSpace;
-
-                const float childWidth  = std::accumulate(xStartIt, xEndIt, 0.0f) - (2.0f * block.hSpace);
-                const float childHeight = std::accumulate(yStartIt, yEndIt, 0.0f) - (2.0f * block.vSpace);
-
-                block.window->setPosition(Vector2f(x, y) + offset);
-                block.window->setSize(Vector2f(childWidth,childHeight));
-				err()<<block.window->objectName()<<" "<<block.vSpace<<" "<<block.window->size().x_<<" "<<block.window->size().y_<<std::endl;
-            }
-        }
-    }
-
-    return *this;
-}
-
-void GridLayout::calculateColWidths(std::vector<float>& colWidths, float width)
-{
-    float totalWidth = 0;
-    float curWidth = 0;
-    unsigned int numUnset = 0;
-	for(std::vector<float>::iterator it = colWidths.begin(); it != colWidths.end(); ++it)
+    const float space = spacing();
+    for(size_t i = 0; i < cells_.size(); ++i)
     {
-        float& w = *it;
-        if(w == 0.0f)
-            numUnset++;
-        else
-        {
-            totalWidth += w;
-            if(totalWidth > width)
-            {
-                w = width - curWidth;
-                totalWidth = width;
-            }
-            curWidth = totalWidth;
-        }
-    }
+        const Cell& cell = cells_[i];
+        const uint32_t lastCol = cell.column_ + std::max(cell.info_.horizontalSpan_,1u);
+        const uint32_t lastRow = cell.row_ + std::max(cell.info_.verticalSpan_,1u);
 
-    const float numUnsetCols = numCols_ - colWidths.size() + numUnset;
+        const float x = columnOffsets_[cell.column_] + space;
+        const float y = rowOffsets_[cell.row_] + space;
+        const float childWidth  = columnOffsets_[lastCol] - columnOffsets_[cell.column_] - (2.0f * space);
+        const float childHeight = rowOffsets_[lastRow] - rowOffsets_[cell.row_] - (2.0f * space);
 
-    if(numUnsetCols > 0.0f)
-    {
-        float w = 0;
-        if(totalWidth < width)
-        {
-            const float remainingWidth = width - totalWidth;
-            if(remainingWidth > numUnsetCols) 
-				w = remainingWidth / numUnsetCols;
-        }
- 
-        for(size_t i = 0; i < colWidths.size(); ++i)
-        {
-            if(colWidths[i] == 0.0f) 
-				colWidths[i] = w;
-        }
-
-		int32_t count = numCols_ - colWidths.size();
-		//if(count < 0)
-		//	assert(0);
-		//	count = -count;
-		//if(count > 0)
-		{
-			for(size_t j = 0; j < count; ++j)
-			{
-				colWidths.push_back(w);
-			}
-		}
-    }
-}
-
-void GridLayout::calculateRowHeights(std::vector<float>& rowHeights,float height)
-{
-    float totalHeight = 0;
-    float curHeight = 0;
-    uint32_t numUnset = 0;
-    for(auto it = rowHeights.begin(); it != rowHeights.end(); ++it)
-    {
-        float& w = *it;
-        if(w == 0.0f)
-            numUnset++;
-        else
-        {
-            totalHeight += w;
-            if(totalHeight > height)
-            {
-                w = height - curHeight;
-                totalHeight = height;
-            }
-            curHeight = totalHeight;
-        }
+        cell.window_->setPosition(Vector2f(x, y) + offset);
+        cell.window_->setSize(Vector2f(childWidth,childHeight));
     }
 
-    const float numUnsetRows = static_cast<float>(numRows_ - rowHeights.size() + numUnset);
-    if(numUnsetRows > 0.0f)
-    {
-        float h = 0;
-        if(totalHeight < height)
-        {
-            const float remainingHeight = height - totalHeight;
-            if(remainingHeight > numUnsetRows)
-                h = remainingHeight / numUnsetRows;
-        }
-        for(int i = 0; i < int(rowHeights.size()); ++i)
-        {
-            if(rowHeights[i] == 0)
-                rowHeights[i] = h;
-        }
-        for(unsigned j = 0; j < numRows_ - rowHeights.size(); ++j)
-        {
-            rowHeights.push_back(h);
-        }
-    }
+    return *this;
 }
 
-void GridLayout::calculateBlocks()
+void GridLayout::placeCells()
 {
     numCols_ = 0;
     numRows_ = 0;
 
+    // columns taken in each row,a row only grows as far as its cells reach
+    std::vector<std::vector<bool> > taken;
+
     uint32_t nextCol = 0;
     uint32_t nextRow = 0;
 
-    blockMap_.clear();
-
-    std::list<Cell>::iterator it;
-    for(it = cells_.begin(); it != cells_.end(); ++it)
+    for(size_t i = 0; i < cells_.size(); ++i)
     {
-        const GridCellInfo& info = (*it).info_;
+        Cell& cell = cells_[i];
+        const GridCellInfo& info = cell.info_;
 
         if(info.columnIndex_ != GridCellInfo::relativeToPrevious )
             nextCol = info.columnIndex_;
@@ -262,50 +186,47 @@ void GridLayout::calculateBlocks()
         if(info.rowIndex_ != GridCellInfo::relativeToPrevious)
             nextRow = info.rowIndex_;
 
-        while(blockMap_.find(nextRow*256 + nextCol) != blockMap_.end())
-            ++nextCol;
+        const uint32_t hSpan = std::max(info.horizontalSpan_,1u);
+        const uint32_t vSpan = std::max(info.verticalSpan_,1u);
+
+        if(taken.size() < nextRow + vSpan)
+            taken.resize(nextRow + vSpan);
 
-        uint32_t hSpan = info.horizontalSpan_;
-        uint32_t vSpan = info.verticalSpan_;
+        while(nextCol < taken[nextRow].size() && taken[nextRow][nextCol])
+            ++nextCol;
 
-        for(uint32_t i = 0; i != hSpan; ++i )
+        for(uint32_t row = nextRow; row != nextRow + vSpan; ++row)
         {
-            for(uint32_t j = 0; j != vSpan; ++j )
-            {
-                Block block;
-                block.windowStart = ( i == 0 && j == 0 );
-                block.col = nextCol + i;
-                block.row = nextRow + j;
-                block.hSpan = hSpan;
-                block.vSpan = vSpan;
-                block.hSpace = spacing();
-                block.vSpace = spacing();
-                block.window = (*it).window_;
-                addBlockToMap(block);
-            }
+            std::vector<bool>& columns = taken[row];
+            if(columns.size() < nextCol + hSpan)
+                columns.resize(nextCol + hSpan,false);
+            std::fill(columns.begin() + nextCol,columns.begin() + nextCol + hSpan,true);
         }
 
+        cell.column_ = nextCol;
+        cell.row_ = nextRow;
+
         if(nextCol + hSpan > numCols_)
             numCols_ = nextCol + hSpan;
         if(nextRow + vSpan > numRows_)
             numRows_ = nextRow + vSpan;
         nextCol += hSpan;
     }
+    isPlaced_ = true;
 }
 
-void GridLayout::parseItemNode(TiXmlElement* item)
+void GridLayout::parseItemNode(const PropertyNode& item)
 {
 	if(item)
 	{
-		TiXmlElement* windowNode = item->FirstChildElement("window");
+		PropertyNode windowNode = item.firstChild("window");
 		Window* window = parse(windowNode);
 
-		TiXmlElement* infoNode = item->FirstChildElement("info");
+		PropertyNode infoNode = item.firstChild("info");
 		GridCellInfo cellinfo;
 		if(infoNode)
 		{
-			std::string classname = infoNode->Attribute("class");
-			Rtti* rtti = Rtti::rttiByObjectName(classname);
+			Rtti* rtti = infoNode.rtti();
 			if(rtti)
 			{
 				LayoutInfo* info = Object::castTo<LayoutInfo>(rtti->createObject());
@@ -322,7 +243,7 @@ void GridLayout::parseItemNode(TiXmlElement* item)
 	}
 }
 
-bool GridLayout::loadProperty(TiXmlNode* node)
+bool GridLayout::loadProperty(const PropertyNode& node)
 {
 	numCols_ = 0;
 	numRows_ = 0;
@@ -338,14 +259,14 @@ bool GridLayout::loadProperty(TiXmlNode* node)
 	//DESERIALIZE_OBJECT(numCols,node,uint32_t)
 	//DESERIALIZE_OBJECT(numRows,node,uint32_t)
 
-    TiXmlElement* child = node->FirstChildElement("windows");
-	child = child->FirstChildElement("item");
+    PropertyNode child = node.firstChild("windows");
+	child = child.firstChild("item");
     while(child)
     {
         parseItemNode(child);
-		child = child->NextSiblingElement();
+		child = child.nextSibling();
     }
-    TiXmlNode* layout = node->FirstChildElement("Layout");
+    PropertyNode layout = node.firstChild("Layout");
     Layout::loadProperty(layout);
     return false;
 }
@@ -396,13 +317,13 @@ GridCellInfo::GridCellInfo():
 {
 }
 
-bool GridCellInfo::loadProperty(TiXmlNode* node)
+bool GridCellInfo::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(horizontalSpan,node,uint32_t)
     DESERIALIZE_OBJECT(verticalSpan,node,uint32_t)
     DESERIALIZE_OBJECT(columnIndex,node,uint32_t)
     DESERIALIZE_OBJECT(rowIndex,node,uint32_t)
-    TiXmlNode* window = node->FirstChildElement("LayoutInfo");
+    PropertyNode window = node.firstChild("LayoutInfo");
     LayoutInfo::loadProperty(window);
     return true;
 }
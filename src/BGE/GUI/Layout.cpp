@@ -1,6 +1,7 @@
 #include <BGE/System/Err.h>
 #include <BGE/GUI/Layout.h>
 #include <BGE/GUI/Window.h>
+#include <BGE/GUI/Panel.h>
 #include <algorithm>
 
 namespace bge
@@ -11,7 +12,8 @@ IMPLEMENT_OBJECT(Layout,Object)
 
 Layout::Layout(Window* parent):
     Object(parent),
-    spacing_(4.0f)
+    spacing_(4.0f),
+    revision_(0)
 {
 }
 
@@ -19,10 +21,29 @@ Layout::~Layout()
 {
 }
 
-Window* Layout::parse(TiXmlElement* element)
+Layout& Layout::translateWithin(const Vector2f& offset)
 {
-	std::string classname = element->Attribute("class");
-	Rtti* rtti = Rtti::rttiByObjectName(classname);
+    for(size_t i = 0;i < windows_.size();i++)
+        windows_[i]->setPosition(windows_[i]->position() + offset);
+    return *this;
+}
+
+void Layout::changed()
+{
+    revision_ ++;
+    Panel* panel = Object::castTo<Panel>(parent());
+    if(panel)
+        panel->invalidateLayout();
+}
+
+void Layout::eraseWindow(Window* window)
+{
+    windows_.erase(std::remove(windows_.begin(),windows_.end(),window),windows_.end());
+}
+
+Window* Layout::parse(const PropertyNode& element)
+{
+	Rtti* rtti = element.rtti();
 	if(rtti)
 	{
 		Object* object = rtti->createObject();
@@ -33,7 +54,7 @@ Window* Layout::parse(TiXmlElement* element)
 			return window;
 		}
 		else
-			err()<<"create class:"<<classname<<" failed\n";
+			err()<<"create class:"<<element.attribute("class")<<" failed\n";
 	}
 	return NULL;
 }
@@ -45,7 +66,7 @@ bool Layout::saveProperty(TiXmlNode* node)
     return true;
 }
 
-bool Layout::loadProperty(TiXmlNode* node)
+bool Layout::loadProperty(const PropertyNode& node)
 {
 	DESERIALIZE_OBJECT(spacing,node,float)
 	Object::loadProperty(node);
@@ -14,6 +14,7 @@ ListBox::ListBox(Window* parent,const FloatRect& rect):
     ListWindow(parent,rect),
     renderDesc_(0)
 {
+    setModel(&strings_);
     setSize(rect.size());
     setPosition(rect.position());
 }
@@ -24,68 +25,36 @@ ListBox::~ListBox()
 
 ListBox& ListBox::addString(const String& string)
 {
-    strings_.push_back(string);
-    onContentsChanged();
+    strings_.append(string);
     return *this;
 }
 
-ListBox& ListBox::removeStringAt(uint32_t pos)
+ListBox& ListBox::removeStringAt(size_t pos)
 {
-    if(selectedIndex() == pos)
-        select(-1);
-    if(pos < numberOfStrings())
-    {
-        Strings::iterator it = strings_.begin();
-        std::advance(it, pos);
-        strings_.erase(it);
-    }
-
-    onContentsChanged();
+    strings_.remove(pos);
     return *this;
 }
 
 ListBox& ListBox::removeAllStrings()
 {
-    select(-1);
     strings_.clear();
-    onContentsChanged();
     return *this;
 }
 
-String ListBox::stringAt(uint32_t position)const
+String ListBox::stringAt(size_t position)const
 {
-    String ret;
-    if(position < numberOfStrings())
-    {
-        Strings::const_iterator it = strings_.begin();
-        std::advance(it, position);
-        ret = *it;
-    }
-    return ret;
+    return model() ? model()->data(position,0) : String();
 }
 
 bool ListBox::contains(const String& string) const
 {
-    return ( std::find(strings_.begin(), strings_.end(),string) != strings_.end() );
+    return strings_.find(string) != StringListModel::npos;
 }
 
 int ListBox::indexOf(const String& string) const
 {
-    int ret = -1;
-    if(numberOfStrings() > 0)
-    {
-        ret = 0;
-        for(Strings::const_iterator it = strings_.begin(); it != strings_.end(); ++it)
-        {
-            if((*it) == string)
-                break;
-            ++ret;
-        }
-    }
-    if(ret >= numberOfStrings())
-        ret = -1;
-
-    return ret;
+    const size_t ret = strings_.find(string);
+    return ret == StringListModel::npos ? -1 : int(ret);
 }
 
 Window& ListBox::onDraw()
@@ -111,17 +80,24 @@ float ListBox::entryHeight() const
 
 WINDOW_LOAD_APPAREARANCE(ListBox)
 
-bool ListBox::loadProperty(TiXmlNode* node)
+bool ListBox::loadProperty(const PropertyNode& node)
 {
-    DESERIALIZE_OBJECT_CONTAINER(strings,node,std::list<String>,String)
-    TiXmlNode* window = node->FirstChildElement("ListWindow");
+    const std::vector<String> strings = deserializeContainer<std::vector<String>,String>("strings",node);
+    strings_.clear();
+    strings_.reserve(strings.size());
+    for(size_t i = 0;i < strings.size();i++)
+        strings_.append(strings[i]);
+    PropertyNode window = node.firstChild("ListWindow");
     ListWindow::loadProperty(window);
     return true;
 }
 
 bool ListBox::saveProperty(TiXmlNode* node)
 {
-    SERIALIZE_CONTAINER(strings,node)
+    std::vector<String> strings(strings_.count());
+    for(size_t i = 0;i < strings.size();i++)
+        strings[i] = strings_.at(i,0);
+    serializeContainer(NameObject(strings,"strings"),node);
     TiXmlElement element("ListWindow");
     ListWindow::saveProperty(&element);
     node->InsertEndChild(element);
@@ -131,9 +107,9 @@ bool ListBox::saveProperty(TiXmlNode* node)
 void ListBoxDesc::drawRow(size_t row, const FloatRect& rectangle)const
 {
     Canvas* canvas = WindowManager::instance().canvas();
-    ListBox* listBox = dynamic_cast<ListBox*>(listWindow_);
+    const ListWindow* listBox = listWindow_;
 
-    textDesc_->setText(listBox->stringAt(row));
+    textDesc_->setText(listBox->model()->data(row,0));
 
     FloatRect textRectangle = rectangle;
     textRectangle.translate(Vector2f(2.0f, 0.0f));
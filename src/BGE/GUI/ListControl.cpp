@@ -14,6 +14,7 @@ IMPLEMENT_OBJECT_CREATE(ListControl,ListWindow)
 
 ListControl::ListControl(Window* parent,const FloatRect& rect,uint32_t numColumns):
     ListWindow(parent, rect),
+    rows_(numColumns),
     usingDefaultWidths_(true),
     renderDesc_(0)
 {
@@ -22,6 +23,7 @@ ListControl::ListControl(Window* parent,const FloatRect& rect,uint32_t numColumn
     {
         columnWidths_[i] = 1;
     }
+    setModel(&rows_);
 
     setPosition(rect.position());
     setSize(rect.size());
@@ -34,31 +36,13 @@ ListControl::~ListControl()
 ListControl& ListControl::addRow(const std::vector<String>& strings)
 {
     //ASSERT ( strings.size() <= numberOfColumns() );
-
-    Row newRow(*this);
-    for(unsigned i = 0; i < strings.size(); ++i)
-    {
-        newRow.setEntry(i, strings[i]);
-    }
-
-    rows_.push_back(newRow);
-    onContentsChanged();
+    rows_.append(strings.empty() ? 0 : &strings[0],strings.size());
     return *this;
 }
 
 ListControl& ListControl::removeRowAt(uint32_t pos)
 {
-    Rows::iterator it;
-    uint32_t counter = 0;
-    for(it = rows_.begin(); it != rows_.end(); ++it)
-    {
-        if(counter == pos) break;
-        counter++;
-    }
-
-    if(counter < numberOfRows())
-        rows_.erase(it);
-    onContentsChanged();
+    rows_.remove(pos);
     return *this;
 }
 
@@ -133,13 +117,12 @@ float ListControl::entryHeight() const
     return renderDesc->textDesc().lineHeight();
 }
 
-const ListControl::Row& ListControl::rowAt(uint32_t pos)const
+ListControl::Row ListControl::rowAt(uint32_t pos)const
 {
     if(pos >= numberOfRows())
         err() << "tried to access the row of a ListControl with an invalid index\n";
-    Rows::const_iterator it = rows_.begin();
-    std::advance(it,pos);
-    return *it;
+    const ListModel* shown = model() ? model() : &rows_;
+    return Row(*shown,pos);
 }
 
 void ListControl::onResize()
@@ -150,12 +133,14 @@ void ListControl::onResize()
 
 WINDOW_LOAD_APPAREARANCE(ListControl)
 
-bool ListControl::loadProperty(TiXmlNode* node)
+bool ListControl::loadProperty(const PropertyNode& node)
 {
     //DESERIALIZE_OBJECT_CONTAINER(strings,node,std::list<String>,String)
     DESERIALIZE_OBJECT(usingDefaultWidths,node,float)
     DESERIALIZE_OBJECT_CONTAINER(columnWidths,node,std::vector<float>,float)
-    TiXmlNode* window = node->FirstChildElement("ListWindow");
+    if(rows_.columns() != columnWidths_.size())
+        rows_.setColumns(columnWidths_.size());
+    PropertyNode window = node.firstChild("ListWindow");
     ListWindow::loadProperty(window);
     return true;
 }
@@ -181,14 +166,14 @@ ListControlDesc::~ListControlDesc()
 {
 }
 
-bool ListControlDesc::loadProperty(TiXmlNode* node)
+bool ListControlDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("ListControlDesc");
+	PropertyNode thisNode = node.firstChild("ListControlDesc");
 	if(thisNode)
 	{
 		DESERIALIZE_OBJECT(separatorWidth,thisNode,float)
 		DESERIALIZE_OBJECT(separatorColor,thisNode,Color)
-		TiXmlNode* desc = thisNode->FirstChildElement("ListWindowDesc");
+		PropertyNode desc = thisNode.firstChild("ListWindowDesc");
 		ListWindowDesc::loadProperty(desc);
 	}
 	return true;
@@ -227,9 +212,8 @@ void ListControlDesc::draw(const FloatRect& area,Canvas* canvas) const
 
 void ListControlDesc::drawRow(size_t aRowIndex, const FloatRect& aRowRectangle) const
 {
-    ListControl* listControl = dynamic_cast<ListControl*>(listWindow_);
-
-    const ListControl::Row& row = listControl->rowAt(aRowIndex);
+    ListControl* listControl = static_cast<ListControl*>(listWindow_);
+    const ListModel& model = *listControl->model();
 
     FloatRect textRectangle = aRowRectangle;
     textRectangle.translate(Vector2f(2.0f, 0.0f));
@@ -260,7 +244,7 @@ void ListControlDesc::drawRow(size_t aRowIndex, const FloatRect& aRowRectangle)
         for(unsigned j = 0; j < listControl->numberOfColumns(); ++j)
         {
             (*textDesc_)
-                .setText(row.stringAt(j))
+                .setText(model.data(aRowIndex,j))
                 .draw(textRectangle,canvas)
                 ;
             textRectangle.translate(Vector2f(listControl->columnWidth(j), 0.0f));
@@ -272,7 +256,7 @@ void ListControlDesc::drawRow(size_t aRowIndex, const FloatRect& aRowRectangle)
         for(unsigned j = 0; j < listControl->numberOfColumns(); ++j)
         {
             (*textDesc_)
-                .setText(row.stringAt(j))
+                .setText(model.data(aRowIndex,j))
                 .draw(textRectangle,WindowManager::instance().canvas())
                 ;
             textRectangle.translate(Vector2f(listControl->columnWidth(j), 0.0f));
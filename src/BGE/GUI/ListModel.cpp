@@ -0,0 +1,89 @@
+#include <BGE/GUI/ListModel.h>
+#include <algorithm>
+
+namespace bge
+{
+
+StringListModel::StringListModel(size_t columns):
+    columns_(columns > 0 ? columns : 1)
+{
+}
+
+String StringListModel::data(size_t row,size_t column)const
+{
+    if(row >= count() || column >= columns_)
+        return String();
+    return at(row,column);
+}
+
+StringListModel& StringListModel::setColumns(size_t columns)
+{
+    columns_ = columns > 0 ? columns : 1;
+    strings_.clear();
+    modelReset();
+    return *this;
+}
+
+StringListModel& StringListModel::reserve(size_t rows)
+{
+    strings_.reserve(rows * columns_);
+    return *this;
+}
+
+StringListModel& StringListModel::append(const String* strings,size_t count)
+{
+    return insert(this->count(),strings,count);
+}
+
+StringListModel& StringListModel::insert(size_t row,const String* strings,size_t count)
+{
+    if(row > this->count())
+        row = this->count();
+
+    const size_t used = std::min(count,columns_);
+    std::vector<String>::iterator position = strings_.insert(strings_.begin() + row * columns_,columns_,String());
+    std::copy(strings,strings + used,position);
+    rowsInserted(row,1);
+    return *this;
+}
+
+StringListModel& StringListModel::remove(size_t row,size_t count)
+{
+    if(row >= this->count())
+        return *this;
+
+    count = std::min(count,this->count() - row);
+    strings_.erase(strings_.begin() + row * columns_,strings_.begin() + (row + count) * columns_);
+    rowsRemoved(row,count);
+    return *this;
+}
+
+StringListModel& StringListModel::set(size_t row,size_t column,const String& string)
+{
+    if(row < count() && column < columns_)
+    {
+        strings_[row * columns_ + column] = string;
+        rowsChanged(row,1);
+    }
+    return *this;
+}
+
+StringListModel& StringListModel::clear()
+{
+    strings_.clear();
+    modelReset();
+    return *this;
+}
+
+size_t StringListModel::find(const String& string,size_t column)const
+{
+    if(column >= columns_)
+        return npos;
+
+    for(size_t i = column;i < strings_.size();i += columns_)
+        if(strings_[i] == string)
+            return i / columns_;
+    return npos;
+}
+
+}
@@ -3,8 +3,10 @@
 #include <BGE/Graphics/RenderDesc.h>
 #include <BGE/GUI/Message.h>
 #include <BGE/GUI/ListWindow.h>
+#include <BGE/GUI/ListModel.h>
 #include <BGE/GUI/WindowManager.h>
 #include <BGE/GUI/ScrollBar.h>
+#include <algorithm>
 
 namespace bge
 {
@@ -28,6 +30,7 @@ IMPLEMENT_OBJECT(ListWindow,Window)
 
 ListWindow::ListWindow(Window* parent,const FloatRect& rect):
     Window(parent),
+    model_(0),
     selectedIndex_(-1),
     highlightedIndex_(-1),
     lineHeightFactor_(1.325f)
@@ -52,12 +55,16 @@ ListWindow::~ListWindow()
     delete verticalScrollBar_;
 }
 
-void ListWindow::deleteLater()
+void ListWindow::destroy()
 {
     removeMessageListener(listWindowMouseListener_);
     delete listWindowMouseListener_;
-    delete verticalScrollBar_;
-	Window::deleteLater();
+    listWindowMouseListener_ = 0;
+    // the destructor would delete the scroll bar a second time
+    verticalScrollBar_->remove();
+    verticalScrollBar_->deleteLater();
+    verticalScrollBar_ = 0;
+	Window::destroy();
 }
 
 bool ListWindow::process(const Message& message)
@@ -85,10 +92,17 @@ ListWindow& ListWindow::positionScrollBar()
 
 uint32_t ListWindow::firstVisibleEntry() const
 {
-    float ret = 0.5f + (float(verticalScrollBar_->value()) - (float(lineHeight()) * 0.5f)) / float(lineHeight());
+    // double keeps the row exact for long lists,float loses it beyond 2^24 pixels of contents
+    double ret = 0.5 + (double(verticalScrollBar_->value()) - (double(lineHeight()) * 0.5)) / double(lineHeight());
     if(ret < 0.0)
         ret = 0.0;
-    return ret;
+    return uint32_t(ret);
+}
+
+ListWindow& ListWindow::scrollTo(size_t entry)
+{
+    verticalScrollBar_->setValue(static_cast<int>(double(entry) * double(lineHeight())));
+    return *this;
 }
 
 uint32_t ListWindow::entryIndexAt(const Vector2f& p) const
@@ -139,6 +153,82 @@ void ListWindow::onMove()
     positionScrollBar();
 }
 
+size_t ListWindow::numberOfEntries() const
+{
+    return model_ ? model_->count() : 0;
+}
+
+ListWindow& ListWindow::setModel(ListModel* model)
+{
+    if(model_ == model)
+        return *this;
+
+    if(model_)
+    {
+        model_->rowsInserted.disconnect(this);
+        model_->rowsRemoved.disconnect(this);
+        model_->rowsChanged.disconnect(this);
+        model_->modelReset.disconnect(this);
+    }
+
+    model_ = model;
+    if(model_)
+    {
+        model_->rowsInserted.connect(this,&ListWindow::onRowsInserted);
+        model_->rowsRemoved.connect(this,&ListWindow::onRowsRemoved);
+        model_->rowsChanged.connect(this,&ListWindow::onRowsChanged);
+        model_->modelReset.connect(this,&ListWindow::onModelReset);
+    }
+    onModelReset();
+    return *this;
+}
+
+void ListWindow::onRowsInserted(size_t row,size_t count)
+{
+    if(selectedIndex_ >= 0 && size_t(selectedIndex_) >= row)
+        selectedIndex_ += int(count);
+    highlightedIndex_ = -1;
+    onContentsChanged();
+    update();
+}
+
+void ListWindow::onRowsRemoved(size_t row,size_t count)
+{
+    if(selectedIndex_ >= 0 && size_t(selectedIndex_) >= row)
+    {
+        if(size_t(selectedIndex_) < row + count)
+            select(-1);
+        else
+            selectedIndex_ -= int(count);
+    }
+    highlightedIndex_ = -1;
+    onContentsChanged();
+    update();
+}
+
+void ListWindow::onRowsChanged(size_t row,size_t count)
+{
+    // only the changed rows which are visible are drawn again
+    const size_t topRow = firstVisibleEntry();
+    const float height = lineHeight();
+    const size_t first = std::max(row,topRow);
+    const size_t last = std::min(row + count,topRow + static_cast<size_t>(size().y() / height) + 1);
+    if(first >= last)
+        return;
+
+    const float top = position().y() + static_cast<float>(first - topRow) * height;
+    WindowManager::instance().invalidate(FloatRect(position().x(),top,size().x(),static_cast<float>(last - first) * height));
+}
+
+void ListWindow::onModelReset()
+{
+    if(selectedIndex_ >= 0)
+        select(-1);
+    highlightedIndex_ = -1;
+    onContentsChanged();
+    update();
+}
+
 float ListWindow::heightOfAllContents() const
 {
     const float numStrings = (numberOfEntries() > 0) ? static_cast<float>(numberOfEntries()-1) : 0.0f;
@@ -273,9 +363,9 @@ ListWindowDesc::~ListWindowDesc()
     delete textDesc_;
 }
 
-bool ListWindowDesc::loadProperty(TiXmlNode* node)
+bool ListWindowDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("ListWindowDesc");
+	PropertyNode thisNode = node.firstChild("ListWindowDesc");
 	if(thisNode)
 	{
 		CREATE_BY_NODE(background,thisNode,RenderDesc)
@@ -285,7 +375,7 @@ bool ListWindowDesc::loadProperty(TiXmlNode* node)
 		DESERIALIZE_OBJECT(selectedTextColor,thisNode,Color)
 		DESERIALIZE_OBJECT(highlightColor,thisNode,Color)
 		DESERIALIZE_OBJECT(highlightedTextColor,thisNode,Color)
-		TiXmlNode* desc = thisNode->FirstChildElement("RenderDesc");
+		PropertyNode desc = thisNode.firstChild("RenderDesc");
 		RenderDesc::loadProperty(desc);
 	}
 	return true;
@@ -347,12 +437,12 @@ void ListWindowDesc::draw(const FloatRect& area,Canvas* canvas)const
     canvas->setColor(Color(1, 1, 1, 1));
 }
 
-bool ListWindow::loadProperty(TiXmlNode* node)
+bool ListWindow::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(selectedIndex,node,int)
     DESERIALIZE_OBJECT(highlightedIndex,node,int)
     DESERIALIZE_OBJECT(lineHeightFactor,node,float)
-    TiXmlNode* window = node->FirstChildElement("Window");
+    PropertyNode window = node.firstChild("Window");
     Window::loadProperty(window);
     return true;
 }
@@ -67,13 +67,6 @@ MultiTextButton::~MultiTextButton()
     delete mtButtonMouseListener_;
 }
 
-void MultiTextButton::deleteLater()
-{
-    removeMessageListener(mtButtonMouseListener_);
-    delete mtButtonMouseListener_;
-	BasicButton::deleteLater();
-}
-
 MultiTextButton& MultiTextButton::onPressedLeft()
 {
     if(numberOfStrings() == 0)
@@ -113,10 +106,10 @@ Window& MultiTextButton::onDraw()
     return *this;
 }
 
-bool MultiTextButton::loadProperty(TiXmlNode* node)
+bool MultiTextButton::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT_CONTAINER(strings,node,std::list<String>,String)
-    TiXmlNode* window = node->FirstChildElement("BasicButton");
+    PropertyNode window = node.firstChild("BasicButton");
     BasicButton::loadProperty(window);
     return true;
 }
@@ -3,6 +3,7 @@
 #include <BGE/GUI/BasicButton.h>
 #include <BGE/GUI/WindowManager.h>
 #include <BGE/GUI/PropertyScheme.h>
+#include <BGE/GUI/SpatialGrid.h>
 
 namespace bge
 {
@@ -13,19 +14,41 @@ Panel::Panel(const FloatRect& rect,Window* parent,const String& text):
     Window(parent,text),
     layouter_(0),
 	buttonGroup_(0),
-    renderDesc_(0)
+    renderDesc_(0),
+    grid_(0),
+    gridRevision_(0),
+    isGridValid_(false),
+    isLayoutScheduled_(false)
 {
     setGeometry(rect);
 }
 
 Panel::~Panel()
 {
+    WindowManager::instance().cancelLayout(this);
+    delete grid_;
 }
 
 Panel& Panel::arrangeChildren()
 {
+    isLayoutScheduled_ = false;
+    layoutPosition_ = position();
+    layoutSize_ = geometry().size();
     if(layouter_)
+    {
         layouter_->arrangeWithin();
+        WindowManager::instance().countLayout(true);
+    }
+    return *this;
+}
+
+Panel& Panel::invalidateLayout()
+{
+    if(layouter_ && !isLayoutScheduled_)
+    {
+        isLayoutScheduled_ = true;
+        WindowManager::instance().scheduleLayout(this);
+    }
     return *this;
 }
 
@@ -34,12 +57,13 @@ bool Panel::process(const Message& message)
     bool ret = false;
     if(layouter_)
     {
-        std::list<Window*> list = layouter_->windows();
+        // indexed,a child may remove windows from the layout while it processes the message
+        const std::vector<Window*>& list = layouter_->windows();
         if(isVisible() && isEnabled())
         {
-            for(auto it = list.begin();it != list.end(); ++it)
+            for(size_t i = 0;i < list.size();i++)
             {
-                Window* window = *it;
+                Window* window = list[i];
                 ret = window->process(message);
                 if(ret)
                     break;
@@ -57,7 +81,7 @@ bool Panel::doesHierarchyContain(Window* target) const
     bool ret = false;
     if(layouter_)
     {
-        std::list<Window*> list = layouter_->windows();
+        const std::vector<Window*>& list = layouter_->windows();
         for(auto it = list.begin();it != list.end(); ++it)
         {
             Window* window = *it;
@@ -86,11 +110,9 @@ Window& Panel::onDraw()
 
     if(layouter_)
     {
-        std::list<Window*> list = layouter_->windows();
-        for(auto it = list.begin(); it != list.end(); ++it)
-        {
-            (*it)->render();
-        }
+        const std::vector<Window*>& list = layouter_->windows();
+        for(size_t i = 0;i < list.size();i++)
+            list[i]->render();
     }
     return *this;
 }
@@ -101,29 +123,57 @@ Window* Panel::windowBelow(const Vector2f& p)
 
     if(ret != 0 && layouter_)
     {
-        std::list<Window*> list = layouter_->windows();
-        for(auto it = list.begin(); it != list.end(); ++it)
-        {
-            Window* window = *it;
-            Window* cw = window->windowBelow(p);
-            if(cw != 0)
-            {
-                ret = cw;
-                break;
-            }
-        }
+        Window* cw = childGrid()->windowBelow(p);
+        if(cw != 0)
+            ret = cw;
     }
     return ret;
 }
 
+SpatialGrid* Panel::childGrid()
+{
+    if(grid_ == 0)
+        grid_ = new SpatialGrid();
+
+    if(!isGridValid_ || gridRevision_ != layouter_->revision())
+    {
+        const std::vector<Window*>& list = layouter_->windows();
+        grid_->reset(geometry(),list.size());
+        for(auto it = list.begin(); it != list.end(); ++it)
+            grid_->insert(*it);
+
+        gridRevision_ = layouter_->revision();
+        isGridValid_ = true;
+    }
+    return grid_;
+}
+
+void Panel::onChildGeometryChanged(Window* child)
+{
+    if(isGridValid_)
+        grid_->update(child);
+}
+
 void Panel::onResize()
 {
-    arrangeChildren();
+    if(isGridValid_ && !grid_->fits(size()))
+        isGridValid_ = false;
+    if(geometry().size() != layoutSize_)
+        invalidateLayout();
 }
 
 void Panel::onMove()
 {
-    arrangeChildren();
+    const Vector2f offset = position() - layoutPosition_;
+    layoutPosition_ = position();
+    if(layouter_ && offset != Vector2f())
+    {
+        // the children move by the same offset,they stay in their cells
+        if(isGridValid_)
+            grid_->translate(offset);
+        layouter_->translateWithin(offset);
+        WindowManager::instance().countLayout(false);
+    }
 }
 
 Panel& Panel::setLayout(Layout* layouter)
@@ -134,13 +184,15 @@ Panel& Panel::setLayout(Layout* layouter)
     {
         layouter_ = layouter;
         layouter_->setParent(this);
+        isGridValid_ = false;
+        invalidateLayout();
     }
     return *this;
 }
 
 WINDOW_LOAD_APPAREARANCE(Panel)
 
-bool Panel::loadProperty(TiXmlNode* node)
+bool Panel::loadProperty(const PropertyNode& node)
 {
 	if(buttonGroup_)
 		buttonGroup_->deleteLater();
@@ -149,34 +201,30 @@ bool Panel::loadProperty(TiXmlNode* node)
 	if(layouter_)
 		layouter_->deleteLater();
 	layouter_ = NULL;
+	isGridValid_ = false;
 
-	TiXmlElement* groupNode = node->FirstChildElement("buttongroup");
+	PropertyNode groupNode = node.firstChild("buttongroup");
 	if(groupNode)
 	{
-		std::string classname = groupNode->Attribute("class");
-		Rtti* rtti = Rtti::rttiByObjectName(classname);
+		Rtti* rtti = groupNode.rtti();
 		if(rtti)
 		{
 			Object* object = rtti->createObject();
 			buttonGroup_ = Object::castTo<ButtonGroup>(object);
 			if(buttonGroup_)
 			{
-				buttonGroup_->setName(groupNode->Attribute("name"));
+				buttonGroup_->setName(groupNode.attribute("name"));
 				buttonGroup_->setParent(this);
 			}
 			else
-				err()<<"create class:"<<classname<<" failed\n";
+				err()<<"create class:"<<groupNode.attribute("class")<<" failed\n";
 		}
 	}
 
-    TiXmlElement* layout = node->FirstChildElement("Layout");
+    PropertyNode layout = node.firstChild("Layout");
     if(layout)
     {
-        const char* tag = layout->Attribute("class");
-		std::string classname;
-		if(tag)
-			classname = tag;
-		Rtti* rtti = Rtti::rttiByObjectName(classname);
+		Rtti* rtti = layout.rtti();
 		if(!rtti)
 			return false;
         Object* object = rtti->createObject();
@@ -188,11 +236,11 @@ bool Panel::loadProperty(TiXmlNode* node)
 		{
 			setLayout(layouter_);
 			layouter_->loadProperty(layout);
-			layouter_->arrangeWithin();
+			arrangeChildren();
 		}
 	}
 
-    TiXmlNode* window = node->FirstChildElement("Window");
+    PropertyNode window = node.firstChild("Window");
     Window::loadProperty(window);
     return true;
 }
@@ -231,14 +279,14 @@ void PanelDesc::draw(const FloatRect& area,Canvas* canvas) const
         border_->draw(area,canvas);
 }
 
-bool PanelDesc::loadProperty(TiXmlNode* node)
+bool PanelDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlNode* thisNode = node->FirstChildElement("PanelDesc");
+	PropertyNode thisNode = node.firstChild("PanelDesc");
 	if(thisNode)
 	{
 		CREATE_BY_NODE(background,thisNode,RenderDesc)
 		CREATE_BY_NODE(border,thisNode,RenderDesc)
-		TiXmlNode* desc = thisNode->FirstChildElement("RenderDesc");
+		PropertyNode desc = thisNode.firstChild("RenderDesc");
 		if(desc)
 			RenderDesc::loadProperty(desc);
 	}
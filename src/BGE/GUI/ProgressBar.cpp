@@ -43,11 +43,11 @@ Window& ProgressBar::onDraw()
 
 WINDOW_LOAD_APPAREARANCE(ProgressBar)
 
-bool ProgressBar::loadProperty(TiXmlNode* node)
+bool ProgressBar::loadProperty(const PropertyNode& node)
 {
     //DESERIALIZE_OBJECT(orientation,node,Orientation)
     DESERIALIZE_OBJECT(percentage,node,float)
-    TiXmlNode* window = node->FirstChildElement("Window");
+    PropertyNode window = node.firstChild("Window");
     Window::loadProperty(window);
     return true;
 }
@@ -143,16 +143,16 @@ void ProgressBarDesc::draw(const FloatRect& area,Canvas* canvas) const
         border_->draw(area,WindowManager::instance().canvas());
 }
 
-bool ProgressBarDesc::loadProperty(TiXmlNode* node)
+bool ProgressBarDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("ProgressBarDesc");
+	PropertyNode thisNode = node.firstChild("ProgressBarDesc");
 	if(thisNode)
 	{
 		CREATE_BY_NODE(horzEmptyDesc,thisNode,RenderDesc)
 		CREATE_BY_NODE(horzFullDesc,thisNode,RenderDesc)
 		CREATE_BY_NODE(vertEmptyDesc,thisNode,RenderDesc)
 		CREATE_BY_NODE(border,thisNode,RenderDesc)
-		TiXmlNode* window = thisNode->FirstChildElement("RenderDesc");
+		PropertyNode window = thisNode.firstChild("RenderDesc");
 		RenderDesc::loadProperty(window);
 	}
 	return true;
@@ -15,6 +15,9 @@ class ScrollBarButtonListener;
 class ScrollBarSlider : public Button, public MouseListener, NonCopyable
 {
 public:
+    using Button::operator new;
+    using Button::operator delete;
+
     ScrollBarSlider(ScrollBar& scroll);
     virtual ~ScrollBarSlider(){}
 public:
@@ -110,14 +113,22 @@ ScrollBar::~ScrollBar()
     delete slider_;
 }
 
-void ScrollBar::deleteLater()
+void ScrollBar::destroy()
 {
     removeMessageListener(mouseListener_);
     delete mouseListener_;
+    mouseListener_ = 0;
+    // the buttons and the slider are children,they must be gone before the children are deleted
+    incrementButton_->remove();
+    decrementButton_->remove();
+    slider_->remove();
     delete incrementButton_;
     delete decrementButton_;
     delete slider_;
-	Slideable::deleteLater();
+    incrementButton_ = 0;
+    decrementButton_ = 0;
+    slider_ = 0;
+	Slideable::destroy();
 }
 
 bool ScrollBar::process(const Message& message)
@@ -223,11 +234,11 @@ void ScrollBar::incrementButtonPressed()
 
     if(!incrementTimer_.isStarted())
     {
-        incrementTimer_.setInterval(0.25f);
+        incrementTimer_.setInterval(250);
         incrementTimer_.start();
     }
     else
-        incrementTimer_.setInterval(0.05f);
+        incrementTimer_.setInterval(50);
 }
 
 void ScrollBar::decrementButtonPressed()
@@ -237,11 +248,11 @@ void ScrollBar::decrementButtonPressed()
 
     if(!decrementTimer_.isStarted())
     {
-        decrementTimer_.setInterval(0.25f);
+        decrementTimer_.setInterval(250);
         decrementTimer_.start();
     }
     else
-        decrementTimer_.setInterval(0.05f);
+        decrementTimer_.setInterval(50);
 }
 
 void ScrollBar::incrementButtonReleased()
@@ -316,12 +327,12 @@ Window& ScrollBar::onDraw()
 
 WINDOW_LOAD_APPAREARANCE(ScrollBar)
 
-bool ScrollBar::loadProperty(TiXmlNode* node)
+bool ScrollBar::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(justification,node)
     DESERIALIZE_OBJECT(visibleAmount,node)
     DESERIALIZE_OBJECT(trackColor,node)
-    TiXmlNode* window = node->FirstChildElement("Slideable");
+    PropertyNode window = node.firstChild("Slideable");
     Slideable::loadProperty(window);
     return true;
 }
@@ -516,14 +527,14 @@ ScrollBarDesc::~ScrollBarDesc()
     delete border_;
 }
 
-bool ScrollBarDesc::loadProperty(TiXmlNode* node)
+bool ScrollBarDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("ScrollBarDesc");
+	PropertyNode thisNode = node.firstChild("ScrollBarDesc");
 	if(thisNode)
 	{
 		CREATE_BY_NODE(background,thisNode,RenderDesc)
 		CREATE_BY_NODE(border,thisNode,RenderDesc)
-		TiXmlNode* window = thisNode->FirstChildElement("RenderDesc");
+		PropertyNode window = thisNode.firstChild("RenderDesc");
 		RenderDesc::loadProperty(window);
 	}
 	return true;
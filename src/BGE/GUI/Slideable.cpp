@@ -62,14 +62,14 @@ Slideable& Slideable::setMinimum(int newValue)
     return *this;
 }
 
-bool Slideable::loadProperty(TiXmlNode* node)
+bool Slideable::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(value,node,int)
     DESERIALIZE_OBJECT(minimum,node,int)
     DESERIALIZE_OBJECT(maximum,node,int)
     DESERIALIZE_OBJECT(blockIncrement,node,int)
     DESERIALIZE_OBJECT(unitIncrement,node,int)
-    TiXmlNode* window = node->FirstChildElement("Window");
+    PropertyNode window = node.firstChild("Window");
     Window::loadProperty(window);
     return true;
 }
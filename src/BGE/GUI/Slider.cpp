@@ -12,6 +12,8 @@ namespace bge
 class SliderButton : public Button, public MouseListener, NonCopyable
 {
 	DECLARE_OBJECT(SliderButton)
+    using Button::operator new;
+    using Button::operator delete;
 public:
     SliderButton(Slider* slider);
     ~SliderButton(){}
@@ -215,11 +217,11 @@ Window& Slider::onDraw()
 
 WINDOW_LOAD_APPAREARANCE(Slider)
 
-bool Slider::loadProperty(TiXmlNode* node)
+bool Slider::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(orientation,node,Orientation)
     DESERIALIZE_OBJECT(tickPlacement,node,TickPlacement)
-    TiXmlNode* window = node->FirstChildElement("Slideable");
+    PropertyNode window = node.firstChild("Slideable");
     Slideable::loadProperty(window);
     return true;
 }
@@ -234,12 +236,16 @@ bool Slider::saveProperty(TiXmlNode* node)
     return true;
 }
 
-void Slider::deleteLater()
+void Slider::destroy()
 {
+    // the button is a child,it must be gone before the children are deleted
+    button_->remove();
     delete button_;
+    button_ = 0;
     removeMessageListener(mouseListener_);
     delete mouseListener_;
-    Slideable::deleteLater();
+    mouseListener_ = 0;
+    Slideable::destroy();
 }
 
 SliderButton::SliderButton(Slider* slider):
@@ -345,16 +351,16 @@ void SliderDesc::draw(const FloatRect& area,Canvas* canvas)const
     if(border_ != 0)     border_->draw(area,canvas);
 }
 
-bool SliderDesc::loadProperty(TiXmlNode* node)
+bool SliderDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("SliderDesc");
+	PropertyNode thisNode = node.firstChild("SliderDesc");
 	if(thisNode)
 	{
 		CREATE_BY_NODE(background,thisNode,RenderDesc)
 		CREATE_BY_NODE(border,thisNode,RenderDesc)
 		DESERIALIZE_OBJECT(tickColor,thisNode,Color)
 		DESERIALIZE_OBJECT(tickWidth,thisNode,float)
-		TiXmlNode* desc = thisNode->FirstChildElement("RenderDesc");
+		PropertyNode desc = thisNode.firstChild("RenderDesc");
 		RenderDesc::loadProperty(desc);
 	}
 	return true;
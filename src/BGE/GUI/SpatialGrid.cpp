@@ -0,0 +1,160 @@
+#include <BGE/GUI/SpatialGrid.h>
+#include <BGE/GUI/Window.h>
+#include <algorithm>
+#include <cmath>
+
+namespace bge
+{
+
+static const int maximumCells = 256;
+
+SpatialGrid::SpatialGrid():
+    columns_(1),
+    rows_(1),
+    cellWidth_(1.0f),
+    cellHeight_(1.0f),
+    cells_(1)
+{
+}
+
+void SpatialGrid::reset(const FloatRect& bounds,size_t count)
+{
+    bounds_ = bounds;
+    entries_.clear();
+    indices_.clear();
+
+    // about two windows a cell,cells keep the aspect of the bounds
+    const float width = std::max(bounds.width_,1.0f);
+    const float height = std::max(bounds.height_,1.0f);
+    const float cells = std::max(static_cast<float>(count) * 0.5f,1.0f);
+    const float side = std::sqrt(width * height / cells);
+    columns_ = std::min(std::max(static_cast<int>(width / side),1),maximumCells);
+    rows_ = std::min(std::max(static_cast<int>(height / side),1),maximumCells);
+    cellWidth_ = width / columns_;
+    cellHeight_ = height / rows_;
+
+    cells_.resize(columns_ * rows_);
+    for(size_t i = 0;i < cells_.size();i++)
+        cells_[i].clear();
+}
+
+int SpatialGrid::column(float x)const
+{
+    const int ret = static_cast<int>(std::floor((x - bounds_.left_) / cellWidth_));
+    return std::min(std::max(ret,0),columns_ - 1);
+}
+
+int SpatialGrid::row(float y)const
+{
+    const int ret = static_cast<int>(std::floor((y - bounds_.top_) / cellHeight_));
+    return std::min(std::max(ret,0),rows_ - 1);
+}
+
+void SpatialGrid::cellRange(const FloatRect& bounds,Entry& entry)const
+{
+    entry.bounds_ = bounds;
+    entry.left_ = column(bounds.left_);
+    entry.top_ = row(bounds.top_);
+    entry.right_ = column(bounds.left_ + bounds.width_);
+    entry.bottom_ = row(bounds.top_ + bounds.height_);
+}
+
+void SpatialGrid::link(uint32_t index)
+{
+    const Entry& entry = entries_[index];
+    for(int y = entry.top_;y <= entry.bottom_;y++)
+    {
+        for(int x = entry.left_;x <= entry.right_;x++)
+        {
+            std::vector<uint32_t>& cell = cells_[y * columns_ + x];
+            cell.insert(std::lower_bound(cell.begin(),cell.end(),index),index);
+        }
+    }
+}
+
+void SpatialGrid::unlink(uint32_t index)
+{
+    const Entry& entry = entries_[index];
+    for(int y = entry.top_;y <= entry.bottom_;y++)
+    {
+        for(int x = entry.left_;x <= entry.right_;x++)
+        {
+            std::vector<uint32_t>& cell = cells_[y * columns_ + x];
+            std::vector<uint32_t>::iterator it = std::lower_bound(cell.begin(),cell.end(),index);
+            if(it != cell.end() && *it == index)
+                cell.erase(it);
+        }
+    }
+}
+
+void SpatialGrid::insert(Window* window)
+{
+    if(indices_.count(window))
+        return;
+
+    Entry entry;
+    entry.window_ = window;
+    cellRange(window->geometry(),entry);
+
+    const uint32_t index = static_cast<uint32_t>(entries_.size());
+    entries_.push_back(entry);
+    indices_[window] = index;
+    link(index);
+}
+
+void SpatialGrid::update(Window* window)
+{
+    std::unordered_map<Window*,uint32_t>::const_iterator it = indices_.find(window);
+    if(it == indices_.end())
+        return;
+
+    const uint32_t index = it->second;
+    Entry entry = entries_[index];
+    cellRange(window->geometry(),entry);
+
+    const Entry& current = entries_[index];
+    if(entry.left_ == current.left_ && entry.top_ == current.top_ && entry.right_ == current.right_ && entry.bottom_ == current.bottom_)
+    {
+        entries_[index].bounds_ = entry.bounds_;
+        return;
+    }
+
+    unlink(index);
+    entries_[index] = entry;
+    link(index);
+}
+
+void SpatialGrid::translate(const Vector2f& offset)
+{
+    bounds_.left_ += offset.x_;
+    bounds_.top_ += offset.y_;
+    for(size_t i = 0;i < entries_.size();i++)
+    {
+        entries_[i].bounds_.left_ += offset.x_;
+        entries_[i].bounds_.top_ += offset.y_;
+    }
+}
+
+bool SpatialGrid::fits(const Vector2f& size)const
+{
+    return size.x_ <= bounds_.width_ * 2.0f && size.x_ * 2.0f >= bounds_.width_ &&
+           size.y_ <= bounds_.height_ * 2.0f && size.y_ * 2.0f >= bounds_.height_;
+}
+
+Window* SpatialGrid::windowBelow(const Vector2f& point)const
+{
+    const std::vector<uint32_t>& cell = cells_[row(point.y_) * columns_ + column(point.x_)];
+    for(size_t i = 0;i < cell.size();i++)
+    {
+        const Entry& entry = entries_[cell[i]];
+        if(!entry.bounds_.contains(point))
+            continue;
+
+        Window* ret = entry.window_->windowBelow(point);
+        if(ret != 0)
+            return ret;
+    }
+    return 0;
+}
+
+}
@@ -0,0 +1,57 @@
+#ifndef BGE_GUI_SPATIALGRID_H
+#define BGE_GUI_SPATIALGRID_H
+#include <BGE/System/Math.h>
+#include <unordered_map>
+#include <vector>
+
+namespace bge
+{
+
+class Window;
+
+//! uniform grid over window rectangles used to hit-test many child windows,
+//! every cell lists the windows overlapping it in the order they were inserted
+class SpatialGrid
+{
+public:
+    SpatialGrid();
+public:
+    //! removes all windows and fits the cells to bounds for about count windows
+    void reset(const FloatRect& bounds,size_t count);
+    void insert(Window* window);
+    //! moves window to the cells of its current geometry,unknown windows are ignored
+    void update(Window* window);
+    //! shifts the cells and every window rectangle,each window keeps its cells
+    void translate(const Vector2f& offset);
+    //! whether the cells still suit bounds of size,windows beyond them are kept in the border cells
+    bool fits(const Vector2f& size)const;
+    //! first window in insertion order whose geometry contains point and which reports a window below it
+    Window* windowBelow(const Vector2f& point)const;
+    size_t size()const{return entries_.size();}
+private:
+    struct Entry
+    {
+        Window* window_;
+        FloatRect bounds_;
+        int left_,top_,right_,bottom_;
+    };
+
+    void cellRange(const FloatRect& bounds,Entry& entry)const;
+    int column(float x)const;
+    int row(float y)const;
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+private:
+    FloatRect bounds_;
+    int columns_;
+    int rows_;
+    float cellWidth_;
+    float cellHeight_;
+    std::vector<Entry> entries_;
+    std::vector<std::vector<uint32_t> > cells_;
+    std::unordered_map<Window*,uint32_t> indices_;
+};
+
+}
+
+#endif
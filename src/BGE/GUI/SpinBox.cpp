@@ -56,12 +56,19 @@ SpinBox::~SpinBox()
     delete editField_;
 }
 
-void SpinBox::deleteLater()
+void SpinBox::destroy()
 {
+    // the buttons and the edit field are children,they must be gone before the children are deleted
+    incrementButton_->remove();
+    decrementButton_->remove();
+    editField_->remove();
     delete incrementButton_;
     delete decrementButton_;
     delete editField_;
-	Slideable::deleteLater();
+    incrementButton_ = 0;
+    decrementButton_ = 0;
+    editField_ = 0;
+	Slideable::destroy();
 }
 
 bool SpinBox::process(const Message& message)
@@ -127,11 +134,11 @@ void SpinBox::incrementButtonPressed()
 
     if(!incrementTimer_.isStarted())
     {
-        incrementTimer_.setInterval(0.25f);
+        incrementTimer_.setInterval(250);
         incrementTimer_.start();
     }
     else
-        incrementTimer_.setInterval(0.05f);
+        incrementTimer_.setInterval(50);
 
     updateDisplay();
 }
@@ -144,11 +151,11 @@ void SpinBox::decrementButtonPressed()
 
     if(!decrementTimer_.isStarted())
     {
-        decrementTimer_.setInterval(0.25f);
+        decrementTimer_.setInterval(250);
         decrementTimer_.start();
     }
     else
-        decrementTimer_.setInterval(0.05f);
+        decrementTimer_.setInterval(50);
 
     updateDisplay();
 }
@@ -220,9 +227,9 @@ bool SpinBox::loadAppearance(const std::string& file)
     return editField_->loadAppearance(file);
 }
 
-bool SpinBox::loadProperty(TiXmlNode* node)
+bool SpinBox::loadProperty(const PropertyNode& node)
 {
-    TiXmlNode* window = node->FirstChildElement("Slideable");
+    PropertyNode window = node.firstChild("Slideable");
     Slideable::loadProperty(window);
     return true;
 }
@@ -23,6 +23,7 @@ Layout& StackLayout::addWindow(Window* window)
     {
         windows_.push_back(window);
         parent()->insertChild(window);
+        changed();
     }
     return *this;
 }
@@ -39,6 +40,7 @@ Layout& StackLayout::insertWindow(int index,Window* window)
         std::advance(itr,index);
 
         windows_.insert(itr,window);
+        changed();
     }
     return *this;
 }
@@ -91,7 +93,8 @@ Layout& StackLayout::setCurrentWidget(Window* window)
 
 Layout& StackLayout::removeWindow(Window* window)
 {
-    windows_.remove(window);
+    eraseWindow(window);
+    changed();
     if(parent())
     {
         parent()->removeChild(window);
@@ -124,10 +127,10 @@ Layout& StackLayout::arrangeWithin()
     return *this;
 }
 
-bool StackLayout::loadProperty(TiXmlNode* node)
+bool StackLayout::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(current,node,int)
-    TiXmlNode* window = node->FirstChildElement("Layout");
+    PropertyNode window = node.firstChild("Layout");
     Layout::loadProperty(window);
     return true;
 }
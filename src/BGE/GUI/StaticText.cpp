@@ -44,9 +44,9 @@ Window& StaticText::onDraw()
 
 WINDOW_LOAD_APPAREARANCE(StaticText)
 
-bool StaticText::loadProperty(TiXmlNode* node)
+bool StaticText::loadProperty(const PropertyNode& node)
 {
-    TiXmlNode* window = node->FirstChildElement("Window");
+    PropertyNode window = node.firstChild("Window");
     Window::loadProperty(window);
     return true;
 }
@@ -94,15 +94,15 @@ void StaticTextDesc::draw(const FloatRect& area,Canvas* canvas)const
     canvas->setColor(Color(1, 1, 1, 1));
 }
 
-bool StaticTextDesc::loadProperty(TiXmlNode* node)
+bool StaticTextDesc::loadProperty(const PropertyNode& node)
 {
-	TiXmlElement* thisNode = node->FirstChildElement("StaticTextDesc");
+	PropertyNode thisNode = node.firstChild("StaticTextDesc");
 	if(thisNode)
 	{
 		CREATE_BY_NODE(background,thisNode,RenderDesc)
 		CREATE_BY_NODE(border,thisNode,RenderDesc)
 		CREATE_BY_NODE(textDesc,thisNode,TextDesc)
-		thisNode = thisNode->FirstChildElement("RenderDesc");
+		thisNode = thisNode.firstChild("RenderDesc");
 		RenderDesc::loadProperty(thisNode);
 		return true;
 	}
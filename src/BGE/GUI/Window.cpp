@@ -41,6 +41,7 @@ Window& Window::setText(const String& text)
 {
     text_ = text;
     onTextChanged();
+    update();
     return *this;
 }
 
@@ -97,6 +98,7 @@ Window& Window::show()
     isVisible_ = true;
     WindowManager::instance().checkForWindowBelowCursor();
     onShow();
+    update();
     return *this;
 }
 
@@ -105,6 +107,21 @@ Window& Window::hide()
     isVisible_ = false;
     WindowManager::instance().checkForWindowBelowCursor();
     onHide();
+    update();
+    return *this;
+}
+
+Window& Window::enable()
+{
+    isEnabled_ = true;
+    update();
+    return *this;
+}
+
+Window& Window::disable()
+{
+    isEnabled_ = false;
+    update();
     return *this;
 }
 
@@ -128,21 +145,40 @@ Window& Window::render()
     return *this;
 }
 
+Window& Window::update()
+{
+    WindowManager::instance().invalidate(FloatRect(position_,size()));
+    return *this;
+}
+
 Window& Window::setSize(const Vector2f& aSize)
 {
+    update();
     size_ = aSize;
     onResize();
     isSizeSetByUser_ = true;
+    notifyParent();
+    update();
     return *this;
 }
 
 Window& Window::setPosition(const Vector2f& position)
 {
+    update();
     position_ = position;
     onMove();
+    notifyParent();
+    update();
     return *this;
 }
 
+void Window::notifyParent()
+{
+    Window* window = Object::castTo<Window>(parent());
+    if(window != 0)
+        window->onChildGeometryChanged(this);
+}
+
 Window& Window::enableFocused()
 {
     onGainedFocus();
@@ -188,14 +224,14 @@ void Window::setWidgetType(bool widget)
     Object::setWidgetType(true);
 }
 
-bool Window::loadProperty(TiXmlNode* node)
+bool Window::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(text,node)
     DESERIALIZE_OBJECT(position,node)
     DESERIALIZE_OBJECT(size,node)
     DESERIALIZE_OBJECT(isVisible,node)
     DESERIALIZE_OBJECT(isEnabled,node)
-    TiXmlNode* window = node->FirstChildElement("Object");
+    PropertyNode window = node.firstChild("Object");
     Object::loadProperty(window);
     return true;
 }
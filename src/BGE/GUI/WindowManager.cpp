@@ -1,13 +1,19 @@
+#include <BGE/System/Arena.h>
+#include <BGE/System/DeletionQueue.h>
+#include <BGE/System/CompiledDocument.h>
 #include <BGE/System/Timer.h>
 #include <BGE/System/TimeManager.h>
 #include <BGE/System/Err.h>
 #include <BGE/Graphics/OpenGL.h>
-#include <BGE/Graphics/CanvasImpl.h>
+#include <BGE/Graphics/BatchedCanvasImpl.h>
 #include <BGE/GUI/WindowManager.h>
 #include <BGE/GUI/Window.h>
+#include <BGE/GUI/Panel.h>
 #include <BGE/GUI/PropertyScheme.h>
 #include <algorithm>
+#include <atomic>
 #include <functional>
+#include <vector>
 
 namespace bge
 {
@@ -62,7 +68,6 @@ struct TopLevelWindow
 class WindowManagerImpl : public WindowManager
 {
     typedef std::list<TopLevelWindow>  Windows;
-    typedef std::list<Timer*>          Timers;
 public:
     WindowManagerImpl();
     virtual ~WindowManagerImpl();
@@ -72,7 +77,7 @@ public:
     Window* focusedWindow() const{return focusedWindow_;}
     void setFocusedWindow(Window* window);
 public:
-    WindowManager& initialize(const std::string& font,bool autoDelete = false);
+    WindowManager& initialize(const std::string& font,bool autoDelete = false,Canvas* canvas = 0);
     void terminate();
     void setAutoDelete(){autoDelete_ = true;}
 
@@ -87,18 +92,96 @@ public:
     WindowManager& setActiveWindow(Window* aWindow);
     WindowManager& setPopUpWindow(Window* aWindow)
     {
+        if(popUpWindow_ != 0)
+            popUpWindow_->update();
         popUpWindow_ = aWindow;
+        if(popUpWindow_ != 0)
+            popUpWindow_->update();
         return *this;
     }
     WindowManager& addTimer(Timer* timer)
     {
-        timers_.push_back(timer);
+        (void)timer;
+        return *this;
+    }
+    WindowManager& removeTimer(Timer* timer)
+    {
+        timer->stop();
         return *this;
     }
-
-    WindowManager& removeTimer(Timer* timer);
     WindowManager& checkForWindowBelowCursor();
     const WindowManager& update()const;
+    WindowManager& invalidate()
+    {
+        fullDamage_ = true;
+        damage_.clear();
+        return *this;
+    }
+    WindowManager& invalidate(const FloatRect& rectangle);
+    WindowManager& setDamageDebugging(bool debugging)
+    {
+        damageDebugging_ = debugging;
+        return invalidate();
+    }
+    bool isDamageDebugging()const{return damageDebugging_;}
+    WindowManager& setLoadingArenas(bool arenas)
+    {
+        loadingArenas_ = arenas;
+        return *this;
+    }
+    bool isLoadingArenas()const{return loadingArenas_;}
+    bool needsUpdate();
+    float idleTimeout()const;
+    uint64_t renderedFrames()const{return renderedFrames_;}
+    uint64_t skippedFrames()const{return skippedFrames_;}
+    WindowManager& scheduleLayout(Panel* panel)
+    {
+        scheduledLayouts_.push_back(panel);
+        return *this;
+    }
+    WindowManager& cancelLayout(Panel* panel);
+    WindowManager& countLayout(bool arranged)
+    {
+        if(arranged)
+            layoutCounters_.arranged_ ++;
+        else
+            layoutCounters_.shifted_ ++;
+        return *this;
+    }
+    LayoutStatistics layoutStatistics()const{return layoutStatistics_;}
+    WindowManager& post(TaskQueue::Task task)
+    {
+        tasks_.post(std::move(task));
+        wakeUp();
+        return *this;
+    }
+    WindowManager& post(std::vector<TaskQueue::Task> tasks)
+    {
+        tasks_.post(std::move(tasks));
+        wakeUp();
+        return *this;
+    }
+    WindowManager& setTaskBudget(float seconds)
+    {
+        taskBudget_ = seconds;
+        return *this;
+    }
+    WindowManager& setDeletionBudget(float seconds)
+    {
+        deletionBudget_ = seconds;
+        return *this;
+    }
+    WindowManager& deleteQueuedObjects()
+    {
+        destroyQueuedObjects(-1.0f);
+        return *this;
+    }
+    size_t queuedDeletions()const{return deletions_.size();}
+    WindowManager& setWakeUp(WakeUp wakeUp)
+    {
+        wakeUp_.store(wakeUp);
+        return *this;
+    }
 
     WindowManager& applicationResized(int x,int y);
 
@@ -135,34 +218,78 @@ private:
     bool processMouseMessage(MouseClickMessage& msg);
     bool isLastClickDoubleClick()const;
     void updateFocusIfNecessary();
+    void runPostedTasks()const;
+    void destroyQueuedObjects(float budget)const;
+    void forgetQueuedWindows()const;
+    void wakeUp();
     void triggerElapsedTimers()const;
+    void arrangeScheduledLayouts()const;
+    void renderWindows(const FloatRect& area)const;
+    void invalidateTopLevel(Window* window);
+    void invalidateClickTarget();
     int zValueOf(Window* window)const;
     int largestZValue()const;
 private:
     std::string defaultFont_;
-    Windows windows_;
-    Timers timers_;
+    //! windows and pointers to them are dropped when they are queued for deletion
+    mutable Windows windows_;
     Vector2f applicationSize_;
     Vector2f cursorPos_;
     Vector2f lastClickPos_;
     float lastClickTime_;
     int lastClickButton_;
-    Window* windowBelowCursor_;
-    Window* oldWindowBelowCursor_;
-    Window* focusedWindow_;
-    Window* windowCapture_;
-    Window* popUpWindow_;
+    mutable Window* windowBelowCursor_;
+    mutable Window* oldWindowBelowCursor_;
+    mutable Window* focusedWindow_;
+    mutable Window* windowCapture_;
+    mutable Window* popUpWindow_;
     PropertyScheme* propertyScheme_;
     String clipboard_;
     Canvas* canvas_;
     bool autoDelete_;
+    mutable bool fullDamage_;
+    mutable std::vector<FloatRect> damage_;
+    bool damageDebugging_;
+    bool loadingArenas_;
+    mutable uint64_t renderedFrames_;
+    uint64_t skippedFrames_;
+    mutable std::vector<Panel*> scheduledLayouts_;
+    mutable std::vector<Panel*> arrangingLayouts_;
+    mutable LayoutStatistics layoutCounters_;
+    mutable LayoutStatistics layoutStatistics_;
+    mutable TaskQueue tasks_;
+    float taskBudget_;
+    std::atomic<WakeUp> wakeUp_;
+    //! set by the first task posted after the queue was drained,later ones do not wake the loop again
+    mutable std::atomic<bool> isWakeUpPending_;
+    float deletionBudget_;
+    //! seconds of the budget needsUpdate spent,update destroys for the rest of them
+    mutable float deletionSpent_;
+    //! last,objects left in it are destroyed while the other members are still there
+    mutable DeletionQueue deletions_;
 
     static const float doubleClickTimeThreshold_;
     static const float doubleClickMoveThreshold_;
+    static const size_t maxDamageRectangles_;
 };
 
 const float WindowManagerImpl::doubleClickTimeThreshold_ = 0.3f;
 const float WindowManagerImpl::doubleClickMoveThreshold_ = 5.0f;
+const size_t WindowManagerImpl::maxDamageRectangles_ = 4;
+
+static float areaOf(const FloatRect& rectangle)
+{
+    return rectangle.width_ * rectangle.height_;
+}
+
+static FloatRect unite(const FloatRect& a,const FloatRect& b)
+{
+    const float left = std::min(a.left_,b.left_);
+    const float top = std::min(a.top_,b.top_);
+    const float right = std::max(a.left_ + a.width_,b.left_ + b.width_);
+    const float bottom = std::max(a.top_ + a.height_,b.top_ + b.height_);
+    return FloatRect(left,top,right - left,bottom - top);
+}
 
 WindowManager& WindowManager::instance()
 {
@@ -179,7 +306,17 @@ WindowManagerImpl::WindowManagerImpl():
     popUpWindow_(0),
     propertyScheme_(0),
     canvas_(0),
-    autoDelete_(false)
+    autoDelete_(false),
+    fullDamage_(true),
+    damageDebugging_(false),
+    loadingArenas_(false),
+    renderedFrames_(0),
+    skippedFrames_(0),
+    taskBudget_(0.004f),
+    wakeUp_(0),
+    isWakeUpPending_(false),
+    deletionBudget_(0.004f),
+    deletionSpent_(0.0f)
 {
 }
 
@@ -187,36 +324,161 @@ WindowManagerImpl::~WindowManagerImpl()
 {
 }
 
-WindowManager& WindowManagerImpl::initialize(const std::string& font,bool autoDelete)
+WindowManager& WindowManagerImpl::initialize(const std::string& font,bool autoDelete,Canvas* canvas)
 {
     defaultFont_ = font;
     autoDelete_ = autoDelete;
-    canvas_ = new CanvasImpl();
+    canvas_ = canvas ? canvas : new BatchedCanvasImpl();
     propertyScheme_ = new PropertyScheme;
+    // queued slots of windows created on this thread are called by update
+    TaskQueue::setThreadQueue(&tasks_);
+    // objects deleted on this thread are destroyed after the frame
+    DeletionQueue::setCurrent(&deletions_);
     return *this;
 }
 
 const WindowManager& WindowManagerImpl::update() const
 {
+    runPostedTasks();
     triggerElapsedTimers();
+    arrangeScheduledLayouts();
 
     canvas()->preRender(applicationSize_.x(),applicationSize_.y());
 
+    // damaged areas are drawn over the last frame,without it everything is drawn again
+    if(!fullDamage_ && !canvas()->restoreFrame())
+        fullDamage_ = true;
+
+    if(fullDamage_)
+        renderWindows(FloatRect());
+    else
+    {
+        for(size_t i = 0;i < damage_.size();i++)
+        {
+            canvas()->setDamage(damage_[i]);
+            renderWindows(damage_[i]);
+        }
+        canvas()->setDamage(FloatRect());
+    }
+
+    canvas()->preserveFrame();
+
+    if(damageDebugging_)
+    {
+        canvas()->setColor(Color(1.0f,0.0f,0.0f,0.25f));
+        if(fullDamage_)
+            canvas()->drawRectangle(FloatRect(Vector2f(),applicationSize_),false);
+        for(size_t i = 0;i < damage_.size();i++)
+            canvas()->drawRectangle(damage_[i],true);
+    }
+
+    canvas()->postRender();
+
+    // changes raised while drawing are dropped,otherwise such widgets would redraw forever
+    fullDamage_ = false;
+    damage_.clear();
+    renderedFrames_ ++;
+    layoutStatistics_ = layoutCounters_;
+    layoutCounters_ = LayoutStatistics();
+
+    // objects deleted while handling events or drawing are no longer on the stack
+    destroyQueuedObjects(deletionBudget_);
+    deletionSpent_ = 0.0f;
+    return *this;
+}
+
+void WindowManagerImpl::renderWindows(const FloatRect& area)const
+{
+    const bool everything = area.width_ <= 0.0f || area.height_ <= 0.0f;
     for(auto wit = windows_.rbegin(); wit != windows_.rend(); ++wit)
     {
-        const TopLevelWindow& tlw = *wit;
-        tlw.window->render();
+        Window* window = (*wit).window;
+        if(everything || FloatRect(window->position(),window->size()).intersects(area))
+            window->render();
     }
 
     if(popUpWindow_ != 0)
-        popUpWindow_->render();
+    {
+        if(everything || FloatRect(popUpWindow_->position(),popUpWindow_->size()).intersects(area))
+            popUpWindow_->render();
+    }
+}
 
-    canvas()->postRender();
+WindowManager& WindowManagerImpl::invalidate(const FloatRect& rectangle)
+{
+    if(fullDamage_ || rectangle.width_ <= 0.0f || rectangle.height_ <= 0.0f)
+        return *this;
+
+    const FloatRect screen(Vector2f(),applicationSize_);
+    if(areaOf(screen) <= 0.0f)
+        return invalidate();
+
+    // antialiased lines and scissor rounding reach a pixel beyond the rectangle
+    FloatRect area(rectangle.left_ - 2.0f,rectangle.top_ - 2.0f,rectangle.width_ + 4.0f,rectangle.height_ + 4.0f);
+    if(!area.intersects(screen,area))
+        return *this;
+
+    // join the rectangle growing least,a new one is only added while there are few
+    size_t best = damage_.size();
+    float bestGrowth = 0.0f;
+    for(size_t i = 0;i < damage_.size();i++)
+    {
+        const float growth = areaOf(unite(damage_[i],area)) - areaOf(damage_[i]) - areaOf(area);
+        if(best == damage_.size() || growth < bestGrowth)
+        {
+            best = i;
+            bestGrowth = growth;
+        }
+    }
+
+    if(best < damage_.size() && (bestGrowth <= 0.0f || damage_.size() >= maxDamageRectangles_))
+        damage_[best] = unite(damage_[best],area);
+    else
+        damage_.push_back(area);
+
+    float total = 0.0f;
+    for(size_t i = 0;i < damage_.size();i++)
+        total += areaOf(damage_[i]);
+    if(total > areaOf(screen) * 0.75f)
+        invalidate();
     return *this;
 }
 
+bool WindowManagerImpl::needsUpdate()
+{
+    runPostedTasks();
+    triggerElapsedTimers();
+    arrangeScheduledLayouts();
+    // destroying changes nothing on the screen unless a top level window goes,no frame is drawn for it
+    destroyQueuedObjects(deletionBudget_);
+    // tasks left over by the budget run in the next update
+    const bool dirty = fullDamage_ || !damage_.empty() || !tasks_.isEmpty();
+    if(!dirty)
+    {
+        skippedFrames_ ++;
+        deletionSpent_ = 0.0f;
+    }
+    return dirty;
+}
+
+float WindowManagerImpl::idleTimeout()const
+{
+    // a teardown spread over several updates goes on without waiting for events
+    if(!deletions_.isEmpty())
+        return 0.0f;
+
+    const uint64_t deadline = TimerWheel::instance().nextDeadline();
+    if(deadline == TimerWheel::never)
+        return -1.0f;
+
+    // the deadline is due once its millisecond begins,waiting whole milliseconds from now would add up to one
+    const uint64_t now = TimeManager::nanoseconds();
+    return deadline * 1000000 > now ? float(double(deadline * 1000000 - now) * 1e-9) : 0.0f;
+}
+
 WindowManager& WindowManagerImpl::addWindow(Window* window)
 {
+    window->update();
     TopLevelWindow tlw(window,largestZValue() + 1);
     windows_.push_back(tlw);
     windows_.sort(std::greater<TopLevelWindow>());
@@ -225,6 +487,7 @@ WindowManager& WindowManagerImpl::addWindow(Window* window)
 
 WindowManager& WindowManagerImpl::removeAllWindows()
 {
+    invalidate();
     windowBelowCursor_ = 0;
     focusedWindow_ = 0;
     windows_.clear();
@@ -233,6 +496,7 @@ WindowManager& WindowManagerImpl::removeAllWindows()
 
 WindowManager& WindowManagerImpl::removeWindow(Window* window)
 {
+    window->update();
     if(isTopLevelWindow(window))
     {
         TopLevelWindow tlw(window,zValueOf(window));
@@ -251,26 +515,6 @@ WindowManager& WindowManagerImpl::removeWindow(Window* window)
     return *this;
 }
 
-WindowManager& WindowManagerImpl::removeTimer(Timer* timer)
-{
-    Timers::iterator it;
-    bool isFound = false;
-    for(it = timers_.begin(); it != timers_.end(); ++it)
-    {
-        Timer* holder = *it;
-        if(holder == timer)
-        {
-            isFound = true;
-            break;
-        }
-    }
-
-    if(isFound)
-        timers_.erase(it);
-
-    return *this;
-}
-
 bool WindowManagerImpl::isTopLevelWindow(Window* window) const
 {
     bool ret = false;
@@ -342,6 +586,7 @@ bool WindowManagerImpl::onLeftButtonDown(int x,int y)
         evt = MouseClickMessage::doubleClicked;
     }
     checkForWindowBelowCursor();
+    invalidateClickTarget();
     MouseClickMessage rval(Message::mouseClick, Vector2f(x, y), MouseClickMessage::left, evt);
     bool isHandled = processMouseMessage(rval);
 
@@ -365,6 +610,7 @@ bool WindowManagerImpl::onLeftButtonUp(int x,int y)
 {
     cursorPos_ = Vector2f(x,y);
     checkForWindowBelowCursor();
+    invalidateClickTarget();
     MouseClickMessage rval(Message::mouseClick, Vector2f(x,y), MouseClickMessage::left, MouseClickMessage::released);
     return processMouseMessage(rval);
 }
@@ -380,6 +626,7 @@ bool WindowManagerImpl::onMiddleButtonDown(int x,int y)
     }
 
     checkForWindowBelowCursor();
+    invalidateClickTarget();
     MouseClickMessage rval(Message::mouseClick, Vector2f(x,y), MouseClickMessage::middle,evt);
     bool isHandled = processMouseMessage(rval);
 
@@ -401,6 +648,7 @@ bool WindowManagerImpl::onMiddleButtonUp(int x,int y)
 {
     cursorPos_ = Vector2f(x,y);
     checkForWindowBelowCursor();
+    invalidateClickTarget();
     MouseClickMessage rval(Message::mouseClick, Vector2f(x,y),MouseClickMessage::middle, MouseClickMessage::released);
     return processMouseMessage(rval);
 }
@@ -416,6 +664,7 @@ bool WindowManagerImpl::onRightButtonDown(int x,int y)
     }
 
     checkForWindowBelowCursor();
+    invalidateClickTarget();
     MouseClickMessage rval(Message::mouseClick, Vector2f(x, y), MouseClickMessage::right, evt);
     bool isHandled = processMouseMessage(rval);
 
@@ -437,14 +686,22 @@ bool WindowManagerImpl::onRightButtonUp(int x,int y)
 {
     cursorPos_ = Vector2f(x, y);
     checkForWindowBelowCursor();
+    invalidateClickTarget();
     MouseClickMessage rval(Message::mouseClick, Vector2f(x, y), MouseClickMessage::right, MouseClickMessage::released);
     return processMouseMessage(rval);
 }
 
 bool WindowManagerImpl::onMouseMove(int x,int y)
 {
+    // hovering only changes the window left and the one entered,dragging the captured window
+    if(windowBelowCursor_ != 0)
+        windowBelowCursor_->update();
     cursorPos_ = Vector2f(x,y);
     checkForWindowBelowCursor();
+    if(windowBelowCursor_ != 0)
+        windowBelowCursor_->update();
+    if(windowCapture_ != 0)
+        windowCapture_->topLevel()->update();
     MouseMessage rval(Message::mouseMoved,Vector2f(x, y));
     bool isHandled = false;
     if(windowCapture_)
@@ -464,18 +721,27 @@ bool WindowManagerImpl::onMouseMove(int x,int y)
 
 bool WindowManagerImpl::onChar(uint16_t ch)
 {
+    invalidateTopLevel(focusedWindow_);
+    if(popUpWindow_ != 0)
+        popUpWindow_->update();
     KeyMessage rval(Message::characterInput,ch,0,false,false,false);
     return process(rval);
 }
 
 bool WindowManagerImpl::onKeyDown(uint16_t key,bool alt,bool ctrl,bool shift)
 {
+    invalidateTopLevel(focusedWindow_);
+    if(popUpWindow_ != 0)
+        popUpWindow_->update();
     KeyMessage rval(Message::keyPressed,0,key,alt,ctrl,shift);
     return process(rval);
 }
 
 bool WindowManagerImpl::onKeyUp(uint16_t key,bool alt,bool ctrl,bool shift)
 {
+    invalidateTopLevel(focusedWindow_);
+    if(popUpWindow_ != 0)
+        popUpWindow_->update();
     KeyMessage rval(Message::keyReleased,0,key,alt,ctrl,shift);
     return process(rval);
 }
@@ -530,6 +796,12 @@ void WindowManagerImpl::terminate()
         }
         windows_.clear();
     }
+    deleteQueuedObjects();
+    if(DeletionQueue::current() == &deletions_)
+        DeletionQueue::setCurrent(0);
+    scheduledLayouts_.clear();
+    TaskQueue::setThreadQueue(0);
+    tasks_.clear();
 
     delete propertyScheme_;
     propertyScheme_ = 0;
@@ -575,6 +847,7 @@ int WindowManagerImpl::largestZValue()const
 
 WindowManager& WindowManagerImpl::setActiveWindow(Window* window)
 {
+    invalidateTopLevel(window);
     Window* topLevelWindow = window->topLevel();
     if(isTopLevelWindow(topLevelWindow))
     {
@@ -628,6 +901,7 @@ Window* WindowManagerImpl::popUpWindow()const
 
 WindowManager& WindowManagerImpl::applicationResized(int x,int y)
 {
+    invalidate();
     applicationSize_ = Vector2f(x,y);
 
     for(Windows::const_iterator it = windows_.begin(); it != windows_.end(); ++it)
@@ -652,6 +926,7 @@ WindowManager& WindowManagerImpl::applicationResized(int x,int y)
 
 void WindowManagerImpl::setDock(Window* window,const Dock& d)
 {
+    invalidate();
     if(!isTopLevelWindow(window))
         return;
 
@@ -684,24 +959,147 @@ void WindowManagerImpl::setFocusedWindow(Window* window)
     if(window != focusedWindow())
     {
         if(focusedWindow() != 0)
+        {
             focusedWindow()->disableFocused();
+            focusedWindow()->update();
+        }
         focusedWindow_ = window;
         if(window != 0)
+        {
             window->enableFocused();
+            window->update();
+        }
     }
 }
 
-void WindowManagerImpl::triggerElapsedTimers()const
+void WindowManagerImpl::invalidateTopLevel(Window* window)
 {
-    Timers::const_iterator it;
-    for(it = timers_.begin(); it != timers_.end(); ++it)
+    if(window != 0)
+        window->topLevel()->update();
+    else
+        invalidate();
+}
+
+void WindowManagerImpl::invalidateClickTarget()
+{
+    invalidateTopLevel(windowCapture_ != 0 ? windowCapture_ : windowBelowCursor_);
+    if(popUpWindow_ != 0)
+        popUpWindow_->update();
+}
+
+static size_t depthOf(const Object* object)
+{
+    size_t depth = 0;
+    while((object = object->parent()) != 0)
+        depth ++;
+    return depth;
+}
+
+static bool isShallower(const Panel* left,const Panel* right)
+{
+    return depthOf(left) < depthOf(right);
+}
+
+WindowManager& WindowManagerImpl::cancelLayout(Panel* panel)
+{
+    scheduledLayouts_.erase(std::remove(scheduledLayouts_.begin(),scheduledLayouts_.end(),panel),scheduledLayouts_.end());
+    std::replace(arrangingLayouts_.begin(),arrangingLayouts_.end(),panel,(Panel*)0);
+    return *this;
+}
+
+void WindowManagerImpl::arrangeScheduledLayouts()const
+{
+    // parents go first,arranging them resizes children which are then scheduled for this pass too
+    while(!scheduledLayouts_.empty())
     {
-        Timer* timer = *it;
-        if(timer->isElapsed())
+        arrangingLayouts_.swap(scheduledLayouts_);
+        std::stable_sort(arrangingLayouts_.begin(),arrangingLayouts_.end(),isShallower);
+        for(size_t i = 0;i < arrangingLayouts_.size();i++)
         {
-            timer->trigger();
+            Panel* panel = arrangingLayouts_[i];
+            if(panel != 0 && panel->isLayoutScheduled())
+                panel->arrangeChildren();
         }
+        arrangingLayouts_.clear();
+    }
+}
+
+void WindowManagerImpl::runPostedTasks()const
+{
+    // tasks posted from now on wake the loop again
+    isWakeUpPending_.store(false);
+    // tasks may change anything
+    if(tasks_.run(taskBudget_) > 0)
+        fullDamage_ = true;
+}
+
+void WindowManagerImpl::destroyQueuedObjects(float budget)const
+{
+    // needsUpdate and update share the budget of a frame,the first call of a frame destroys an object at least
+    const float start = TimeManager::systemTime();
+    bool isFirstPass = deletionSpent_ <= 0.0f;
+    while(!deletions_.isEmpty())
+    {
+        const float left = budget - deletionSpent_ - (TimeManager::systemTime() - start);
+        if(budget >= 0.0f && left <= 0.0f && !isFirstPass)
+            break;
+        isFirstPass = false;
+
+        // pointers into the objects of a pass are dropped once,not as each of them is destroyed
+        forgetQueuedWindows();
+        deletions_.destroy(budget < 0.0f ? -1.0f : std::max(left,0.0f));
     }
+    if(budget >= 0.0f)
+        deletionSpent_ += TimeManager::systemTime() - start;
+}
+
+static bool isQueuedForDeletion(const Object* object)
+{
+    for(;object != 0;object = object->parent())
+    {
+        if(object->isDeletionQueued())
+            return true;
+    }
+    return false;
+}
+
+void WindowManagerImpl::forgetQueuedWindows()const
+{
+    if(isQueuedForDeletion(windowBelowCursor_))
+        windowBelowCursor_ = 0;
+    if(isQueuedForDeletion(oldWindowBelowCursor_))
+        oldWindowBelowCursor_ = 0;
+    if(isQueuedForDeletion(focusedWindow_))
+        focusedWindow_ = 0;
+    if(isQueuedForDeletion(windowCapture_))
+        windowCapture_ = 0;
+    if(isQueuedForDeletion(popUpWindow_))
+    {
+        popUpWindow_ = 0;
+        fullDamage_ = true;
+    }
+
+    const size_t count = windows_.size();
+    windows_.remove_if([](const TopLevelWindow& window){return isQueuedForDeletion(window.window);});
+    if(windows_.size() != count)
+        fullDamage_ = true;
+}
+
+void WindowManagerImpl::wakeUp()
+{
+    if(isWakeUpPending_.exchange(true))
+        return;
+
+    WakeUp function = wakeUp_.load();
+    if(function)
+        function();
+}
+
+void WindowManagerImpl::triggerElapsedTimers()const
+{
+    // timer slots may change anything
+    if(TimerWheel::instance().advance(TimeManager::milliseconds()) > 0)
+        fullDamage_ = true;
 }
 
 bool WindowManagerImpl::saveWindow(Window* window,const std::string& file)
@@ -720,36 +1118,51 @@ bool WindowManagerImpl::saveWindow(Window* window,const std::string& file)
 
 Window* WindowManagerImpl::createWindow(const std::string& file)
 {
+    // a compiled file is read in place,its classes are resolved once when it is loaded
     TiXmlDocument document(file);
-    if(!document.LoadFile())
+    CompiledDocument compiled;
+    PropertyNode root;
+    if(compiled.load(file))
+        root = compiled.rootElement();
+    else if(!document.LoadFile())
 	{
 		err() << "load file "<<file<<" failed\n";
         return NULL;
 	}
-	TiXmlElement* root = document.RootElement();
+    else
+        root = document.RootElement();
     if(!root)
 	{
 		err() << "get "<<file<<" root element of xml failed\n";
         return NULL;
 	}
-	std::string classname = root->Attribute("class");
-    Rtti* rtti = Rtti::rttiByObjectName(classname);
+	const char* classname = root.attribute("class");
+    Rtti* rtti = root.rtti();
     if(!rtti)
 	{
-		err() << "get "<<classname << "'s rtti failed\n";
+		err() << "get "<<(classname ? classname : "") << "'s rtti failed\n";
         return NULL;
 	}
-	Object* object = rtti->createObject();
-	if(!object)
-	{
-	    err() <<"create object from class:"<<classname <<" failed\n";
-		return NULL;
-	}
-    Window* window = Object::castTo<Window>(object);
-    if(window)
-        window->loadProperty(root);
-    else
-        err()<<"create class:"<<classname<<" failed\n";
+
+    // the document is freed on return,only objects created from it are placed in the arena
+    Arena* arena = loadingArenas_ ? Arena::create() : 0;
+    Window* window = NULL;
+    {
+        ArenaScope scope(arena);
+        Object* object = rtti->createObject();
+        window = Object::castTo<Window>(object);
+        if(window)
+            window->loadProperty(root);
+        else if(object)
+        {
+            err()<<"create class:"<<classname<<" failed\n";
+            object->deleteLater();
+        }
+        else
+            err() <<"create object from class:"<<classname <<" failed\n";
+    }
+    if(arena)
+        arena->close();
     return window;
 }
 
@@ -0,0 +1,585 @@
+#include <BGE/System/Err.h>
+#include <BGE/Graphics/OpenGL.h>
+#include <BGE/Graphics/BatchedCanvasImpl.h>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace bge
+{
+
+//! number of batches searched backwards for a compatible one
+static const size_t mergeWindow = 16;
+//! number of areas a batch keeps for overlap tests
+static const size_t maximumAreas = 32;
+
+static bool overlaps(const FloatRect& a,const FloatRect& b)
+{
+    return a.left_ < b.left_ + b.width_ && b.left_ < a.left_ + a.width_ &&
+           a.top_ < b.top_ + b.height_ && b.top_ < a.top_ + a.height_;
+}
+
+static FloatRect unite(const FloatRect& a,const FloatRect& b)
+{
+    const float left = std::min(a.left_,b.left_);
+    const float top = std::min(a.top_,b.top_);
+    const float right = std::max(a.left_ + a.width_,b.left_ + b.width_);
+    const float bottom = std::max(a.top_ + a.height_,b.top_ + b.height_);
+    return FloatRect(left,top,right - left,bottom - top);
+}
+
+static float surface(const FloatRect& a)
+{
+    return a.width_ * a.height_;
+}
+
+static FloatRect boundsOf(const Vector2f& p1,const Vector2f& p2,float margin)
+{
+    const float left = std::min(p1.x_,p2.x_) - margin;
+    const float top = std::min(p1.y_,p2.y_) - margin;
+    const float right = std::max(p1.x_,p2.x_) + margin;
+    const float bottom = std::max(p1.y_,p2.y_) + margin;
+    return FloatRect(left,top,right - left,bottom - top);
+}
+
+BatchedCanvasImpl::BatchedCanvasImpl():
+    batchCount_(0),
+    clip_(-1),
+    damageClip_(-1),
+    texture_(0),
+    lineWidth_(1.0f),
+    color_(1.0f,1.0f,1.0f,1.0f),
+    inFrame_(false)
+{
+    packColor(color_,packedColor_);
+}
+
+BatchedCanvasImpl::~BatchedCanvasImpl()
+{
+}
+
+void BatchedCanvasImpl::packColor(const Color& color,uint8_t* packed)const
+{
+    packed[0] = static_cast<uint8_t>(std::min(std::max(color.r_,0.0f),1.0f) * 255.0f + 0.5f);
+    packed[1] = static_cast<uint8_t>(std::min(std::max(color.g_,0.0f),1.0f) * 255.0f + 0.5f);
+    packed[2] = static_cast<uint8_t>(std::min(std::max(color.b_,0.0f),1.0f) * 255.0f + 0.5f);
+    packed[3] = static_cast<uint8_t>(std::min(std::max(color.a_,0.0f),1.0f) * 255.0f + 0.5f);
+}
+
+//! clip rectangles which cut nothing off are dropped,so neighbouring widgets can share batches
+int32_t BatchedCanvasImpl::clipFor(const FloatRect& bounds)const
+{
+    if(clip_ < 0 || clip_ == damageClip_)
+        return clip_;
+
+    const IntRect& clip = clips_[clip_];
+    const IntRect area = framebufferRect(bounds);
+    if(area.left_ >= clip.left_ && area.top_ >= clip.top_ &&
+       area.left_ + area.width_ <= clip.left_ + clip.width_ &&
+       area.top_ + area.height_ <= clip.top_ + clip.height_)
+        return damageClip_;
+    return clip_;
+}
+
+BatchedCanvasImpl::Batch& BatchedCanvasImpl::batchFor(uint32_t mode,const FloatRect& bounds)
+{
+    const float width = (mode == GL_LINES) ? lineWidth_ : 0.0f;
+    const int32_t clip = clipFor(bounds);
+
+    size_t index = batchCount_;
+    size_t scanned = 0;
+    while(index > 0 && scanned < mergeWindow)
+    {
+        Batch& batch = batches_[index - 1];
+        if(batch.mode_ == mode && batch.texture_ == texture_ && batch.clip_ == clip && batch.lineWidth_ == width)
+        {
+            addArea(batch,bounds);
+            return batch;
+        }
+
+        // drawing order is only kept if nothing in between is covered
+        if(covers(batch,bounds))
+            break;
+
+        --index;
+        ++scanned;
+    }
+
+    if(batchCount_ == batches_.size())
+        batches_.push_back(Batch());
+
+    Batch& batch = batches_[batchCount_++];
+    batch.mode_ = mode;
+    batch.texture_ = texture_;
+    batch.clip_ = clip;
+    batch.lineWidth_ = width;
+    batch.bounds_ = bounds;
+    batch.areas_.assign(1,bounds);
+    batch.vertices_.clear();
+    return batch;
+}
+
+bool BatchedCanvasImpl::covers(const Batch& batch,const FloatRect& bounds)const
+{
+    if(!overlaps(batch.bounds_,bounds))
+        return false;
+
+    for(size_t i = 0;i < batch.areas_.size();i++)
+    {
+        if(overlaps(batch.areas_[i],bounds))
+            return true;
+    }
+    return false;
+}
+
+void BatchedCanvasImpl::addArea(Batch& batch,const FloatRect& bounds)
+{
+    batch.bounds_ = unite(batch.bounds_,bounds);
+
+    std::vector<FloatRect>& areas = batch.areas_;
+    if(areas.size() == maximumAreas)
+    {
+        // unite the neighbours growing least,primitives drawn one after another are usually close
+        size_t best = 0;
+        float growth = -1.0f;
+        for(size_t i = 0;i + 1 < areas.size();i++)
+        {
+            const float delta = surface(unite(areas[i],areas[i + 1])) - surface(areas[i]) - surface(areas[i + 1]);
+            if(growth < 0.0f || delta < growth)
+            {
+                best = i;
+                growth = delta;
+            }
+        }
+        areas[best] = unite(areas[best],areas[best + 1]);
+        areas.erase(areas.begin() + best + 1);
+    }
+    areas.push_back(bounds);
+}
+
+void BatchedCanvasImpl::addVertex(Batch& batch,float x,float y,const uint8_t* color,float u,float v)
+{
+    Vertex vertex;
+    vertex.x_ = x;
+    vertex.y_ = y;
+    vertex.color_[0] = color[0];
+    vertex.color_[1] = color[1];
+    vertex.color_[2] = color[2];
+    vertex.color_[3] = color[3];
+    vertex.u_ = u;
+    vertex.v_ = v;
+    batch.vertices_.push_back(vertex);
+}
+
+void BatchedCanvasImpl::drawLine(const Vector2f& start,const Vector2f& end)
+{
+    Batch& batch = batchFor(GL_LINES,boundsOf(start,end,lineWidth_));
+    addVertex(batch,start.x_,start.y_,packedColor_);
+    addVertex(batch,end.x_,end.y_,packedColor_);
+}
+
+void BatchedCanvasImpl::drawRectangle(const FloatRect& rectangle,bool filled)
+{
+    const float left = rectangle.left_;
+    const float top = rectangle.top_;
+    const float right = rectangle.left_ + rectangle.width_;
+    const float bottom = rectangle.top_ + rectangle.height_;
+
+    if(filled)
+    {
+        Batch& batch = batchFor(GL_TRIANGLES,rectangle);
+        addVertex(batch,left,top,packedColor_);
+        addVertex(batch,left,bottom,packedColor_);
+        addVertex(batch,right,top,packedColor_);
+        addVertex(batch,right,top,packedColor_);
+        addVertex(batch,left,bottom,packedColor_);
+        addVertex(batch,right,bottom,packedColor_);
+    }
+    else
+    {
+        const float width = lineWidth_;
+        const float halfwidth = width * 0.5f;
+
+        Batch& batch = batchFor(GL_LINES,boundsOf(Vector2f(left,top),Vector2f(right,bottom),width));
+        addVertex(batch,left,top - halfwidth,packedColor_);
+        addVertex(batch,right,top - halfwidth,packedColor_);
+
+        addVertex(batch,right - halfwidth,top - width,packedColor_);
+        addVertex(batch,right - halfwidth,bottom + width,packedColor_);
+
+        addVertex(batch,right,bottom + halfwidth,packedColor_);
+        addVertex(batch,left,bottom + halfwidth,packedColor_);
+
+        addVertex(batch,left + halfwidth,bottom + width,packedColor_);
+        addVertex(batch,left + halfwidth,top - width,packedColor_);
+    }
+}
+
+void BatchedCanvasImpl::drawGradientFilledRectangle(const FloatRect& rectangle,const Color& color1, const Color& color2, bool horizontal)
+{
+    const float left = rectangle.left_;
+    const float top = rectangle.top_;
+    const float right = rectangle.left_ + rectangle.width_;
+    const float bottom = rectangle.top_ + rectangle.height_;
+
+    uint8_t first[4],second[4];
+    packColor(color1,first);
+    packColor(color2,second);
+
+    const uint8_t* topRight = horizontal ? second : first;
+    const uint8_t* bottomLeft = horizontal ? first : second;
+
+    Batch& batch = batchFor(GL_TRIANGLES,rectangle);
+    addVertex(batch,left,top,first);
+    addVertex(batch,left,bottom,bottomLeft);
+    addVertex(batch,right,top,topRight);
+    addVertex(batch,right,top,topRight);
+    addVertex(batch,left,bottom,bottomLeft);
+    addVertex(batch,right,bottom,second);
+}
+
+void BatchedCanvasImpl::drawCircleSegment(const Vector2f& center, float radius,float t1, float t2, uint32_t segments, bool filled)
+{
+    if(segments == 0)
+        return;
+
+    const float xtra = filled ? 0.0f : lineWidth_ * 0.5f;
+    const float outerRadius = radius + xtra;
+    const float innerRadius = filled ? 0.0f : radius - xtra;
+
+    const Vector2f extent(outerRadius,outerRadius);
+    Batch& batch = batchFor(GL_TRIANGLES,FloatRect(center - extent,extent * 2.0f));
+
+    const float step = (t2 - t1) / float(segments);
+    float cosA = std::cos(t1);
+    float sinA = -std::sin(t1);
+    for(uint32_t i = 1;i <= segments;i++)
+    {
+        const float angle = t1 + step * float(i);
+        const float cosB = std::cos(angle);
+        const float sinB = -std::sin(angle);
+
+        if(innerRadius <= 0.0f)
+        {
+            addVertex(batch,center.x_,center.y_,packedColor_);
+            addVertex(batch,center.x_ + outerRadius * cosA,center.y_ + outerRadius * sinA,packedColor_);
+            addVertex(batch,center.x_ + outerRadius * cosB,center.y_ + outerRadius * sinB,packedColor_);
+        }
+        else
+        {
+            addVertex(batch,center.x_ + innerRadius * cosA,center.y_ + innerRadius * sinA,packedColor_);
+            addVertex(batch,center.x_ + outerRadius * cosA,center.y_ + outerRadius * sinA,packedColor_);
+            addVertex(batch,center.x_ + outerRadius * cosB,center.y_ + outerRadius * sinB,packedColor_);
+            addVertex(batch,center.x_ + innerRadius * cosA,center.y_ + innerRadius * sinA,packedColor_);
+            addVertex(batch,center.x_ + outerRadius * cosB,center.y_ + outerRadius * sinB,packedColor_);
+            addVertex(batch,center.x_ + innerRadius * cosB,center.y_ + innerRadius * sinB,packedColor_);
+        }
+
+        cosA = cosB;
+        sinA = sinB;
+    }
+}
+
+void BatchedCanvasImpl::drawDroppedRectangle(const FloatRect& rectangle,const Color& color1,const Color& color2)
+{
+    const float width = lineWidth_;
+    const float halfwidth = width * 0.5f;
+    const float left = rectangle.left_;
+    const float top = rectangle.top_;
+    const float right = rectangle.left_ + rectangle.width_;
+    const float bottom = rectangle.top_ + rectangle.height_;
+
+    uint8_t first[4],second[4];
+    packColor(color1,first);
+    packColor(color2,second);
+
+    Batch& batch = batchFor(GL_LINES,boundsOf(Vector2f(left,top),Vector2f(right,bottom),width));
+    addVertex(batch,left,bottom - halfwidth,first);
+    addVertex(batch,right,bottom - halfwidth,first);
+
+    addVertex(batch,right - halfwidth,bottom - width,first);
+    addVertex(batch,right - halfwidth,top + width,first);
+
+    addVertex(batch,right,top + halfwidth,second);
+    addVertex(batch,left,top + halfwidth,second);
+
+    addVertex(batch,left + halfwidth,top + width,second);
+    addVertex(batch,left + halfwidth,bottom - width,second);
+
+    // the immediate mode canvas leaves the last color current
+    color_ = color2;
+    memcpy(packedColor_,second,4);
+}
+
+void BatchedCanvasImpl::drawTriangle(const Vector2f& p1,const Vector2f& p2,const Vector2f& p3,bool filled)
+{
+    const FloatRect bounds = unite(boundsOf(p1,p2,lineWidth_),boundsOf(p2,p3,lineWidth_));
+    if(filled)
+    {
+        Batch& batch = batchFor(GL_TRIANGLES,bounds);
+        addVertex(batch,p1.x_,p1.y_,packedColor_);
+        addVertex(batch,p2.x_,p2.y_,packedColor_);
+        addVertex(batch,p3.x_,p3.y_,packedColor_);
+    }
+    else
+    {
+        Batch& batch = batchFor(GL_LINES,bounds);
+        addVertex(batch,p1.x_,p1.y_,packedColor_);
+        addVertex(batch,p2.x_,p2.y_,packedColor_);
+        addVertex(batch,p2.x_,p2.y_,packedColor_);
+        addVertex(batch,p3.x_,p3.y_,packedColor_);
+        addVertex(batch,p3.x_,p3.y_,packedColor_);
+        addVertex(batch,p1.x_,p1.y_,packedColor_);
+    }
+}
+
+void BatchedCanvasImpl::drawImage(Image* image,const FloatRect& rect,bool tiled,float minx,float miny, float maxx, float maxy)
+{
+    enableTexturing(image);
+    setColor(Color(1.0f,1.0f,1.0f,1.0f));
+
+    // a tiled image repeats its part of the texture at its own size from the top left corner,
+    // the last column and row are cut and so are their texture coordinates
+    const Vector2i size = image->size();
+    float tileWidth = tiled ? fabsf(maxx - minx) * size.x_ : 0.0f;
+    float tileHeight = tiled ? fabsf(maxy - miny) * size.y_ : 0.0f;
+    if(tileWidth < 1.0f || tileWidth >= rect.width_)
+        tileWidth = rect.width_;
+    if(tileHeight < 1.0f || tileHeight >= rect.height_)
+        tileHeight = rect.height_;
+
+    Batch& batch = batchFor(GL_TRIANGLES,rect);
+    const float right = rect.left_ + rect.width_;
+    const float bottom = rect.top_ + rect.height_;
+    for(float top = rect.top_;top < bottom;top += tileHeight)
+    {
+        const float height = std::min(tileHeight,bottom - top);
+        const float v = maxy + (miny - maxy) * height / tileHeight;
+        for(float left = rect.left_;left < right;left += tileWidth)
+        {
+            const float width = std::min(tileWidth,right - left);
+            const float u = minx + (maxx - minx) * width / tileWidth;
+            addVertex(batch,left,top + height,packedColor_,minx,v);
+            addVertex(batch,left,top,packedColor_,minx,maxy);
+            addVertex(batch,left + width,top,packedColor_,u,maxy);
+            addVertex(batch,left,top + height,packedColor_,minx,v);
+            addVertex(batch,left + width,top,packedColor_,u,maxy);
+            addVertex(batch,left + width,top + height,packedColor_,u,v);
+        }
+    }
+
+    disableTexturing();
+}
+
+void BatchedCanvasImpl::drawGlyphs(uint32_t texture,const GlyphQuad* quads,size_t count)
+{
+    if(count == 0)
+        return;
+
+    FloatRect bounds = quads[0].rectangle_;
+    for(size_t i = 1;i < count;i++)
+        bounds = unite(bounds,quads[i].rectangle_);
+
+    const uint32_t current = texture_;
+    texture_ = texture;
+    Batch& batch = batchFor(GL_TRIANGLES,bounds);
+    texture_ = current;
+
+    for(size_t i = 0;i < count;i++)
+    {
+        const GlyphQuad& quad = quads[i];
+        const float left = quad.rectangle_.left_;
+        const float top = quad.rectangle_.top_;
+        const float right = left + quad.rectangle_.width_;
+        const float bottom = top + quad.rectangle_.height_;
+        const Vector2f& uv1 = quad.topLeftUV_;
+        const Vector2f& uv2 = quad.bottomRightUV_;
+
+        addVertex(batch,left,top,packedColor_,uv1.x_,uv1.y_);
+        addVertex(batch,left,bottom,packedColor_,uv1.x_,uv2.y_);
+        addVertex(batch,right,top,packedColor_,uv2.x_,uv1.y_);
+        addVertex(batch,right,top,packedColor_,uv2.x_,uv1.y_);
+        addVertex(batch,left,bottom,packedColor_,uv1.x_,uv2.y_);
+        addVertex(batch,right,bottom,packedColor_,uv2.x_,uv2.y_);
+    }
+}
+
+void BatchedCanvasImpl::enableTexturing(Image* image)
+{
+    if(image->handle() == 0)
+        registerImage(image);
+
+    assert(image->handle() != 0);
+    texture_ = static_cast<uint32_t>(image->handle());
+}
+
+void BatchedCanvasImpl::disableTexturing()
+{
+    texture_ = 0;
+}
+
+void BatchedCanvasImpl::unregisterImage(int32_t handle)
+{
+    flush();
+    CanvasImpl::unregisterImage(handle);
+}
+
+void BatchedCanvasImpl::enableClipRectangle(const FloatRect& rectangle)
+{
+    const IntRect clip = scissorOf(rectangle);
+    if(clip_ >= 0 && clips_[clip_] == clip)
+        return;
+
+    clips_.push_back(clip);
+    clip_ = static_cast<int32_t>(clips_.size()) - 1;
+}
+
+void BatchedCanvasImpl::disableClipRectangle()
+{
+    clip_ = damageClip_;
+}
+
+void BatchedCanvasImpl::setDamage(const FloatRect& rectangle)
+{
+    CanvasImpl::setDamage(rectangle);
+
+    damageClip_ = -1;
+    if(hasDamage_)
+    {
+        clips_.push_back(damage_);
+        damageClip_ = static_cast<int32_t>(clips_.size()) - 1;
+    }
+    clip_ = damageClip_;
+}
+
+void BatchedCanvasImpl::setColor(const Color& color)
+{
+    color_ = color;
+    packColor(color,packedColor_);
+}
+
+void BatchedCanvasImpl::setLineWidth(float width)
+{
+    lineWidth_ = width;
+}
+
+void BatchedCanvasImpl::applyClip(int32_t clip)
+{
+    if(clip < 0)
+    {
+        glDisable(GL_SCISSOR_TEST);
+        return;
+    }
+
+    const IntRect& rectangle = clips_[clip];
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(rectangle.left_,rectangle.top_,rectangle.width_,rectangle.height_);
+}
+
+void BatchedCanvasImpl::syncState()
+{
+    // leave opengl the way the immediate mode canvas would have
+    glDisable(GL_TEXTURE_2D);
+    applyClip(clip_);
+    glLineWidth(lineWidth_);
+    glColor4f(color_.r_,color_.g_,color_.b_,color_.a_);
+}
+
+void BatchedCanvasImpl::flush()
+{
+    if(!inFrame_)
+        return;
+
+    if(batchCount_ > 0)
+    {
+        glTexEnvi(GL_TEXTURE_ENV,GL_TEXTURE_ENV_MODE,GL_MODULATE);
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+
+        int32_t clip = -2;
+        uint32_t texture = 0;
+        float width = -1.0f;
+        glDisable(GL_TEXTURE_2D);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+
+        for(size_t i = 0;i < batchCount_;i++)
+        {
+            Batch& batch = batches_[i];
+            if(batch.vertices_.empty())
+                continue;
+
+            if(batch.clip_ != clip)
+            {
+                clip = batch.clip_;
+                applyClip(clip);
+            }
+
+            if(batch.texture_ != texture)
+            {
+                if(batch.texture_ == 0)
+                {
+                    glDisable(GL_TEXTURE_2D);
+                    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+                }
+                else
+                {
+                    if(texture == 0)
+                    {
+                        glEnable(GL_TEXTURE_2D);
+                        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+                    }
+                    bindTexture(batch.texture_);
+                }
+                texture = batch.texture_;
+            }
+
+            if(batch.mode_ == GL_LINES && batch.lineWidth_ != width)
+            {
+                width = batch.lineWidth_;
+                glLineWidth(width);
+            }
+
+            const Vertex* vertices = &batch.vertices_[0];
+            glVertexPointer(2,GL_FLOAT,sizeof(Vertex),&vertices->x_);
+            glColorPointer(4,GL_UNSIGNED_BYTE,sizeof(Vertex),vertices->color_);
+            if(texture != 0)
+                glTexCoordPointer(2,GL_FLOAT,sizeof(Vertex),&vertices->u_);
+
+            glDrawArrays(batch.mode_,0,static_cast<GLsizei>(batch.vertices_.size()));
+
+            statistics_.drawCalls_ ++;
+            statistics_.vertices_ += static_cast<uint32_t>(batch.vertices_.size());
+            batch.vertices_.clear();
+        }
+
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_VERTEX_ARRAY);
+        batchCount_ = 0;
+    }
+
+    syncState();
+}
+
+void BatchedCanvasImpl::preRender(int width,int height)
+{
+    CanvasImpl::preRender(width,height);
+
+    batchCount_ = 0;
+    clips_.clear();
+    clip_ = -1;
+    damageClip_ = -1;
+    texture_ = 0;
+    lineWidth_ = CanvasImpl::lineWidth();
+    inFrame_ = true;
+}
+
+void BatchedCanvasImpl::postRender()
+{
+    flush();
+    inFrame_ = false;
+    CanvasImpl::postRender();
+}
+
+}
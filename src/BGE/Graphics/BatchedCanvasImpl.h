@@ -0,0 +1,84 @@
+#ifndef BGE_GRAPHICS_BATCHEDCANVASIMPL_H
+#define BGE_GRAPHICS_BATCHEDCANVASIMPL_H
+#include <BGE/Graphics/CanvasImpl.h>
+#include <vector>
+
+namespace bge
+{
+
+//! canvas which queues primitives into vertex arrays and submits them in a few draw calls
+//! primitives sharing texture,clip rectangle and line width are merged into one batch,
+//! a primitive may join an earlier batch only if it does not overlap anything drawn in between
+class BatchedCanvasImpl : public CanvasImpl
+{
+public:
+    BatchedCanvasImpl();
+    ~BatchedCanvasImpl();
+public:
+    void drawLine(const Vector2f& start,const Vector2f& end);
+    void drawRectangle(const FloatRect& rectangle,bool filled);
+    void drawGradientFilledRectangle(const FloatRect& rectangle,const Color& color1, const Color& color2, bool horizontal);
+    void drawCircleSegment(const Vector2f& center, float radius,float t1, float t2, uint32_t numSegments, bool filled);
+    void enableClipRectangle(const FloatRect& rectangle);
+    void disableClipRectangle();
+    void setColor(const Color& color);
+    void setLineWidth(float width);
+    float lineWidth()const{return lineWidth_;}
+    void drawTriangle(const Vector2f& p1,const Vector2f& p2,const Vector2f& p3,bool filled);
+    void drawImage(Image* image,const FloatRect& rect,bool tiled,float minx,float miny, float maxx, float maxy);
+    void enableTexturing(Image* image);
+    void disableTexturing();
+    void unregisterImage(int32_t handle);
+    void drawDroppedRectangle(const FloatRect& rectangle,const Color& color1, const Color& color2);
+
+    void preRender(int width,int height);
+    void postRender();
+    void flush();
+
+    void setDamage(const FloatRect& rectangle);
+    void drawGlyphs(uint32_t texture,const GlyphQuad* quads,size_t count);
+private:
+    struct Vertex
+    {
+        float x_,y_;
+        uint8_t color_[4];
+        float u_,v_;
+    };
+
+    struct Batch
+    {
+        uint32_t mode_;
+        uint32_t texture_;
+        int32_t clip_;
+        float lineWidth_;
+        FloatRect bounds_;
+        //! bounds of the primitives,neighbouring ones are united when there are too many
+        std::vector<FloatRect> areas_;
+        std::vector<Vertex> vertices_;
+    };
+
+    Batch& batchFor(uint32_t mode,const FloatRect& bounds);
+    bool covers(const Batch& batch,const FloatRect& bounds)const;
+    void addArea(Batch& batch,const FloatRect& bounds);
+    int32_t clipFor(const FloatRect& bounds)const;
+    void addVertex(Batch& batch,float x,float y,const uint8_t* color,float u = 0.0f,float v = 0.0f);
+    void packColor(const Color& color,uint8_t* packed)const;
+    void applyClip(int32_t clip);
+    void syncState();
+private:
+    std::vector<Batch> batches_;
+    size_t batchCount_;
+    std::vector<IntRect> clips_;
+    int32_t clip_;
+    //! clip used when no clip rectangle is enabled,-1 unless a damaged area is set
+    int32_t damageClip_;
+    uint32_t texture_;
+    float lineWidth_;
+    Color color_;
+    uint8_t packedColor_[4];
+    bool inFrame_;
+};
+
+}
+
+#endif
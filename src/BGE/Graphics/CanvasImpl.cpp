@@ -3,7 +3,9 @@
 #include <BGE/Graphics/CanvasImpl.h>
 #include <BGE/Graphics/glfont/GLTextRenderer.h>
 #include <BGE/GUI/WindowManager.h>
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 
 namespace bge
 {
@@ -12,10 +14,43 @@ Canvas::~Canvas()
 {
 }
 
-CanvasImpl::CanvasImpl()
+//! marks the texture binding as not known to the canvas
+static const uint32_t unknownTexture = 0xffffffff;
+
+static int nextPowerOfTwo(int value)
+{
+    int ret = 1;
+    while(ret < value)
+        ret <<= 1;
+    return ret;
+}
+
+static IntRect unite(const IntRect& a,const IntRect& b)
+{
+    if(a.width_ <= 0 || a.height_ <= 0)
+        return b;
+
+    const int left = std::min(a.left_,b.left_);
+    const int top = std::min(a.top_,b.top_);
+    const int right = std::max(a.left_ + a.width_,b.left_ + b.width_);
+    const int bottom = std::max(a.top_ + a.height_,b.top_ + b.height_);
+    return IntRect(left,top,right - left,bottom - top);
+}
+
+CanvasImpl::CanvasImpl():
+    hasDamage_(false),
+    boundTexture_(unknownTexture),
+    frameWidth_(0),
+    frameHeight_(0),
+    frameTexture_(0),
+    frameTextureWidth_(0),
+    frameTextureHeight_(0),
+    framePreserved_(false),
+    frameRestored_(false)
 {
     if(FT_Init_FreeType(&library_) != 0)
         err()<<"failed to initialize freetype library.\n";
+    fontRegistry_ = new Font::FontRegistry(library_);
 }
 
 CanvasImpl::~CanvasImpl()
@@ -26,12 +61,22 @@ CanvasImpl::~CanvasImpl()
 		delete itr->second;
 	    itr ++;
 	}
+    delete fontRegistry_;
     if(FT_Done_FreeType(library_) != 0)
         err()<<"failed to initialize freetype library.\n";
+
+    if(frameTexture_ != 0)
+    {
+        const GLuint name = frameTexture_;
+        glDeleteTextures(1,&name);
+    }
 }
 
 void CanvasImpl::drawLine(const Vector2f& start,const Vector2f& end)
 {
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += 2;
+
     glBegin(GL_LINES);
         glVertex2f(start.x_,start.y_);
         glVertex2f(end.x_,end.y_);
@@ -40,6 +85,9 @@ void CanvasImpl::drawLine(const Vector2f& start,const Vector2f& end)
 
 void CanvasImpl::drawRectangle(const FloatRect& rectangle,bool filled)
 {
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += filled ? 4 : 8;
+
     if(filled)
     {
         glBegin(GL_TRIANGLE_STRIP);
@@ -71,6 +119,9 @@ void CanvasImpl::drawRectangle(const FloatRect& rectangle,bool filled)
 
 void CanvasImpl::drawGradientFilledRectangle(const FloatRect& rectangle,const Color& color1, const Color& color2, bool horizontal)
 {
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += 4;
+
     glBegin(GL_TRIANGLE_STRIP);
     if(horizontal)
     {
@@ -114,6 +165,9 @@ void CanvasImpl::drawCircleSegment(const Vector2f& center, float radius,float t1
 
     glTranslatef(cx,cy,0.0f);
 
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += 2 * (segments + 1);
+
     static GLUquadricObj* quadric = gluNewQuadric();
     gluPartialDisk(quadric,innerRadius, outerRadius,segments, 1, a1, a2-a1);
 
@@ -130,6 +184,9 @@ void CanvasImpl::drawDroppedRectangle(const FloatRect& rectangle,const Color& co
     const float width = lineWidth();
     const float halfwidth = width * 0.5f;
 
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += 8;
+
     glBegin(GL_LINES);
         glColor4f(color1.r_,color1.g_,color1.b_,color1.a_);
         glVertex2f(rectangle.left_,rectangle.top_ + rectangle.height_ - halfwidth );
@@ -152,22 +209,35 @@ void CanvasImpl::drawRaisedRectangle(const FloatRect& rectangle,const Color& col
     drawDroppedRectangle(rectangle,color2,color1);
 }
 
-void CanvasImpl::enableClipRectangle(const FloatRect& rectangle)
+IntRect CanvasImpl::framebufferRect(const FloatRect& rectangle)const
 {
-    GLfloat vp[4];
-    glGetFloatv(GL_VIEWPORT,vp);
+    return IntRect(static_cast<int>(rectangle.left_),
+                   static_cast<int>(frameHeight_ - rectangle.top_ - rectangle.height_),
+                   static_cast<int>(rectangle.size().x_)+1,
+                   static_cast<int>(rectangle.size().y_)+1);
+}
 
-    glEnable(GL_SCISSOR_TEST);
-    glScissor(static_cast<int>(rectangle.left_),
-              static_cast<int>(vp[3] - vp[1] - rectangle.top_ - rectangle.height_),
-              static_cast<int>(rectangle.size().x_)+1,
-              static_cast<int>(rectangle.size().y_)+1);
+IntRect CanvasImpl::scissorOf(const FloatRect& rectangle)const
+{
+    IntRect ret = framebufferRect(rectangle);
+    if(hasDamage_)
+        ret.intersects(damage_,ret);
+    return ret;
+}
 
+void CanvasImpl::enableClipRectangle(const FloatRect& rectangle)
+{
+    const IntRect scissor = scissorOf(rectangle);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(scissor.left_,scissor.top_,scissor.width_,scissor.height_);
 }
 
 void CanvasImpl::disableClipRectangle()
 {
-    glDisable(GL_SCISSOR_TEST);
+    if(hasDamage_)
+        glScissor(damage_.left_,damage_.top_,damage_.width_,damage_.height_);
+    else
+        glDisable(GL_SCISSOR_TEST);
 }
 
 void CanvasImpl::setColor(const Color& color)
@@ -196,6 +266,9 @@ float CanvasImpl::lineWidth()const
 
 void CanvasImpl::drawTriangle(const Vector2f& p1,const Vector2f& p2,const Vector2f& p3,bool filled)
 {
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += 3;
+
     if(filled)
         glBegin(GL_TRIANGLES);
     else
@@ -246,15 +319,39 @@ void CanvasImpl::drawImage(Image* image,const FloatRect& rect,bool tiled,float m
 
     glColor3f(1.0f,1.0f,1.0f);
 
+    // a tiled image repeats its part of the texture at its own size,the last column and row are cut
+    const Vector2i size = image->size();
+    float tileWidth = tiled ? fabsf(maxx - minx) * size.x_ : 0.0f;
+    float tileHeight = tiled ? fabsf(maxy - miny) * size.y_ : 0.0f;
+    if(tileWidth < 1.0f || tileWidth >= rect.width_)
+        tileWidth = rect.width_;
+    if(tileHeight < 1.0f || tileHeight >= rect.height_)
+        tileHeight = rect.height_;
+
+    statistics_.drawCalls_ ++;
+
+    const float right = rect.left_ + rect.width_;
+    const float bottom = rect.top_ + rect.height_;
     glBegin(GL_QUADS);
-        glTexCoord2f(minx,miny);
-        glVertex2f(rect.left_,rect.top_+rect.height_);
-        glTexCoord2f(minx,maxy);
-        glVertex2f(rect.left_,rect.top_);
-        glTexCoord2f(maxx,maxy);
-        glVertex2f(rect.left_+rect.width_,rect.top_);
-        glTexCoord2f(maxx,miny);
-        glVertex2f(rect.left_+rect.width_,rect.top_ + rect.height_);
+    for(float top = rect.top_;top < bottom;top += tileHeight)
+    {
+        const float height = std::min(tileHeight,bottom - top);
+        const float v = maxy + (miny - maxy) * height / tileHeight;
+        for(float left = rect.left_;left < right;left += tileWidth)
+        {
+            const float width = std::min(tileWidth,right - left);
+            const float u = minx + (maxx - minx) * width / tileWidth;
+            statistics_.vertices_ += 4;
+            glTexCoord2f(minx,v);
+            glVertex2f(left,top + height);
+            glTexCoord2f(minx,maxy);
+            glVertex2f(left,top);
+            glTexCoord2f(u,maxy);
+            glVertex2f(left + width,top);
+            glTexCoord2f(u,v);
+            glVertex2f(left + width,top + height);
+        }
+    }
     glEnd();
 
     disableTexturing();
@@ -275,7 +372,54 @@ void CanvasImpl::enableTexturing(Image* image)
 
     assert(image->handle() != 0);
 
-    glBindTexture(GL_TEXTURE_2D,image->handle());
+    bindTexture(static_cast<uint32_t>(image->handle()));
+}
+
+void CanvasImpl::bindTexture(uint32_t texture)
+{
+    if(texture == boundTexture_)
+        return;
+
+    glBindTexture(GL_TEXTURE_2D,texture);
+    boundTexture_ = texture;
+}
+
+void CanvasImpl::drawGlyphs(uint32_t texture,const GlyphQuad* quads,size_t count)
+{
+    if(count == 0)
+        return;
+
+    glyphVertices_.resize(count * 16);
+    float* vertex = &glyphVertices_[0];
+    for(size_t i = 0;i < count;i++)
+    {
+        const GlyphQuad& quad = quads[i];
+        const float left = quad.rectangle_.left_;
+        const float top = quad.rectangle_.top_;
+        const float right = left + quad.rectangle_.width_;
+        const float bottom = top + quad.rectangle_.height_;
+
+        *vertex++ = left;  *vertex++ = top;    *vertex++ = quad.topLeftUV_.x_;     *vertex++ = quad.topLeftUV_.y_;
+        *vertex++ = right; *vertex++ = top;    *vertex++ = quad.bottomRightUV_.x_; *vertex++ = quad.topLeftUV_.y_;
+        *vertex++ = right; *vertex++ = bottom; *vertex++ = quad.bottomRightUV_.x_; *vertex++ = quad.bottomRightUV_.y_;
+        *vertex++ = left;  *vertex++ = bottom; *vertex++ = quad.topLeftUV_.x_;     *vertex++ = quad.bottomRightUV_.y_;
+    }
+
+    glEnable(GL_TEXTURE_2D);
+    bindTexture(texture);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glVertexPointer(2,GL_FLOAT,4 * sizeof(float),&glyphVertices_[0]);
+    glTexCoordPointer(2,GL_FLOAT,4 * sizeof(float),&glyphVertices_[2]);
+    glDrawArrays(GL_QUADS,0,static_cast<GLsizei>(count * 4));
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+
+    glDisable(GL_TEXTURE_2D);
+
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += static_cast<uint32_t>(count * 4);
 }
 
 void CanvasImpl::disableTexturing()
@@ -289,7 +433,7 @@ TextRenderer* CanvasImpl::createText(const std::string& name,int point)
     std::map<FontDetails,Font::GLTextRenderer*>::iterator fontIterator = fontMap_.find(fontDetails);
     if(fontIterator == fontMap_.end())
     {
-        fontMap_[fontDetails] = new Font::GLTextRenderer(name,point);
+        fontMap_[fontDetails] = new Font::GLTextRenderer(this,name,point);
     }
 
     fontIterator = fontMap_.find(fontDetails);
@@ -297,6 +441,11 @@ TextRenderer* CanvasImpl::createText(const std::string& name,int point)
     return fontIterator->second;
 }
 
+FontStatistics CanvasImpl::fontStatistics()const
+{
+    return fontRegistry_->statistics();
+}
+
 void CanvasImpl::registerImage(Image* image)
 {
     GLuint name = 0;
@@ -305,6 +454,7 @@ void CanvasImpl::registerImage(Image* image)
     if(name != 0)
     {
         glBindTexture(GL_TEXTURE_2D,name);
+        boundTexture_ = name;
         glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_REPLACE);
 
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
@@ -325,10 +475,139 @@ void CanvasImpl::unregisterImage(int32_t handle)
 {
     const GLuint name = static_cast<GLuint>(handle);
     glDeleteTextures(1,&name);
+
+    // deleting the bound texture reverts the binding to the default one
+    if(boundTexture_ == name)
+        boundTexture_ = 0;
+}
+
+bool CanvasImpl::restoreFrame()
+{
+    if(!framePreserved_)
+        return false;
+
+    flush();
+
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += 4;
+
+    const float width = static_cast<float>(frameWidth_);
+    const float height = static_cast<float>(frameHeight_);
+    const float u = width / frameTextureWidth_;
+    const float v = height / frameTextureHeight_;
+
+    glPushAttrib(GL_ENABLE_BIT | GL_TEXTURE_BIT | GL_CURRENT_BIT);
+    glDisable(GL_BLEND);
+    glDisable(GL_SCISSOR_TEST);
+    glEnable(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D,frameTexture_);
+    glTexEnvi(GL_TEXTURE_ENV,GL_TEXTURE_ENV_MODE,GL_REPLACE);
+
+    // rows were copied bottom up from the framebuffer
+    glBegin(GL_QUADS);
+        glTexCoord2f(0.0f,v);
+        glVertex2f(0.0f,0.0f);
+        glTexCoord2f(0.0f,0.0f);
+        glVertex2f(0.0f,height);
+        glTexCoord2f(u,0.0f);
+        glVertex2f(width,height);
+        glTexCoord2f(u,v);
+        glVertex2f(width,0.0f);
+    glEnd();
+
+    glPopAttrib();
+    frameRestored_ = true;
+    return true;
+}
+
+void CanvasImpl::setDamage(const FloatRect& rectangle)
+{
+    flush();
+
+    if(rectangle.width_ <= 0.0f || rectangle.height_ <= 0.0f)
+    {
+        hasDamage_ = false;
+        glDisable(GL_SCISSOR_TEST);
+        return;
+    }
+
+    hasDamage_ = false;
+    damage_ = scissorOf(rectangle);
+    damage_.intersects(IntRect(0,0,frameWidth_,frameHeight_),damage_);
+    damageBounds_ = unite(damageBounds_,damage_);
+    hasDamage_ = true;
+
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(damage_.left_,damage_.top_,damage_.width_,damage_.height_);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void CanvasImpl::preserveFrame()
+{
+    flush();
+
+    if(frameTexture_ == 0 || frameTextureWidth_ < frameWidth_ || frameTextureHeight_ < frameHeight_)
+    {
+        GLint maximum = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE,&maximum);
+
+        const int width = nextPowerOfTwo(frameWidth_);
+        const int height = nextPowerOfTwo(frameHeight_);
+        if(width > maximum || height > maximum)
+        {
+            framePreserved_ = false;
+            return;
+        }
+
+        if(frameTexture_ == 0)
+        {
+            GLuint name = 0;
+            glGenTextures(1,&name);
+            frameTexture_ = name;
+        }
+
+        glPushAttrib(GL_TEXTURE_BIT);
+        glBindTexture(GL_TEXTURE_2D,frameTexture_);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_S,GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_WRAP_T,GL_CLAMP);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D,0,GL_RGB,width,height,0,GL_RGB,GL_UNSIGNED_BYTE,0);
+        glPopAttrib();
+
+        frameTextureWidth_ = width;
+        frameTextureHeight_ = height;
+        frameRestored_ = false;
+    }
+
+    // only the damaged part differs from the copy made last frame
+    IntRect area(0,0,frameWidth_,frameHeight_);
+    if(frameRestored_ && !area.intersects(damageBounds_,area))
+    {
+        framePreserved_ = true;
+        return;
+    }
+
+    glPushAttrib(GL_TEXTURE_BIT);
+    glBindTexture(GL_TEXTURE_2D,frameTexture_);
+    glCopyTexSubImage2D(GL_TEXTURE_2D,0,area.left_,area.top_,area.left_,area.top_,area.width_,area.height_);
+    glPopAttrib();
+    framePreserved_ = true;
 }
 
 void CanvasImpl::preRender(int width,int height)
 {
+    statistics_ = CanvasStatistics();
+
+    if(width != frameWidth_ || height != frameHeight_)
+        framePreserved_ = false;
+    frameWidth_ = width;
+    frameHeight_ = height;
+    frameRestored_ = false;
+    hasDamage_ = false;
+    damageBounds_ = IntRect();
+    boundTexture_ = unknownTexture;
+
     glPushClientAttrib(GL_CLIENT_ALL_ATTRIB_BITS);
     glPushAttrib(GL_ALL_ATTRIB_BITS);
 
@@ -361,6 +640,8 @@ void CanvasImpl::preRender(int width,int height)
 
 void CanvasImpl::postRender()
 {
+    lastStatistics_ = statistics_;
+
     glPopMatrix();
     glMatrixMode(GL_PROJECTION);
     glPopMatrix();
@@ -368,6 +649,7 @@ void CanvasImpl::postRender()
 
     glPopAttrib();
     glPopClientAttrib();
+    boundTexture_ = unknownTexture;
 }
 
 }
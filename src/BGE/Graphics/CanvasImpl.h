@@ -2,13 +2,23 @@
 #define BGE_GRAPHICS_CANVASIMPL_H
 #include <BGE/Graphics/Canvas.h>
 #include <BGE/Graphics/glfont/GLTextRenderer.h>
+#include <BGE/Graphics/glfont/FontRegistry.h>
 #include <BGE/System/Err.h>
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include <vector>
 
 namespace bge
 {
 
+//! glyph of a font atlas placed on the canvas,uv coordinates index the atlas texture
+struct GlyphQuad
+{
+    FloatRect rectangle_;
+    Vector2f topLeftUV_;
+    Vector2f bottomRightUV_;
+};
+
 class CanvasImpl : public Canvas
 {
 public:
@@ -31,6 +41,7 @@ public:
     void drawImage(Image* image,const FloatRect& rect,bool tiled,float minx,float miny, float maxx, float maxy);
     void enableTexturing(Image* image);
 	TextRenderer* createText(const std::string& name,int point);
+    FontStatistics fontStatistics()const;
     void disableTexturing();
     void registerImage(Image* image);
     void unregisterImage(int32_t handle);
@@ -40,8 +51,32 @@ public:
 
     void preRender(int width,int height);
     void postRender();
+    void flush(){}
+    CanvasStatistics statistics()const{return lastStatistics_;}
+
+    bool restoreFrame();
+    void setDamage(const FloatRect& rectangle);
+    void preserveFrame();
 public:
     FT_Library& ftLibrary(){return library_;}
+    Font::FontRegistry& fontRegistry(){return *fontRegistry_;}
+    //! draws alpha glyphs of one atlas texture in the current color
+    virtual void drawGlyphs(uint32_t texture,const GlyphQuad* quads,size_t count);
+protected:
+    //! binds texture unless it is known to be bound already
+    void bindTexture(uint32_t texture);
+protected:
+    //! scissor box of rectangle in framebuffer coordinates,restricted to the damaged area if there is one
+    IntRect scissorOf(const FloatRect& rectangle)const;
+    //! rectangle in framebuffer coordinates,rounded the way scissor boxes are
+    IntRect framebufferRect(const FloatRect& rectangle)const;
+protected:
+    CanvasStatistics statistics_;
+    CanvasStatistics lastStatistics_;
+    bool hasDamage_;
+    IntRect damage_;
+    //! texture bound as far as the canvas knows,textures bound elsewhere must restore the binding
+    uint32_t boundTexture_;
 private:
 	class FontDetails
 	{
@@ -72,6 +107,18 @@ private:
 	};
     std::map<FontDetails,Font::GLTextRenderer*> fontMap_;
 	FT_Library library_;
+    Font::FontRegistry* fontRegistry_;
+
+    int frameWidth_;
+    int frameHeight_;
+    //! copy of the previous frame,the texture is the next power of two in size
+    uint32_t frameTexture_;
+    int frameTextureWidth_;
+    int frameTextureHeight_;
+    bool framePreserved_;
+    bool frameRestored_;
+    IntRect damageBounds_;
+    std::vector<float> glyphVertices_;
 };
 
 }
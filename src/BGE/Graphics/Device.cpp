@@ -4,6 +4,14 @@
 #include <glfw/glfw3.h>
 #include <iostream>
 
+#if GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR < 2
+#define BGE_GLFW_NO_WAIT_TIMEOUT
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace bge
 {
 
@@ -29,7 +37,7 @@ void GLFWwindowclosefun_(GLFWwindow* window)
 
 void GLFWwindowrefreshfun_(GLFWwindow* window)
 {
-
+    WindowManager::instance().invalidate();
 }
 
 void GLFWwindowfocusfun_(GLFWwindow* window,int flag)
@@ -104,12 +112,78 @@ void GLFWmonitorfun_(GLFWmonitor* monitor,int flag)
 
 }
 
+#ifdef BGE_GLFW_NO_WAIT_TIMEOUT
+//! glfw 3.1 has no timed wait,a helper thread posts an empty event when the deadline passes
+class EventWaker
+{
+    typedef std::chrono::steady_clock Clock;
+public:
+    EventWaker():
+        armed_(false),
+        quit_(false),
+        thread_(&EventWaker::run,this)
+    {
+    }
+
+    ~EventWaker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            quit_ = true;
+        }
+        condition_.notify_one();
+        thread_.join();
+    }
+
+    void arm(float seconds)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            deadline_ = Clock::now() + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(seconds));
+            armed_ = true;
+        }
+        condition_.notify_one();
+    }
+
+    void disarm()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        armed_ = false;
+    }
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while(!quit_)
+        {
+            if(!armed_)
+                condition_.wait(lock);
+            else if(condition_.wait_until(lock,deadline_) == std::cv_status::timeout && armed_)
+            {
+                armed_ = false;
+                glfwPostEmptyEvent();
+            }
+        }
+    }
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    Clock::time_point deadline_;
+    bool armed_;
+    bool quit_;
+    std::thread thread_;
+};
+#endif
+
 class DeviceImpl : public Device
 {
 public:
     DeviceImpl()
     {
         mWindow = 0;
+#ifdef BGE_GLFW_NO_WAIT_TIMEOUT
+        mWaker = 0;
+#endif
     }
 
     ~DeviceImpl()
@@ -124,6 +198,10 @@ public:
 
     void terminate()
     {
+#ifdef BGE_GLFW_NO_WAIT_TIMEOUT
+        delete mWaker;
+        mWaker = 0;
+#endif
         glfwTerminate();
     }
 
@@ -156,12 +234,14 @@ public:
 
         glfwMakeContextCurrent(mWindow);
         WindowManager::instance().applicationResized(width,height);
+        WindowManager::instance().setWakeUp(glfwPostEmptyEvent);
         glfwSwapInterval(1);
         return true;
     }
 
     void closeWindow()
     {
+        WindowManager::instance().setWakeUp(0);
         if(mWindow)
             glfwDestroyWindow(mWindow);
         mWindow = 0;
@@ -207,12 +287,40 @@ public:
         glfwPollEvents();
     }
 
+    void waitEvents(float timeout)
+    {
+        if(timeout == 0.0f)
+        {
+            glfwPollEvents();
+            return;
+        }
+
+        if(timeout < 0.0f)
+        {
+            glfwWaitEvents();
+            return;
+        }
+
+#ifdef BGE_GLFW_NO_WAIT_TIMEOUT
+        if(!mWaker)
+            mWaker = new EventWaker();
+        mWaker->arm(timeout);
+        glfwWaitEvents();
+        mWaker->disarm();
+#else
+        glfwWaitEventsTimeout(timeout);
+#endif
+    }
+
     void deleteLater()
     {
         delete this;
     }
 private:
     GLFWwindow* mWindow;
+#ifdef BGE_GLFW_NO_WAIT_TIMEOUT
+    EventWaker* mWaker;
+#endif
 };
 
 
@@ -0,0 +1,828 @@
+#include <BGE/System/Err.h>
+#include <BGE/Graphics/SoftwareCanvas.h>
+#include <BGE/Graphics/TextRenderer.h>
+#include <BGE/Graphics/glfont/FontRegistry.h>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_SIZES_H
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BGE_SOFTWARE_CANVAS_SSE2
+#endif
+
+namespace bge
+{
+
+//! (value + 127) / 255 without a division
+static inline uint32_t divide255(uint32_t value)
+{
+    return (value + 1 + (value >> 8)) >> 8;
+}
+
+class SoftwareTextRenderer : public TextRenderer
+{
+    struct Glyph
+    {
+        std::vector<uint8_t> coverage_;
+        int width_;
+        int height_;
+        int left_;
+        int top_;
+        float advance_;
+    };
+public:
+    SoftwareTextRenderer(SoftwareCanvas* canvas,const std::string& font,size_t point):
+        TextRenderer(font,point),
+        canvas_(canvas),
+        face_(0),
+        size_(0),
+        hasKerning_(false)
+    {
+        if(!canvas->fontRegistry_)
+            return;
+
+        FT_Face face = canvas->fontRegistry_->acquire(font);
+        if(!face)
+            return;
+
+        if(FT_New_Size(face,&size_) != 0)
+        {
+            err()<<"failed to create a size of font "<<font<<"\n";
+            canvas->fontRegistry_->release(face);
+            return;
+        }
+
+        face_ = face;
+        FT_Activate_Size(size_);
+        // same metrics as the opengl type face
+        FT_Set_Char_Size(face_,0L,static_cast<FT_F26Dot6>(point << 6),100,100);
+        hasKerning_ = (FT_HAS_KERNING(face_) != 0);
+    }
+
+    ~SoftwareTextRenderer()
+    {
+        if(face_)
+        {
+            FT_Done_Size(size_);
+            canvas_->fontRegistry_->release(face_);
+        }
+    }
+public:
+    void render(const String& string,const FloatRect& rectangle,bool multiline,
+        Horizontal halignment,Vertical valignment)
+    {
+        if(!face_)
+            return;
+
+        if(!multiline)
+        {
+            renderLine(string.get(),Vector2f(penX(string.get(),rectangle,halignment),baseLineY(rectangle,valignment)));
+            return;
+        }
+
+        const std::basic_string<uint32_t> space(1,uint32_t(' '));
+        std::basic_string<uint32_t> text = string.get();
+        const float availableWidth = rectangle.width_ - 4.0f;
+        float y = baseLineY(rectangle,Vertical_top);
+        while(!text.empty())
+        {
+            size_t pos = hitCharacterIndex(text,availableWidth);
+            if(pos == std::basic_string<uint32_t>::npos)
+                pos = text.size();
+            if(pos == 0)
+                break;
+
+            std::basic_string<uint32_t> line = text.substr(0,pos);
+            if(pos < text.size() && text[0] != ' ' && line[line.size()-1] != ' ')
+            {
+                const size_t cut = line.find_last_of(space);
+                if(cut != std::basic_string<uint32_t>::npos)
+                {
+                    line = line.substr(0,cut);
+                    pos = cut;
+                }
+            }
+
+            const size_t first = line.find_first_not_of(space);
+            const size_t last = line.find_last_not_of(space);
+            line = first == std::basic_string<uint32_t>::npos ? std::basic_string<uint32_t>() : line.substr(first,last - first + 1);
+
+            renderLine(line,Vector2f(penX(line,rectangle,halignment),y));
+            text = text.substr(pos);
+            y += lineHeight();
+        }
+    }
+
+    float lineHeight()const
+    {
+        return ascent() + descent();
+    }
+
+    float width(const String& string)const
+    {
+        return width(string.get());
+    }
+
+    size_t hitCharacterIndex(const String& string,float offset)const
+    {
+        return hitCharacterIndex(string.get(),offset);
+    }
+private:
+    float ascent()const
+    {
+        return face_ ? float(size_->metrics.y_ppem) - descent() : 0.0f;
+    }
+
+    float descent()const
+    {
+        return face_ ? static_cast<float>(-size_->metrics.descender) / 64.0f : 0.0f;
+    }
+
+    float kerning(FT_UInt left,FT_UInt right)const
+    {
+        if(!hasKerning_ || left == 0 || right == 0)
+            return 0.0f;
+
+        FT_Vector vector;
+        FT_Activate_Size(size_);
+        if(FT_Get_Kerning(face_,left,right,FT_KERNING_DEFAULT,&vector) != 0)
+            return 0.0f;
+        return static_cast<float>(vector.x) / 64.0f;
+    }
+
+    const Glyph& glyph(FT_UInt index)const
+    {
+        std::map<FT_UInt,Glyph>::iterator itr = glyphs_.find(index);
+        if(itr != glyphs_.end())
+            return itr->second;
+
+        Glyph& glyph = glyphs_[index];
+        glyph.width_ = glyph.height_ = glyph.left_ = glyph.top_ = 0;
+        glyph.advance_ = 0.0f;
+
+        // the face is shared with the other sizes of the font
+        if(face_ && FT_Activate_Size(size_) == 0 && FT_Load_Glyph(face_,index,FT_LOAD_NO_HINTING | FT_LOAD_RENDER) == 0)
+        {
+            const FT_GlyphSlot slot = face_->glyph;
+            const FT_Bitmap& bitmap = slot->bitmap;
+            glyph.width_ = bitmap.width;
+            glyph.height_ = bitmap.rows;
+            glyph.left_ = slot->bitmap_left;
+            glyph.top_ = slot->bitmap_top;
+            glyph.advance_ = float(slot->advance.x >> 6);
+            glyph.coverage_.resize(glyph.width_ * glyph.height_);
+            for(int y = 0;y < glyph.height_;y++)
+                memcpy(&glyph.coverage_[y * glyph.width_],bitmap.buffer + y * bitmap.pitch,glyph.width_);
+        }
+        return glyph;
+    }
+
+    float width(const std::basic_string<uint32_t>& string)const
+    {
+        float ret = 0.0f;
+        FT_UInt left = 0;
+        for(size_t i = 0;i < string.size();i++)
+        {
+            const FT_UInt right = FT_Get_Char_Index(face_,string[i]);
+            ret += kerning(left,right) + glyph(right).advance_;
+            left = right;
+        }
+        return ret;
+    }
+
+    size_t hitCharacterIndex(const std::basic_string<uint32_t>& string,float offset)const
+    {
+        if(!face_ || offset < 0.0f)
+            return std::basic_string<uint32_t>::npos;
+
+        float oldOffset = 0.0f;
+        FT_UInt left = 0;
+        for(size_t i = 0;i < string.size();i++)
+        {
+            const FT_UInt right = FT_Get_Char_Index(face_,string[i]);
+            const float newOffset = oldOffset + kerning(left,right) + glyph(right).advance_;
+            if(newOffset >= offset && oldOffset <= offset)
+                return i;
+            left = right;
+            oldOffset = newOffset;
+        }
+        return std::basic_string<uint32_t>::npos;
+    }
+
+    float baseLineY(const FloatRect& rectangle,Vertical alignment)const
+    {
+        if(alignment == Vertical_vCenter)
+            return rectangle.top_ + floorf((rectangle.height_ - lineHeight()) * 0.5f) + ascent();
+        else if(alignment == Vertical_bottom)
+            return rectangle.top_ + rectangle.height_ - descent();
+        return rectangle.top_ + ascent();
+    }
+
+    float penX(const std::basic_string<uint32_t>& string,const FloatRect& rectangle,Horizontal alignment)const
+    {
+        if(alignment == Horizontal_hCenter)
+            return floorf(rectangle.left_ - width(string) * 0.5f + rectangle.width_ * 0.5f);
+        else if(alignment == Horizontal_right)
+            return rectangle.left_ + rectangle.width_ - width(string);
+        return rectangle.left_;
+    }
+
+    void renderLine(const std::basic_string<uint32_t>& string,const Vector2f& position)
+    {
+        float x = position.x_;
+        FT_UInt left = 0;
+        for(size_t i = 0;i < string.size();i++)
+        {
+            const FT_UInt right = FT_Get_Char_Index(face_,string[i]);
+            x += kerning(left,right);
+            const Glyph& current = glyph(right);
+            if(!current.coverage_.empty())
+                canvas_->blendMask(int(floorf(x)) + current.left_,int(floorf(position.y_)) - current.top_,
+                    &current.coverage_[0],current.width_,current.height_,current.width_);
+            x += current.advance_;
+            left = right;
+        }
+    }
+private:
+    SoftwareCanvas* canvas_;
+    FT_Face face_;
+    FT_Size size_;
+    bool hasKerning_;
+    mutable std::map<FT_UInt,Glyph> glyphs_;
+};
+
+SoftwareCanvas::SoftwareCanvas(uint8_t* buffer,int width,int height,int stride):
+    buffer_(0),
+    width_(0),
+    height_(0),
+    stride_(0),
+    lineWidth_(1.0f),
+    texture_(0),
+    library_(0),
+    fontRegistry_(0),
+    pixels_(0),
+    lastPixels_(0)
+{
+    color_[0] = color_[1] = color_[2] = color_[3] = 255;
+    background_[0] = background_[1] = background_[2] = background_[3] = 0;
+    setBuffer(buffer,width,height,stride);
+
+    FT_Library library;
+    if(FT_Init_FreeType(&library) != 0)
+        err()<<"failed to initialize freetype library.\n";
+    else
+    {
+        library_ = library;
+        fontRegistry_ = new Font::FontRegistry(library_);
+    }
+}
+
+SoftwareCanvas::~SoftwareCanvas()
+{
+    auto itr = fonts_.begin();
+    while(itr != fonts_.end())
+    {
+        delete itr->second;
+        itr ++;
+    }
+
+    delete fontRegistry_;
+    if(library_ && FT_Done_FreeType(library_) != 0)
+        err()<<"failed to terminate freetype library.\n";
+}
+
+SoftwareCanvas& SoftwareCanvas::setBuffer(uint8_t* buffer,int width,int height,int stride)
+{
+    buffer_ = buffer;
+    width_ = buffer ? width : 0;
+    height_ = buffer ? height : 0;
+    stride_ = stride > 0 ? stride : width * 4;
+    framePreserved_ = false;
+    setDamage(FloatRect());
+    return *this;
+}
+
+SoftwareCanvas& SoftwareCanvas::clear(const Color& color)
+{
+    packColor(color,background_);
+    for(int y = 0;y < height_;y++)
+    {
+        uint8_t* row = pixelAt(0,y);
+        for(int x = 0;x < width_;x++)
+            memcpy(row + x * 4,background_,4);
+    }
+    return *this;
+}
+
+void SoftwareCanvas::packColor(const Color& color,uint8_t* packed)const
+{
+    packed[0] = static_cast<uint8_t>(std::min(std::max(color.r_,0.0f),1.0f) * 255.0f + 0.5f);
+    packed[1] = static_cast<uint8_t>(std::min(std::max(color.g_,0.0f),1.0f) * 255.0f + 0.5f);
+    packed[2] = static_cast<uint8_t>(std::min(std::max(color.b_,0.0f),1.0f) * 255.0f + 0.5f);
+    packed[3] = static_cast<uint8_t>(std::min(std::max(color.a_,0.0f),1.0f) * 255.0f + 0.5f);
+}
+
+void SoftwareCanvas::blendPixel(uint8_t* pixel,const uint8_t* color,uint32_t alpha)
+{
+    // src * alpha + dst * (1 - alpha) on every channel like GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA
+    const uint32_t inverse = 255 - alpha;
+    pixel[0] = static_cast<uint8_t>(divide255(color[0] * alpha + pixel[0] * inverse));
+    pixel[1] = static_cast<uint8_t>(divide255(color[1] * alpha + pixel[1] * inverse));
+    pixel[2] = static_cast<uint8_t>(divide255(color[2] * alpha + pixel[2] * inverse));
+    pixel[3] = static_cast<uint8_t>(divide255(color[3] * alpha + pixel[3] * inverse));
+}
+
+void SoftwareCanvas::fillSpan(int y,int x0,int x1,const uint8_t* color)
+{
+    if(y < clipTop_ || y >= clipBottom_)
+        return;
+
+    x0 = std::max(x0,clipLeft_);
+    x1 = std::min(x1,clipRight_);
+    if(x0 >= x1)
+        return;
+
+    pixels_ += x1 - x0;
+    uint8_t* pixel = pixelAt(x0,y);
+    int count = x1 - x0;
+    const uint32_t alpha = color[3];
+
+    if(alpha == 255)
+    {
+        uint32_t value;
+        memcpy(&value,color,4);
+        if((reinterpret_cast<size_t>(pixel) & 3) == 0)
+        {
+            std::fill_n(reinterpret_cast<uint32_t*>(pixel),count,value);
+        }
+        else
+        {
+            for(int i = 0;i < count;i++)
+                memcpy(pixel + i * 4,&value,4);
+        }
+        return;
+    }
+
+    if(alpha == 0)
+        return;
+
+#ifdef BGE_SOFTWARE_CANVAS_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i inverse = _mm_set1_epi16(static_cast<short>(255 - alpha));
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i source = _mm_set_epi16(
+        static_cast<short>(color[3] * alpha),static_cast<short>(color[2] * alpha),
+        static_cast<short>(color[1] * alpha),static_cast<short>(color[0] * alpha),
+        static_cast<short>(color[3] * alpha),static_cast<short>(color[2] * alpha),
+        static_cast<short>(color[1] * alpha),static_cast<short>(color[0] * alpha));
+
+    while(count >= 4)
+    {
+        const __m128i destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixel));
+        __m128i low = _mm_unpacklo_epi8(destination,zero);
+        __m128i high = _mm_unpackhi_epi8(destination,zero);
+        low = _mm_add_epi16(_mm_mullo_epi16(low,inverse),source);
+        high = _mm_add_epi16(_mm_mullo_epi16(high,inverse),source);
+        low = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(low,one),_mm_srli_epi16(low,8)),8);
+        high = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(high,one),_mm_srli_epi16(high,8)),8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixel),_mm_packus_epi16(low,high));
+        pixel += 16;
+        count -= 4;
+    }
+#endif
+
+    for(int i = 0;i < count;i++)
+        blendPixel(pixel + i * 4,color,alpha);
+}
+
+void SoftwareCanvas::blendMask(int x,int y,const uint8_t* mask,int width,int height,int pitch)
+{
+    const int x0 = std::max(x,clipLeft_);
+    const int y0 = std::max(y,clipTop_);
+    const int x1 = std::min(x + width,clipRight_);
+    const int y1 = std::min(y + height,clipBottom_);
+
+    for(int row = y0;row < y1;row++)
+    {
+        const uint8_t* coverage = mask + (row - y) * pitch + (x0 - x);
+        uint8_t* pixel = pixelAt(x0,row);
+        for(int column = x0;column < x1;column++)
+        {
+            const uint32_t alpha = divide255(*coverage++ * color_[3]);
+            if(alpha != 0)
+                blendPixel(pixel,color_,alpha);
+            pixel += 4;
+        }
+        if(x1 > x0)
+            pixels_ += x1 - x0;
+    }
+}
+
+void SoftwareCanvas::fillConvex(const Vector2f* points,size_t count)
+{
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += static_cast<uint32_t>(count);
+
+    float top = points[0].y_;
+    float bottom = points[0].y_;
+    for(size_t i = 1;i < count;i++)
+    {
+        top = std::min(top,points[i].y_);
+        bottom = std::max(bottom,points[i].y_);
+    }
+
+    // a pixel is covered when its center is inside,edges are half open
+    const int y0 = std::max(int(ceilf(top - 0.5f)),clipTop_);
+    const int y1 = std::min(int(ceilf(bottom - 0.5f)),clipBottom_);
+    for(int y = y0;y < y1;y++)
+    {
+        const float center = float(y) + 0.5f;
+        float left = 1e30f;
+        float right = -1e30f;
+        for(size_t i = 0;i < count;i++)
+        {
+            const Vector2f& p = points[i];
+            const Vector2f& q = points[(i + 1) % count];
+            if((p.y_ <= center && center < q.y_) || (q.y_ <= center && center < p.y_))
+            {
+                const float x = p.x_ + (center - p.y_) * (q.x_ - p.x_) / (q.y_ - p.y_);
+                left = std::min(left,x);
+                right = std::max(right,x);
+            }
+        }
+        if(left < right)
+            fillSpan(y,int(ceilf(left - 0.5f)),int(ceilf(right - 0.5f)),color_);
+    }
+}
+
+void SoftwareCanvas::drawLine(const Vector2f& start,const Vector2f& end)
+{
+    const Vector2f direction = end - start;
+    const float length = sqrtf(direction.x_ * direction.x_ + direction.y_ * direction.y_);
+    if(length <= 0.0f)
+        return;
+
+    const float half = std::max(lineWidth_,1.0f) * 0.5f;
+    const Vector2f normal(-direction.y_ / length * half,direction.x_ / length * half);
+    const Vector2f quad[4] = {start + normal,end + normal,end - normal,start - normal};
+    fillConvex(quad,4);
+}
+
+void SoftwareCanvas::drawRectangle(const FloatRect& rectangle,bool filled)
+{
+    const float left = rectangle.left_;
+    const float top = rectangle.top_;
+    const float right = rectangle.left_ + rectangle.width_;
+    const float bottom = rectangle.top_ + rectangle.height_;
+
+    if(filled)
+    {
+        statistics_.drawCalls_ ++;
+        statistics_.vertices_ += 4;
+
+        const int x0 = int(ceilf(left - 0.5f));
+        const int x1 = int(ceilf(right - 0.5f));
+        const int y0 = std::max(int(ceilf(top - 0.5f)),clipTop_);
+        const int y1 = std::min(int(ceilf(bottom - 0.5f)),clipBottom_);
+        for(int y = y0;y < y1;y++)
+            fillSpan(y,x0,x1,color_);
+    }
+    else
+    {
+        const float width = lineWidth_;
+        const float halfwidth = width * 0.5f;
+        drawLine(Vector2f(left,top - halfwidth),Vector2f(right,top - halfwidth));
+        drawLine(Vector2f(right - halfwidth,top - width),Vector2f(right - halfwidth,bottom + width));
+        drawLine(Vector2f(right,bottom + halfwidth),Vector2f(left,bottom + halfwidth));
+        drawLine(Vector2f(left + halfwidth,bottom + width),Vector2f(left + halfwidth,top - width));
+    }
+}
+
+void SoftwareCanvas::drawGradientFilledRectangle(const FloatRect& rectangle,const Color& color1,const Color& color2,bool horizontal)
+{
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += 4;
+
+    uint8_t first[4],second[4];
+    packColor(color1,first);
+    packColor(color2,second);
+
+    const int x0 = std::max(int(ceilf(rectangle.left_ - 0.5f)),clipLeft_);
+    const int x1 = std::min(int(ceilf(rectangle.left_ + rectangle.width_ - 0.5f)),clipRight_);
+    const int y0 = std::max(int(ceilf(rectangle.top_ - 0.5f)),clipTop_);
+    const int y1 = std::min(int(ceilf(rectangle.top_ + rectangle.height_ - 0.5f)),clipBottom_);
+    if(x0 >= x1 || y0 >= y1)
+        return;
+
+    uint8_t color[4];
+    for(int y = y0;y < y1;y++)
+    {
+        if(!horizontal)
+        {
+            const float t = (float(y) + 0.5f - rectangle.top_) / rectangle.height_;
+            for(int i = 0;i < 4;i++)
+                color[i] = static_cast<uint8_t>(first[i] + (float(second[i]) - float(first[i])) * t + 0.5f);
+            fillSpan(y,x0,x1,color);
+            continue;
+        }
+
+        uint8_t* pixel = pixelAt(0,y);
+        for(int x = x0;x < x1;x++)
+        {
+            const float t = (float(x) + 0.5f - rectangle.left_) / rectangle.width_;
+            for(int i = 0;i < 4;i++)
+                color[i] = static_cast<uint8_t>(first[i] + (float(second[i]) - float(first[i])) * t + 0.5f);
+            blendPixel(pixel + x * 4,color,color[3]);
+        }
+        pixels_ += x1 - x0;
+    }
+}
+
+void SoftwareCanvas::drawCircleSegment(const Vector2f& center,float radius,float t1,float t2,uint32_t segments,bool filled)
+{
+    if(segments == 0)
+        return;
+
+    const float xtra = filled ? 0.0f : lineWidth_ * 0.5f;
+    const float outerRadius = radius + xtra;
+    const float innerRadius = filled ? 0.0f : radius - xtra;
+
+    const float step = (t2 - t1) / float(segments);
+    Vector2f direction(cosf(t1),-sinf(t1));
+    for(uint32_t i = 1;i <= segments;i++)
+    {
+        const float angle = t1 + step * float(i);
+        const Vector2f next(cosf(angle),-sinf(angle));
+        if(innerRadius <= 0.0f)
+        {
+            const Vector2f triangle[3] = {center,center + direction * outerRadius,center + next * outerRadius};
+            fillConvex(triangle,3);
+        }
+        else
+        {
+            const Vector2f quad[4] = {center + direction * innerRadius,center + direction * outerRadius,
+                                      center + next * outerRadius,center + next * innerRadius};
+            fillConvex(quad,4);
+        }
+        direction = next;
+    }
+}
+
+void SoftwareCanvas::drawCircle(const Vector2f& center,float radius,uint32_t segments,bool filled)
+{
+    drawCircleSegment(center,radius,0,2.0f*Math::PI32,segments,filled);
+}
+
+void SoftwareCanvas::drawRoundedRectangle(const FloatRect& rect,float radius,bool filled)
+{
+    const float r = radius;
+    const Vector2f bottomLeft(rect.left_,rect.top_+rect.height_);
+    const Vector2f topRight(rect.left_+rect.width_,rect.top_);
+    const Vector2f bottomLeftCenter  = bottomLeft + Vector2f(r, -r);
+    const Vector2f topRightCenter    = topRight + Vector2f(-r, r);
+    const Vector2f topLeftCenter     = Vector2f(bottomLeft.x_ + r, topRight.y_ + r);
+    const Vector2f bottomRightCenter = Vector2f(topRight.x_ - r, bottomLeft.y_ - r);
+
+    drawCircleSegment(topLeftCenter,     radius, Math::PI32*0.5f, Math::PI32,      9, filled);
+    drawCircleSegment(bottomRightCenter, radius, Math::PI32*1.5f, Math::PI32*2.0f, 9, filled);
+    drawCircleSegment(bottomLeftCenter,  radius, Math::PI32,      Math::PI32*1.5f, 9, filled);
+    drawCircleSegment(topRightCenter,    radius, 0,               Math::PI32*0.5f, 9, filled);
+
+    if(filled)
+    {
+        drawRectangle(FloatRect(topLeftCenter + Vector2f(-r, 0),bottomRightCenter + Vector2f(r, 0)-topLeftCenter-Vector2f(-r,0)), filled);
+        drawRectangle(FloatRect(topLeftCenter + Vector2f(0, -r),topRightCenter-topLeftCenter - Vector2f(0, -r)), filled);
+        drawRectangle(FloatRect(bottomLeftCenter,bottomRightCenter + Vector2f(0, r)-bottomLeftCenter), filled);
+    }
+    else
+    {
+        drawLine(bottomLeftCenter  + Vector2f(-r,  0), topLeftCenter     + Vector2f(-r,  0));
+        drawLine(bottomLeftCenter  + Vector2f( 0, -r), bottomRightCenter + Vector2f( 0, -r));
+        drawLine(bottomRightCenter + Vector2f( r,  0), topRightCenter    + Vector2f( r,  0));
+        drawLine(topLeftCenter     + Vector2f( 0,  r), topRightCenter    + Vector2f( 0,  r));
+    }
+}
+
+void SoftwareCanvas::drawDroppedRectangle(const FloatRect& rectangle,const Color& color1,const Color& color2)
+{
+    const float width = lineWidth_;
+    const float halfwidth = width * 0.5f;
+    const float left = rectangle.left_;
+    const float top = rectangle.top_;
+    const float right = rectangle.left_ + rectangle.width_;
+    const float bottom = rectangle.top_ + rectangle.height_;
+
+    setColor(color1);
+    drawLine(Vector2f(left,bottom - halfwidth),Vector2f(right,bottom - halfwidth));
+    drawLine(Vector2f(right - halfwidth,bottom - width),Vector2f(right - halfwidth,top + width));
+    setColor(color2);
+    drawLine(Vector2f(right,top + halfwidth),Vector2f(left,top + halfwidth));
+    drawLine(Vector2f(left + halfwidth,top + width),Vector2f(left + halfwidth,bottom - width));
+}
+
+void SoftwareCanvas::drawRaisedRectangle(const FloatRect& rectangle,const Color& color1,const Color& color2)
+{
+    drawDroppedRectangle(rectangle,color2,color1);
+}
+
+void SoftwareCanvas::drawTriangle(const Vector2f& p1,const Vector2f& p2,const Vector2f& p3,bool filled)
+{
+    if(filled)
+    {
+        const Vector2f triangle[3] = {p1,p2,p3};
+        fillConvex(triangle,3);
+    }
+    else
+    {
+        drawLine(p1,p2);
+        drawLine(p2,p3);
+        drawLine(p3,p1);
+    }
+}
+
+void SoftwareCanvas::drawImage(Image* image,const FloatRect& rect,bool tiled,float minx,float miny,float maxx,float maxy)
+{
+    enableTexturing(image);
+    setColor(Color(1.0f,1.0f,1.0f,1.0f));
+
+    statistics_.drawCalls_ ++;
+    statistics_.vertices_ += 4;
+
+    const Vector2i size = image->size();
+    const unsigned char* data = image->data();
+    const size_t bytes = image->numberOfBitsPerPixel() / 8;
+    if(!data || size.x_ <= 0 || size.y_ <= 0 || (bytes != 3 && bytes != 4))
+    {
+        disableTexturing();
+        return;
+    }
+
+    const int x0 = std::max(int(ceilf(rect.left_ - 0.5f)),clipLeft_);
+    const int x1 = std::min(int(ceilf(rect.left_ + rect.width_ - 0.5f)),clipRight_);
+    const int y0 = std::max(int(ceilf(rect.top_ - 0.5f)),clipTop_);
+    const int y1 = std::min(int(ceilf(rect.top_ + rect.height_ - 0.5f)),clipBottom_);
+
+    // a tiled image repeats its part of the texture at its own size from the top left corner
+    float tileWidth = tiled ? fabsf(maxx - minx) * size.x_ : 0.0f;
+    float tileHeight = tiled ? fabsf(maxy - miny) * size.y_ : 0.0f;
+    if(tileWidth < 1.0f || tileWidth >= rect.width_)
+        tileWidth = rect.width_;
+    if(tileHeight < 1.0f || tileHeight >= rect.height_)
+        tileHeight = rect.height_;
+
+    // the texel offset of every column is the same on each row
+    columns_.resize(std::max(x1 - x0,0));
+    for(int x = x0;x < x1;x++)
+    {
+        const float u = minx + fmodf(float(x) + 0.5f - rect.left_,tileWidth) / tileWidth * (maxx - minx);
+        int column = int(floorf(u * size.x_)) % size.x_;
+        if(column < 0)
+            column += size.x_;
+        columns_[x - x0] = column * bytes;
+    }
+
+    // the top edge maps to maxy and the bottom edge to miny,texture coordinates repeat
+    for(int y = y0;y < y1;y++)
+    {
+        const float v = maxy + fmodf(float(y) + 0.5f - rect.top_,tileHeight) / tileHeight * (miny - maxy);
+        int row = int(floorf(v * size.y_)) % size.y_;
+        if(row < 0)
+            row += size.y_;
+
+        const unsigned char* texels = data + row * size.x_ * bytes;
+        uint8_t* pixel = pixelAt(0,y);
+        for(int x = x0;x < x1;x++)
+        {
+            const unsigned char* texel = texels + columns_[x - x0];
+            const uint8_t color[4] = {texel[0],texel[1],texel[2],uint8_t(bytes == 4 ? texel[3] : 255)};
+            blendPixel(pixel + x * 4,color,color[3]);
+        }
+        if(x1 > x0)
+            pixels_ += x1 - x0;
+    }
+
+    disableTexturing();
+}
+
+void SoftwareCanvas::enableTexturing(Image* image)
+{
+    texture_ = image;
+}
+
+void SoftwareCanvas::disableTexturing()
+{
+    texture_ = 0;
+}
+
+void SoftwareCanvas::registerImage(Image*)
+{
+}
+
+void SoftwareCanvas::unregisterImage(int32_t)
+{
+}
+
+void SoftwareCanvas::enableClipRectangle(const FloatRect& rectangle)
+{
+    // same rounding as the opengl scissor rectangle
+    const int bottom = height_ - static_cast<int>(height_ - rectangle.top_ - rectangle.height_);
+    clipLeft_ = std::max(static_cast<int>(rectangle.left_),0);
+    clipRight_ = std::min(static_cast<int>(rectangle.left_) + static_cast<int>(rectangle.width_) + 1,width_);
+    clipTop_ = std::max(bottom - static_cast<int>(rectangle.height_) - 1,0);
+    clipBottom_ = std::min(bottom,height_);
+
+    clipLeft_ = std::max(clipLeft_,damageLeft_);
+    clipTop_ = std::max(clipTop_,damageTop_);
+    clipRight_ = std::max(std::min(clipRight_,damageRight_),clipLeft_);
+    clipBottom_ = std::max(std::min(clipBottom_,damageBottom_),clipTop_);
+}
+
+void SoftwareCanvas::disableClipRectangle()
+{
+    clipLeft_ = damageLeft_;
+    clipTop_ = damageTop_;
+    clipRight_ = damageRight_;
+    clipBottom_ = damageBottom_;
+}
+
+void SoftwareCanvas::setDamage(const FloatRect& rectangle)
+{
+    damageLeft_ = 0;
+    damageTop_ = 0;
+    damageRight_ = width_;
+    damageBottom_ = height_;
+
+    if(rectangle.width_ <= 0.0f || rectangle.height_ <= 0.0f)
+    {
+        disableClipRectangle();
+        return;
+    }
+
+    enableClipRectangle(rectangle);
+    damageLeft_ = clipLeft_;
+    damageTop_ = clipTop_;
+    damageRight_ = clipRight_;
+    damageBottom_ = clipBottom_;
+
+    for(int y = damageTop_;y < damageBottom_;y++)
+    {
+        uint8_t* row = pixelAt(0,y);
+        for(int x = damageLeft_;x < damageRight_;x++)
+            memcpy(row + x * 4,background_,4);
+    }
+}
+
+void SoftwareCanvas::setColor(const Color& color)
+{
+    packColor(color,color_);
+}
+
+void SoftwareCanvas::setLineWidth(float width)
+{
+    lineWidth_ = width;
+}
+
+float SoftwareCanvas::maximumLineWidth()const
+{
+    return 64.0f;
+}
+
+TextRenderer* SoftwareCanvas::createText(const std::string& name,int point)
+{
+    const std::string key = name + "#" + toString(point);
+    std::map<std::string,SoftwareTextRenderer*>::iterator itr = fonts_.find(key);
+    if(itr != fonts_.end())
+        return itr->second;
+
+    SoftwareTextRenderer* renderer = new SoftwareTextRenderer(this,name,point);
+    fonts_[key] = renderer;
+    return renderer;
+}
+
+FontStatistics SoftwareCanvas::fontStatistics()const
+{
+    return fontRegistry_ ? fontRegistry_->statistics() : FontStatistics();
+}
+
+void SoftwareCanvas::preRender(int width,int height)
+{
+    statistics_ = CanvasStatistics();
+    pixels_ = 0;
+    if(width != width_ || height != height_)
+        framePreserved_ = false;
+    setDamage(FloatRect());
+    lineWidth_ = 1.0f;
+}
+
+void SoftwareCanvas::postRender()
+{
+    lastStatistics_ = statistics_;
+    lastPixels_ = pixels_;
+}
+
+}
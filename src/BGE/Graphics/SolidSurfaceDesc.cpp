@@ -11,9 +11,9 @@ namespace bge
 
 IMPLEMENT_OBJECT(RenderDesc,Object)
 
-bool RenderDesc::loadProperty(TiXmlNode* node)
+bool RenderDesc::loadProperty(const PropertyNode& node)
 {
-    TiXmlNode* super = node->FirstChildElement("Object");
+    PropertyNode super = node.firstChild("Object");
     Object::loadProperty(super);
     return true;
 }
@@ -48,10 +48,10 @@ void SolidSurfaceDesc::draw(const FloatRect& area,Canvas* canvas)const
     canvas->setColor(Color(1,1,1,1));
 }
 
-bool SolidSurfaceDesc::loadProperty(TiXmlNode* node)
+bool SolidSurfaceDesc::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(color,node)
-    TiXmlNode* super = node->FirstChildElement("RenderDesc");
+    PropertyNode super = node.firstChild("RenderDesc");
     RenderDesc::loadProperty(super);
     return true;
 }
@@ -82,12 +82,12 @@ void GradientSurfaceDesc::draw(const FloatRect& area,Canvas* canvas)const
     canvas->setColor(Color(1,1,1,1));
 }
 
-bool GradientSurfaceDesc::loadProperty(TiXmlNode* node)
+bool GradientSurfaceDesc::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(color1,node)
     DESERIALIZE_OBJECT(color2,node)
     DESERIALIZE_OBJECT(orientation,node)
-    TiXmlNode* super = node->FirstChildElement("RenderDesc");
+    PropertyNode super = node.firstChild("RenderDesc");
     RenderDesc::loadProperty(super);
     return true;
 }
@@ -131,13 +131,13 @@ void RectangleDesc::draw(const FloatRect& area,Canvas* canvas)const
     canvas->setColor(Color(1,1,1,1));
 }
 
-bool RectangleDesc::loadProperty(TiXmlNode* node)
+bool RectangleDesc::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(color1,node)
     DESERIALIZE_OBJECT(color2,node)
     DESERIALIZE_OBJECT(style,node)
     DESERIALIZE_OBJECT(lineWidth,node)
-    TiXmlNode* super = node->FirstChildElement("RenderDesc");
+    PropertyNode super = node.firstChild("RenderDesc");
     RenderDesc::loadProperty(super);
     return true;
 }
@@ -227,7 +227,7 @@ size_t TextDesc::hitCharacterIndex(const String& string,float offset) const
     return index;
 }
 
-bool TextDesc::loadProperty(TiXmlNode* node)
+bool TextDesc::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(fileName,node)
     DESERIALIZE_OBJECT(pixelHeight,node)
@@ -238,7 +238,7 @@ bool TextDesc::loadProperty(TiXmlNode* node)
     DESERIALIZE_OBJECT(isMultiLine,node)
     DESERIALIZE_OBJECT(horizontalAlignment,node)
     DESERIALIZE_OBJECT(verticalAlignment,node)
-    TiXmlNode* super = node->FirstChildElement("RenderDesc");
+    PropertyNode super = node.firstChild("RenderDesc");
     RenderDesc::loadProperty(super);
     reloadTextRenderer();
     return true;
@@ -279,25 +279,26 @@ void DefaultCheckDesc::draw(const FloatRect& area,Canvas* canvas) const
     const Vector2f squareTopLeft = area.position();
     canvas->drawRectangle(FloatRect(squareTopLeft,Vector2f(edgeLength,edgeLength)), false);
 
-    GLfloat lineWidth = 1.0f;
-    glGetFloatv(GL_LINE_WIDTH, &lineWidth);
+    const float lineWidth = canvas->lineWidth();
 
+    canvas->flush();
     GLboolean isLineSmoothEnabled = false;
     glGetBooleanv(GL_LINE_SMOOTH, &isLineSmoothEnabled);
 
-    glLineWidth(2.0f);
+    canvas->setLineWidth(2.0f);
     glEnable(GL_LINE_SMOOTH);
     canvas->drawLine(squareTopLeft + Vector2f(3.0f, 3.0f),  squareTopLeft + Vector2f(edgeLength-3.0f, edgeLength-3.0f));
     canvas->drawLine(squareTopLeft + Vector2f(edgeLength-3.0f, 3.0f), squareTopLeft + Vector2f(3.0f, edgeLength-3.0f));
+    canvas->flush();
 
-    if(lineWidth != 2.0f) glLineWidth(lineWidth);
+    if(lineWidth != 2.0f) canvas->setLineWidth(lineWidth);
     if(!isLineSmoothEnabled) glDisable(GL_LINE_SMOOTH);
 }
 
-bool DefaultCheckDesc::loadProperty(TiXmlNode* node)
+bool DefaultCheckDesc::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(color,node)
-    TiXmlNode* super = node->FirstChildElement("RenderDesc");
+    PropertyNode super = node.firstChild("RenderDesc");
     RenderDesc::loadProperty(super);
     return true;
 }
@@ -396,13 +397,13 @@ void DefaultFrameDesc::draw(const FloatRect& area,Canvas* canvas) const
     canvas->setLineWidth(1);
 }
 
-bool DefaultFrameDesc::loadProperty(TiXmlNode* node)
+bool DefaultFrameDesc::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(section,node)
     DESERIALIZE_OBJECT(foregroundColor,node)
     DESERIALIZE_OBJECT(backgroundColor,node)
     DESERIALIZE_OBJECT(borderLineWidth,node)
-    TiXmlNode* super = node->FirstChildElement("RenderDesc");
+    PropertyNode super = node.firstChild("RenderDesc");
     RenderDesc::loadProperty(super);
     return true;
 }
@@ -460,7 +461,7 @@ void BitmapDesc::draw(const FloatRect& area,Canvas* canvas) const
     }
 }
 
-bool BitmapDesc::loadProperty(TiXmlNode* node)
+bool BitmapDesc::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(fileName,node)
     DESERIALIZE_OBJECT(mapping,node)
@@ -468,7 +469,7 @@ bool BitmapDesc::loadProperty(TiXmlNode* node)
     DESERIALIZE_OBJECT(left,node)
     DESERIALIZE_OBJECT(bottom,node)
     DESERIALIZE_OBJECT(right,node)
-    TiXmlNode* super = node->FirstChildElement("RenderDesc");
+    PropertyNode super = node.firstChild("RenderDesc");
     RenderDesc::loadProperty(super);
 
     if(image_ != 0)
@@ -537,11 +538,11 @@ void Bitmap1x3Desc::draw(const FloatRect& area,Canvas* canvas) const
     }
 }
 
-bool Bitmap1x3Desc::loadProperty(TiXmlNode* node)
+bool Bitmap1x3Desc::loadProperty(const PropertyNode& node)
 {
     DESERIALIZE_OBJECT(leftOffset,node)
     DESERIALIZE_OBJECT(rightOffset,node)
-    TiXmlNode* super = node->FirstChildElement("BitmapDesc");
+    PropertyNode super = node.firstChild("BitmapDesc");
     return BitmapDesc::loadProperty(super);
 }
 
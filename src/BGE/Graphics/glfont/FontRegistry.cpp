@@ -0,0 +1,112 @@
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <BGE/System/Log.h>
+#include <BGE/System/IO.h>
+#include <BGE/Graphics/glfont/FontRegistry.h>
+
+namespace bge
+{
+
+namespace Font
+{
+
+//! Reads the whole file, returns false if it cannot be opened or read completely
+bool readFontFile(const std::string& aFileName, std::vector<unsigned char>& aData)
+{
+    IOReader* reader = FileSystem::instance().readFile(aFileName);
+    if(!reader)
+        return false;
+
+    aData.resize(reader->size());
+    const bool ret = !aData.empty() && reader->read(&aData[0], 1, aData.size()) == aData.size();
+    reader->close();
+    reader->deleteLater();
+    return ret;
+}
+
+FontRegistry::FontRegistry(FT_LibraryRec_* aLibrary) :
+    library_(aLibrary)
+{
+}
+
+FontRegistry::~FontRegistry()
+{
+    for(FontFiles::iterator itr = files_.begin(); itr != files_.end(); ++itr)
+    {
+        FT_Done_Face(itr->second->face_);
+        delete itr->second;
+    }
+}
+
+FT_FaceRec_* FontRegistry::acquire(const std::string& aFileName)
+{
+    FontFiles::iterator itr = files_.find(aFileName);
+    if(itr != files_.end())
+    {
+        itr->second->users_++;
+        return itr->second->face_;
+    }
+
+    FontFile* file = new FontFile();
+    file->face_ = 0;
+    file->users_ = 1;
+    if(!readFontFile(aFileName, file->data_))
+    {
+        BGE_LOG_ERROR(LogCategory_font) << "failed to load font " << aFileName << " (failed to read the file)";
+        delete file;
+        return 0;
+    }
+
+    FT_Face face = 0;
+    if(FT_New_Memory_Face(library_, &file->data_[0], static_cast<FT_Long>(file->data_.size()), 0, &face) != 0)
+    {
+        BGE_LOG_ERROR(LogCategory_font) << "failed to load font " << aFileName << " (failed to create the font face)";
+        delete file;
+        return 0;
+    }
+
+    if(FT_Select_Charmap(face, FT_ENCODING_UNICODE) != 0)
+    {
+        BGE_LOG_ERROR(LogCategory_font) << "failed to load font " << aFileName << " (failed to set the Unicode character set)";
+        FT_Done_Face(face);
+        delete file;
+        return 0;
+    }
+
+    file->face_ = face;
+    files_[aFileName] = file;
+    return face;
+}
+
+void FontRegistry::release(FT_FaceRec_* aFace)
+{
+    for(FontFiles::iterator itr = files_.begin(); itr != files_.end(); ++itr)
+    {
+        if(itr->second->face_ != aFace)
+            continue;
+
+        if(--itr->second->users_ == 0)
+        {
+            FT_Done_Face(aFace);
+            delete itr->second;
+            files_.erase(itr);
+        }
+        return;
+    }
+}
+
+FontStatistics FontRegistry::statistics() const
+{
+    FontStatistics ret;
+    for(FontFiles::const_iterator itr = files_.begin(); itr != files_.end(); ++itr)
+    {
+        ret.files_++;
+        ret.users_ += static_cast<uint32_t>(itr->second->users_);
+        ret.bytes_ += itr->second->data_.size();
+    }
+    return ret;
+}
+
+}
+
+}
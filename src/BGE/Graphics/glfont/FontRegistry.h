@@ -0,0 +1,54 @@
+#ifndef BGE_FONT_FONT_REGISTRY_H
+#define BGE_FONT_FONT_REGISTRY_H
+#include <BGE/Graphics/Canvas.h>
+#include <map>
+#include <string>
+#include <vector>
+
+struct FT_FaceRec_;
+struct FT_LibraryRec_;
+
+namespace bge
+{
+
+namespace Font
+{
+
+//! \brief Keeps every font file in memory once, no matter how many sizes are rendered from it
+//! \note FreeType reads the face straight from the loaded bytes instead of going through the file
+//! system for every table access. All users of a file share one face, each of them creates its own
+//! size object and activates it before asking the face for anything size dependent.
+class FontRegistry
+{
+public:
+    explicit FontRegistry(FT_LibraryRec_* aLibrary);
+    ~FontRegistry();
+public:
+    //! \brief Returns the face stored in the passed in file with the unicode charmap selected
+    //! \returns 0 if the file cannot be read or is not a font, otherwise the face must be given back
+    //! with release()
+    FT_FaceRec_* acquire(const std::string& aFileName);
+
+    //! Gives back a face returned by acquire(), the file is dropped with its last user
+    void release(FT_FaceRec_* aFace);
+
+    //! Returns the number of files and users and the bytes held for them
+    FontStatistics statistics() const;
+private:
+    struct FontFile
+    {
+        std::vector<unsigned char> data_;  //!< The whole font file, FreeType reads the face from here
+        FT_FaceRec_*               face_;  //!< The face shared by all users
+        size_t                     users_; //!< Number of acquire() calls not released yet
+    };
+    typedef std::map<std::string, FontFile*> FontFiles;
+
+    FT_LibraryRec_* library_;
+    FontFiles       files_;
+};
+
+}
+
+}
+
+#endif
@@ -1,7 +1,7 @@
 #include <map>
 #include <cstddef>
 #include <BGE/Graphics/OpenGL.h>
-#include <BGE/Graphics/Canvas.h>
+#include <BGE/Graphics/CanvasImpl.h>
 #include <BGE/Graphics/glfont/GLTextRenderer.h>
 #include <BGE/Graphics/glfont/TypeFace.h>
 
@@ -11,9 +11,10 @@ namespace bge
 namespace Font
 {
 
-GLTextRenderer::GLTextRenderer(const std::string& fontName,size_t pointSize) :
+GLTextRenderer::GLTextRenderer(CanvasImpl* canvas,const std::string& fontName,size_t pointSize) :
     TextRenderer(fontName,pointSize),
-    typeFace_(new TypeFace(fontName,pointSize)),
+    canvas_(canvas),
+    typeFace_(new TypeFace(canvas->fontRegistry(),fontName,pointSize)),
     fontName_(fontName)
 {
 }
@@ -38,7 +39,7 @@ void GLTextRenderer::render(const String& aString, const FloatRect& aRectangle,
                 penX(aString, aRectangle, aHorizontalAlignment),
                 baseLineY(aRectangle, aVerticalAlignment)
                 );
-            typeFace_->render(aString, position);
+            typeFace_->render(*canvas_, aString, position);
         }
     }
 }
@@ -58,6 +59,22 @@ size_t GLTextRenderer::hitCharacterIndex(const String& aString, float anOffset)
     return typeFace_->hitCharacterIndex(aString, anOffset);
 }
 
+KerningStatistics GLTextRenderer::kerningStatistics() const
+{
+    return typeFace_->kerningStatistics();
+}
+
+TextRenderer& GLTextRenderer::setAtlasBudget(size_t aBytes)
+{
+    typeFace_->setAtlasBudget(aBytes);
+    return *this;
+}
+
+GlyphAtlasStatistics GLTextRenderer::atlasStatistics() const
+{
+    return typeFace_->atlasStatistics();
+}
+
 float GLTextRenderer::baseLineY(const FloatRect& aRectangle,Vertical anAlignment) const
 {
     float ret = 0.0f;
@@ -158,7 +175,7 @@ void GLTextRenderer::renderMultiline(const String& aString, const FloatRect& aRe
             line.erase(0, line.find_first_not_of(" "));
             line.erase(line.find_last_not_of(" ")+1, line.length());
 
-            typeFace_->render(line, Vector2f(penX(line, aRectangle, aHorizontalAlignment), y));
+            typeFace_->render(*canvas_, line, Vector2f(penX(line, aRectangle, aHorizontalAlignment), y));
 
             // update txt to be whatever remains after taking the line off the front
             txt = txt.substr(p, txt.length());
@@ -9,6 +9,7 @@ namespace bge
     {
         class TypeFace;
     }
+    class CanvasImpl;
 }
 
 namespace bge
@@ -20,7 +21,7 @@ namespace Font
 class GLTextRenderer : public TextRenderer
 {
 public:
-    GLTextRenderer(const std::string& fontName,size_t pointSize);
+    GLTextRenderer(CanvasImpl* canvas,const std::string& fontName,size_t pointSize);
     virtual ~GLTextRenderer();
 public:
     virtual void render(const String& string,const FloatRect& rectangle,bool isMultiLine,
@@ -28,11 +29,15 @@ public:
     virtual float width(const String& string) const;
     virtual float lineHeight() const;
     virtual size_t hitCharacterIndex(const String& string, float offset) const;
+    virtual KerningStatistics kerningStatistics() const;
+    virtual TextRenderer& setAtlasBudget(size_t bytes);
+    virtual GlyphAtlasStatistics atlasStatistics() const;
 private:
     float baseLineY(const FloatRect& aRectangle,Vertical anAlignment) const;
     float penX(const String& aString, const FloatRect& aRectangle,Horizontal anAlignment) const;
     void renderMultiline(const String& aString, const FloatRect& aRectangle,Horizontal aHorizontalAlignment);
  
+    CanvasImpl* canvas_;
     TypeFace*  typeFace_;   
     std::string fontName_; 
 };
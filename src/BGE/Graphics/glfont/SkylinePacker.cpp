@@ -0,0 +1,142 @@
+#include <BGE/Graphics/glfont/SkylinePacker.h>
+#include <algorithm>
+
+namespace bge
+{
+
+namespace Font
+{
+
+SkylinePacker::SkylinePacker(int aWidth, int aHeight)
+{
+    reset(aWidth, aHeight);
+}
+
+void SkylinePacker::reset(int aWidth, int aHeight)
+{
+    width_ = aWidth;
+    height_ = aHeight;
+    usedArea_ = 0;
+
+    skyline_.clear();
+    Segment segment;
+    segment.x_ = 0;
+    segment.y_ = 0;
+    segment.width_ = aWidth;
+    skyline_.push_back(segment);
+}
+
+bool SkylinePacker::insert(const Vector2i& aSize, Vector2i& aPosition)
+{
+    const int width = aSize.width();
+    const int height = aSize.height();
+    if(width <= 0 || height <= 0)
+    {
+        aPosition = Vector2i(0, 0);
+        return true;
+    }
+
+    size_t best = skyline_.size();
+    int bestBottom = 0;
+    int bestWaste = 0;
+    int bestY = 0;
+    for(size_t i = 0; i < skyline_.size(); ++i)
+    {
+        int waste = 0;
+        const int y = fit(i, width, height, waste);
+        if(y < 0)
+            continue;
+
+        const int bottom = y + height;
+        if(best == skyline_.size() || bottom < bestBottom || (bottom == bestBottom && waste < bestWaste))
+        {
+            best = i;
+            bestBottom = bottom;
+            bestWaste = waste;
+            bestY = y;
+        }
+    }
+
+    if(best == skyline_.size())
+        return false;
+
+    aPosition = Vector2i(skyline_[best].x_, bestY);
+    raise(best, skyline_[best].x_, bestY + height, width);
+    usedArea_ += static_cast<size_t>(width) * static_cast<size_t>(height);
+    return true;
+}
+
+int SkylinePacker::fit(size_t anIndex, int aWidth, int aHeight, int& aWaste) const
+{
+    const int left = skyline_[anIndex].x_;
+    if(left + aWidth > width_)
+        return -1;
+
+    // the rectangle rests on the highest segment it spans
+    int y = 0;
+    int remaining = aWidth;
+    size_t i = anIndex;
+    while(remaining > 0)
+    {
+        y = std::max(y, skyline_[i].y_);
+        if(y + aHeight > height_)
+            return -1;
+        remaining -= skyline_[i].width_;
+        ++i;
+    }
+
+    aWaste = 0;
+    remaining = aWidth;
+    for(i = anIndex; remaining > 0; ++i)
+    {
+        const int spanned = std::min(remaining, skyline_[i].width_);
+        aWaste += (y - skyline_[i].y_) * spanned;
+        remaining -= spanned;
+    }
+    return y;
+}
+
+void SkylinePacker::raise(size_t anIndex, int aX, int aY, int aWidth)
+{
+    Segment segment;
+    segment.x_ = aX;
+    segment.y_ = aY;
+    segment.width_ = aWidth;
+    skyline_.insert(skyline_.begin() + anIndex, segment);
+
+    // cut away what the new segment covers
+    const int right = aX + aWidth;
+    size_t i = anIndex + 1;
+    while(i < skyline_.size() && skyline_[i].x_ < right)
+    {
+        const int end = skyline_[i].x_ + skyline_[i].width_;
+        if(end <= right)
+        {
+            skyline_.erase(skyline_.begin() + i);
+        }
+        else
+        {
+            skyline_[i].width_ = end - right;
+            skyline_[i].x_ = right;
+            break;
+        }
+    }
+
+    // neighbours at the same height become one segment
+    for(i = 0; i + 1 < skyline_.size(); )
+    {
+        if(skyline_[i].y_ == skyline_[i + 1].y_)
+        {
+            skyline_[i].width_ += skyline_[i + 1].width_;
+            skyline_.erase(skyline_.begin() + i + 1);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+}
+
+}
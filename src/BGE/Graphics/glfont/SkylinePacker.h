@@ -0,0 +1,58 @@
+#ifndef BGE_FONT_SKYLINE_PACKER_H
+#define BGE_FONT_SKYLINE_PACKER_H
+#include <BGE/System/Math.h>
+#include <vector>
+
+namespace bge
+{
+
+namespace Font
+{
+
+//! \brief Packs rectangles of arbitrary size into a fixed area
+//! \note The free space is described by the skyline of the rectangles placed so far, a new
+//! rectangle goes where its bottom edge stays nearest to the top, ties are broken by the area
+//! wasted above it.
+//! Space is only given back by clearing the packer.
+class SkylinePacker
+{
+public:
+    SkylinePacker(int aWidth = 0, int aHeight = 0);
+public:
+    //! Removes all rectangles and resizes the packed area
+    void reset(int aWidth, int aHeight);
+
+    //! \brief Finds room for a rectangle of the passed in size
+    //! \returns False if it does not fit anywhere, otherwise its top left corner is stored in aPosition
+    bool insert(const Vector2i& aSize, Vector2i& aPosition);
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+
+    //! Returns the area covered by the rectangles inserted since the last reset
+    size_t usedArea() const { return usedArea_; }
+private:
+    struct Segment
+    {
+        int x_;      //!< Left edge of the segment
+        int y_;      //!< Lowest free row above the segment
+        int width_;  //!< Width of the segment
+    };
+
+    //! Returns the row a rectangle placed at the passed in segment would start at, -1 if it does not fit
+    int fit(size_t anIndex, int aWidth, int aHeight, int& aWaste) const;
+
+    //! Raises the skyline under a newly placed rectangle
+    void raise(size_t anIndex, int aX, int aY, int aWidth);
+
+    int width_;
+    int height_;
+    size_t usedArea_;
+    std::vector<Segment> skyline_;  //!< Segments from left to right, they cover the whole width
+};
+
+}
+
+}
+
+#endif
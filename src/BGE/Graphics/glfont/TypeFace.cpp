@@ -1,15 +1,19 @@
 #include <cstddef>
 #include <vector>
+#include <deque>
 #include <map>
+#include <unordered_map>
 #include <cstring>
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include FT_SIZES_H
 #include FT_GLYPH_H
 #include <BGE/System/Math.h>
 #include <BGE/System/Err.h>
-#include <BGE/System/IO.h>
 #include <BGE/Graphics/OpenGL.h>
 #include <BGE/Graphics/CanvasImpl.h>
+#include <BGE/Graphics/glfont/FontRegistry.h>
+#include <BGE/Graphics/glfont/SkylinePacker.h>
 #include <BGE/GUI/WindowManager.h>
 #include <algorithm>
 #include "TypeFace.h"
@@ -17,74 +21,20 @@
 namespace bge
 {
 
-unsigned long read(FT_Stream rec,unsigned long offset,unsigned char* buffer,unsigned long count)
-{
-    IOReader* reader = (IOReader*)rec->descriptor.pointer;
-    if(!reader)
-        return 0;
-    reader->seek(offset,SEEK_SET);
-    return static_cast<unsigned long>(reader->read(reinterpret_cast<char*>(buffer),sizeof(unsigned char),count));
-}
-
-void close(FT_Stream rec)
-{
-}
-
-FT_Face getFaceByFileName(const std::string& filename,bool& ok)
-{
-    FT_Face face;
-    ok = false;
-
-    IOReader* reader = FileSystem::instance().readFile(filename);
-    if(!reader)
-    {
-        return face;
-    }
-
-    FT_StreamRec* rec = new FT_StreamRec;
-    std::memset(rec,0,sizeof(*rec));
-    rec->base = NULL;
-    rec->size = reader->size();
-    rec->pos = 0;
-    rec->descriptor.pointer = reader;
-    rec->read = read;
-    rec->close = close;
-
-    FT_Open_Args args;
-    args.flags  = FT_OPEN_STREAM;
-    args.stream = rec;
-    args.driver = 0;
-
-    CanvasImpl* canvas = (CanvasImpl*)WindowManager::instance().canvas();
-    if(FT_Open_Face(canvas->ftLibrary(),&args,0,&face) != 0)
-    {
-        err() << "failed to load font from stream (failed to create the font face)" << std::endl;
-        delete rec;
-        return face;
-    }
-
-    if(FT_Select_Charmap(face,FT_ENCODING_UNICODE) != 0)
-    {
-        err() << "failed to load font from stream (failed to set the Unicode character set)" << std::endl;
-        FT_Done_Face(face);
-        delete rec;
-        return face;
-    }
-    ok = true;
-    return face;
-}
-
 namespace Font
 {
 
 struct CacheEntry
 {
+    FT_UInt       glyphIndex_;     //!< Index of the glyph in the face
+    int32_t       kerningSlot_;    //!< Row and column in the dense kerning table, -1 if outside it
     size_t        textureIndex_;   //!< Index into the TypeFace's texture array
     Vector2f topLeftUV_;      //!< Texcoords for the top left corner of the glyph
     Vector2f bottomRightUV_;  //!< Texcoords for the bottom right corner of the glyph
     Vector2i    renderSize_;     //!< The size of the glyph in pixels on the render target
     Vector2f advance_;        //!< The character advance for the cached glyph
     Vector2f bitmapPosition_; //!< The offset from the pen to the top left corner of the bitmap
+    uint32_t      lastUse_;        //!< Value of the use clock when the glyph was last rendered
 };
 
 struct TextureInfo
@@ -92,35 +42,168 @@ struct TextureInfo
     typedef GLuint Handle; //!< typedef for a texture handle for an OpenGL texture
     Handle     handle_;    //!< The OpenGL texture handle
     Vector2i size_;      //!< The size of the texture in texels
+    SkylinePacker packer_; //!< The space taken by glyphs since the texture was last packed
+};
+
+//! \brief Maps characters straight to indices of cache entries.
+//! \note Characters of the basic multilingual plane are looked up in pages of 256 entries
+//! allocated on first use, the others in an open addressing hash table.
+class CharacterCache
+{
+public:
+    CharacterCache() :
+        pages_(pageCount), bits_(0), used_(0) {}
+
+    //! Returns the entry index cached for the character, -1 if there is none
+    int32_t find(uint32_t aCharacter) const
+    {
+        if(aCharacter < planeSize)
+        {
+            const std::vector<int32_t>& page = pages_[aCharacter >> pageBits];
+            return page.empty() ? -1 : page[aCharacter & pageMask];
+        }
+
+        if(used_ == 0)
+            return -1;
+
+        const size_t mask = keys_.size() - 1;
+        for(size_t i = slot(aCharacter); ; i = (i + 1) & mask)
+        {
+            if(keys_[i] == aCharacter)
+                return values_[i];
+            if(keys_[i] == emptyKey)
+                return -1;
+        }
+    }
+
+    void insert(uint32_t aCharacter, int32_t anIndex)
+    {
+        if(aCharacter < planeSize)
+        {
+            std::vector<int32_t>& page = pages_[aCharacter >> pageBits];
+            if(page.empty())
+                page.resize(pageMask + 1, -1);
+            page[aCharacter & pageMask] = anIndex;
+            return;
+        }
+
+        // keep the table at most half full so probe sequences stay short
+        if((used_ + 1) * 2 > keys_.size())
+            rehash(bits_ == 0 ? 4 : bits_ + 1);
+
+        const size_t mask = keys_.size() - 1;
+        size_t i = slot(aCharacter);
+        while(keys_[i] != emptyKey && keys_[i] != aCharacter)
+            i = (i + 1) & mask;
+
+        if(keys_[i] == emptyKey)
+            used_ ++;
+        keys_[i] = aCharacter;
+        values_[i] = anIndex;
+    }
+
+    void clear()
+    {
+        for(size_t i = 0; i < pages_.size(); ++i)
+            std::vector<int32_t>().swap(pages_[i]);
+        keys_.clear();
+        values_.clear();
+        bits_ = 0;
+        used_ = 0;
+    }
+private:
+    size_t slot(uint32_t aCharacter) const
+    {
+        return static_cast<size_t>((aCharacter * 2654435761u) >> (32 - bits_));
+    }
+
+    void rehash(size_t aBits)
+    {
+        std::vector<uint32_t> keys(size_t(1) << aBits, uint32_t(emptyKey));
+        std::vector<int32_t> values(keys.size(), -1);
+        keys.swap(keys_);
+        values.swap(values_);
+        bits_ = aBits;
+        used_ = 0;
+
+        for(size_t i = 0; i < keys.size(); ++i)
+        {
+            if(keys[i] != emptyKey)
+                insert(keys[i], values[i]);
+        }
+    }
+
+    enum
+    {
+        planeSize = 0x10000,
+        pageBits  = 8,
+        pageMask  = (1 << pageBits) - 1,
+        pageCount = planeSize >> pageBits
+    };
+    static const uint32_t emptyKey = 0xffffffff;
+
+    std::vector<std::vector<int32_t> > pages_; //!< Pages of the basic multilingual plane
+    std::vector<uint32_t> keys_;               //!< Characters beyond it, emptyKey marks a free slot
+    std::vector<int32_t>  values_;             //!< Entry indices of those characters
+    size_t                bits_;               //!< The hash table has 2^bits_ slots
+    size_t                used_;               //!< Number of occupied slots
+};
+
+const size_t denseKerningRange = 128; //!< Pairs of characters below this are kerned through a table
+
+//! \brief Kerning of glyph pairs which have been asked for before
+//! \note Pairs of ASCII characters are kept in a dense table, the others are hashed by glyph indices.
+struct KerningCache
+{
+    std::vector<Vector2f>                  dense_;  //!< Kerning indexed by both kerning slots
+    std::vector<uint8_t>                   known_;  //!< Set for the entries of dense_ already queried
+    std::unordered_map<uint64_t, Vector2f> pairs_;  //!< Kerning of the other pairs
+
+    void clear()
+    {
+        dense_.clear();
+        known_.clear();
+        pairs_.clear();
+    }
 };
 
 typedef std::vector<TextureInfo>      Textures;       //!< An array of textures
-typedef std::map<FT_UInt, CacheEntry> CharacterCache; //!< The cache maps glyphs to cache entries
+typedef std::deque<CacheEntry>        CacheEntries;   //!< Cached glyphs, entries never move once added
+typedef std::map<FT_UInt, size_t>     GlyphCache;     //!< Maps glyphs to cache entries, used on misses only
+
+const size_t noTexture = size_t(-1);          //!< Texture index of glyphs which are not in a texture
+const size_t defaultAtlasBudget = 8 << 20;    //!< Texture memory of a type face unless set otherwise
 
 struct Data
 {
-    Data(size_t aPointSize, size_t aResolution) :
-        pointSize_(aPointSize), resolution_(aResolution) {}
+    Data(FontRegistry& aRegistry, size_t aPointSize, size_t aResolution) :
+        registry_(aRegistry), pointSize_(aPointSize), resolution_(aResolution), face_(0), size_(0),
+        useClock_(0), generation_(0),
+        atlasBudget_(defaultAtlasBudget), defragmenting_(false), hasKerning_(false) {}
 
+    FontRegistry&  registry_;       //!< Owner of the face, shared with other sizes of the same file
     size_t         pointSize_;      //!< The size of the type face in points
     size_t         resolution_;     //!< The resolution of the type face in dpi
     FT_Face        face_;           //!< A handle to the FreeType face object
-    CharacterCache characterCache_; //!< The glyph cache
-    Vector2i offset_;         //!< The top left corner of the next glyph to be cached
+    FT_Size        size_;           //!< The scaled metrics of this type face, activated before the face is used
+    CacheEntries   entries_;        //!< The glyph cache
+    CharacterCache characterCache_; //!< Maps characters to the glyph cache
+    GlyphCache     glyphCache_;     //!< Maps glyphs to the glyph cache
     Textures       textures_;       //!< The texture sizes and handles obtained from OpenGL
+    uint32_t       useClock_;       //!< Advanced for every rendered string, stamps the glyphs used
+    uint32_t       generation_;     //!< Advanced whenever glyphs move in or leave the textures
+    size_t         atlasBudget_;    //!< Bytes the textures may take before glyphs are evicted
+    bool           defragmenting_;  //!< Set while the glyphs are packed again, the budget is not enforced then
+    GlyphAtlasStatistics atlasStatistics_; //!< Evictions and defragmentations so far
     bool           hasKerning_;     //!< Set to true if the type face supports kerning
+    KerningCache   kerningCache_;   //!< Kerning already queried from the face
+    KerningStatistics kerningStatistics_; //!< Kerning lookups served by and missing the cache
+    std::vector<std::vector<GlyphQuad> > quads_; //!< Quads of the string being rendered, one array per texture
 };
 
 const size_t glyphPadding = 1;     //!< Glyphs have padding around them to prevent filtering issues
 const float OneOver64 = 0.015625f; //!< A frequently used constant
 
-size_t nextHighestPowerOf2(size_t aValue)
-{
-    size_t v = aValue - 1;
-    for(int i = 16; i > 0; i >>= 1) v |= (v >> i);
-    return (v + 1);
-}
-
 size_t maximumTextureSize()
 {
     GLint maxSize = 0;
@@ -129,29 +212,13 @@ size_t maximumTextureSize()
     return static_cast<size_t>(maxSize);
 }
 
-size_t cacheTextureWidth(size_t aGlyphWidth, size_t numGlyphsToCache)
-{
-    size_t width = nextHighestPowerOf2( ( (aGlyphWidth + glyphPadding) * numGlyphsToCache) + glyphPadding );
-    if(width > maximumTextureSize()) width = maximumTextureSize();
-    return width;
-}
-
-Vector2i cacheTextureSize(const Vector2i& aGlyphSize, size_t numGlyphsToCache)
-{
-    size_t textureWidth = cacheTextureWidth(aGlyphSize.width(), numGlyphsToCache);
-
-    const size_t numGlyphsInRow = (textureWidth - (glyphPadding * 2)) / aGlyphSize.width();
-    const size_t requiredHeight = ((numGlyphsToCache / numGlyphsInRow) + 1) * aGlyphSize.height();
-    size_t textureHeight = nextHighestPowerOf2(requiredHeight);
-    if(textureHeight > maximumTextureSize()) textureHeight = maximumTextureSize();
-
-    return Vector2i(textureWidth, textureHeight);
-}
-
 void setPixelStorage()
 {
     glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
 
+    // The canvas tracks the bound texture, uploads must leave the binding as they found it
+    glPushAttrib(GL_TEXTURE_BIT);
+
     // Enforce a standard packing mode
     glPixelStorei( GL_UNPACK_SWAP_BYTES, GL_FALSE );
     glPixelStorei( GL_UNPACK_LSB_FIRST, GL_FALSE );
@@ -163,10 +230,11 @@ void setPixelStorage()
 
 void restorePixelStorage()
 {
+    glPopAttrib();
     glPopClientAttrib();
 }
 
-TextureInfo createCacheTexture(const Vector2i& aGlyphSize, size_t numGlyphsToCache)
+TextureInfo createCacheTexture(const Vector2i& aSize)
 {
     setPixelStorage();
 
@@ -180,7 +248,8 @@ TextureInfo createCacheTexture(const Vector2i& aGlyphSize, size_t numGlyphsToCac
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
-    info.size_ = cacheTextureSize(aGlyphSize, numGlyphsToCache);
+    info.size_ = aSize;
+    info.packer_.reset(aSize.width(), aSize.height());
 
     unsigned char* textureData = new unsigned char[info.size_.size()];
     memset(textureData, 0, info.size_.size());
@@ -194,27 +263,49 @@ TextureInfo createCacheTexture(const Vector2i& aGlyphSize, size_t numGlyphsToCac
     return info;
 }
 
+//! Copies the glyph bitmap to the texture, the padding right of and below it is cleared
 void blitGlyphToTexture(FT_Bitmap* aBitmap,const TextureInfo& aTextureInfo,const Vector2i& anOffset, const Vector2i& aGlyphSize)
 {
     setPixelStorage();
 
     const int pitch = aBitmap->pitch;
-    unsigned char* data = new unsigned char[aGlyphSize.size()];
+    const Vector2i paddedSize = aGlyphSize + Vector2i(glyphPadding, glyphPadding);
+    unsigned char* data = new unsigned char[paddedSize.size()];
+    memset(data, 0, paddedSize.size());
 
     for(size_t y = 0; y < aGlyphSize.height(); ++y)
     {
-        memcpy(data + (y * aGlyphSize.width()), aBitmap->buffer + (y * pitch), aGlyphSize.width());
+        memcpy(data + (y * paddedSize.width()), aBitmap->buffer + (y * pitch), aGlyphSize.width());
     }
 
     glBindTexture(GL_TEXTURE_2D, aTextureInfo.handle_);
     glTexSubImage2D(GL_TEXTURE_2D, 0, anOffset.x(), anOffset.y(),
-        aGlyphSize.width(), aGlyphSize.height(), GL_ALPHA, GL_UNSIGNED_BYTE, data);
+        paddedSize.width(), paddedSize.height(), GL_ALPHA, GL_UNSIGNED_BYTE, data);
 
     delete[] data;
 
     restorePixelStorage();
 }
 
+//! Loads the glyph with the passed in index and renders it to a bitmap, returns 0 on failure
+FT_Glyph loadBitmapGlyph(FT_Face aFace, size_t aGlyphIndex)
+{
+    if(FT_Load_Glyph(aFace, aGlyphIndex, FT_LOAD_NO_HINTING) != 0)
+        return 0;
+
+    FT_Glyph glyph;
+    if(FT_Get_Glyph(aFace->glyph, &glyph) != 0)
+        return 0;
+
+    const FT_Error bitmapError = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
+    if((bitmapError != 0) || (glyph->format != FT_GLYPH_FORMAT_BITMAP))
+    {
+        FT_Done_Glyph(glyph);
+        return 0;
+    }
+    return glyph;
+}
+
 struct DestroyTexture
 {
     //! The function that does the destroying
@@ -224,31 +315,34 @@ struct DestroyTexture
     }
 };
 
-TypeFace::TypeFace(const std::string& filename, size_t aPointSize, size_t aResolution) :
-    data_(new Data(aPointSize, aResolution))
+TypeFace::TypeFace(FontRegistry& aRegistry, const std::string& aFileName, size_t aPointSize, size_t aResolution) :
+    data_(new Data(aRegistry, aPointSize, aResolution))
 {
-    //ASSERT(FT_New_Face(FreeType::library(), aFaceName.c_str(), 0, &data_->face_) == 0);
-
-    //ASSERT(FT_IS_SCALABLE(data_->face_));
-    //ASSERT(FT_IS_SFNT(data_->face_));
-    bool valid_ = false;
-    data_->face_ = getFaceByFileName(filename,valid_);
-    if(!valid_)
+    data_->face_ = aRegistry.acquire(aFileName);
+    if(data_->face_ == 0)
         return;
 
-    if( !data_->face_->charmap) FT_Set_Charmap(data_->face_, data_->face_->charmaps[0]);
+    if(FT_New_Size(data_->face_, &data_->size_) != 0)
+    {
+        err() << "failed to create a size of font " << aFileName << std::endl;
+        aRegistry.release(data_->face_);
+        data_->face_ = 0;
+        return;
+    }
 
-    //ASSERT(
+    activateSize();
     FT_Set_Char_Size(data_->face_, 0L, static_cast<FT_F26Dot6>(aPointSize << 6), aResolution, aResolution);
-    // == 0);
-
     data_->hasKerning_ = (FT_HAS_KERNING(data_->face_) != 0);
 }
 
 TypeFace::~TypeFace()
 {
     flushCache();
-    FT_Done_Face(data_->face_);
+    if(data_->face_ != 0)
+    {
+        FT_Done_Size(data_->size_);
+        data_->registry_.release(data_->face_);
+    }
     delete data_;
 }
 
@@ -263,9 +357,8 @@ void TypeFace::setPointSize(size_t aPointSize)
     {
         data_->pointSize_ = aPointSize;
         const FT_F26Dot6 sz = static_cast<FT_F26Dot6>(aPointSize << 6);
-        //ASSERT(
-        FT_Set_Char_Size(data_->face_, sz, sz, data_->resolution_, data_->resolution_);
-        // == 0);
+        if(activateSize())
+            FT_Set_Char_Size(data_->face_, sz, sz, data_->resolution_, data_->resolution_);
         flushCache();
     }
 }
@@ -286,12 +379,12 @@ void TypeFace::setResolution(size_t aResolution)
 
 float TypeFace::ascent() const
 {
-    return float(data_->face_->size->metrics.y_ppem) - descent();
+    return data_->size_ ? float(data_->size_->metrics.y_ppem) - descent() : 0.0f;
 }
 
 float TypeFace::descent() const
 {
-    return static_cast<float>(-data_->face_->size->metrics.descender) * OneOver64;
+    return data_->size_ ? static_cast<float>(-data_->size_->metrics.descender) * OneOver64 : 0.0f;
 }
 
 float TypeFace::lineHeight() const
@@ -301,48 +394,87 @@ float TypeFace::lineHeight() const
 
 void TypeFace::flushCache()
 {
+    data_->entries_.clear();
     data_->characterCache_.clear();
+    data_->glyphCache_.clear();
+    data_->kerningCache_.clear();
     std::for_each(data_->textures_.begin(), data_->textures_.end(), DestroyTexture());
     data_->textures_.clear();
+    data_->generation_ ++;
 }
 
-void TypeFace::addNewTexture(const Vector2i& aGlyphSize)
+void TypeFace::setAtlasBudget(size_t aBytes)
 {
-    const size_t numUncachedGlyphs = data_->face_->num_glyphs - data_->characterCache_.size();
-    data_->textures_.push_back(createCacheTexture(aGlyphSize, numUncachedGlyphs));
-    data_->offset_.x_ = glyphPadding;
-    data_->offset_.y_ = glyphPadding;
+    data_->atlasBudget_ = aBytes;
+    if(atlasBytes() > aBytes)
+        defragment();
 }
 
-void TypeFace::render(const String& aString, const Vector2f& aPosition)
+GlyphAtlasStatistics TypeFace::atlasStatistics() const
 {
-    glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_HINT_BIT | GL_LINE_BIT | GL_PIXEL_MODE_BIT);
-    glEnable(GL_TEXTURE_2D);
+    GlyphAtlasStatistics ret = data_->atlasStatistics_;
+    ret.pages_ = static_cast<uint32_t>(data_->textures_.size());
+    ret.bytes_ = atlasBytes();
+    ret.budget_ = data_->atlasBudget_;
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    ret.glyphs_ = 0;
+    for(CacheEntries::const_iterator it = data_->entries_.begin(); it != data_->entries_.end(); ++it)
+    {
+        if(it->textureIndex_ != noTexture)
+            ret.glyphs_ ++;
+    }
 
-    glPushMatrix();
-    glTranslatef(aPosition.x(), aPosition.y(), 0.0f);
+    size_t used = 0;
+    for(Textures::const_iterator it = data_->textures_.begin(); it != data_->textures_.end(); ++it)
+        used += it->packer_.usedArea();
+    ret.occupancy_ = (ret.bytes_ > 0) ? float(used) / float(ret.bytes_) : 0.0f;
+    return ret;
+}
 
-    renderGlyphs(aString);
-    glPopMatrix();
-    glPopAttrib();
+size_t TypeFace::atlasBytes() const
+{
+    size_t ret = 0;
+    for(Textures::const_iterator it = data_->textures_.begin(); it != data_->textures_.end(); ++it)
+        ret += it->size_.size();
+    return ret;
+}
+
+void TypeFace::render(CanvasImpl& aCanvas, const String& aString, const Vector2f& aPosition)
+{
+    data_->useClock_ ++;
+
+    // quads made before glyphs were moved around in the textures are made again
+    uint32_t generation = 0;
+    do
+    {
+        generation = data_->generation_;
+        for(size_t i = 0; i < data_->quads_.size(); ++i)
+            data_->quads_[i].clear();
+        addGlyphQuads(aString, aPosition);
+    }
+    while(generation != data_->generation_);
+
+    for(size_t i = 0; i < data_->quads_.size(); ++i)
+    {
+        std::vector<GlyphQuad>& quads = data_->quads_[i];
+        if(!quads.empty())
+        {
+            aCanvas.drawGlyphs(data_->textures_[i].handle_, &quads[0], quads.size());
+            quads.clear();
+        }
+    }
 }
 
 float TypeFace::width(const String& aString)
 {
-    auto str = aString.get();
-    auto it = str.begin();
     float ret = 0;
-    size_t leftChar = 0;
-    while(it != str.end())
-    {
-        size_t rightChar = FT_Get_Char_Index(data_->face_, *it);
-        ret += kerning(leftChar, rightChar).x();
-        ret += cachedGlyph(rightChar).advance_.x();
-        leftChar = rightChar;
-        ++it;
+    const CacheEntry* left = 0;
+    for(String::ConstIterator it = aString.begin(); it != aString.end(); ++it)
+    {
+        const CacheEntry& entry = cachedCharacter(*it);
+        ret += kerning(left, entry).x();
+        ret += entry.advance_.x();
+        left = &entry;
     }
     return ret;
 }
@@ -354,16 +486,15 @@ size_t TypeFace::hitCharacterIndex(const String& aString, float anOffset)
     size_t characterIndex = 0;
     if(anOffset >= 0.0f)
     {
-        auto str = aString.get();
-        auto it = str.begin();
+        String::ConstIterator it = aString.begin();
         float oldOffset = 0;
-        size_t leftChar = 0;
-        while(it != str.end())
+        const CacheEntry* left = 0;
+        while(it != aString.end())
         {
             float newOffset = oldOffset;
-            size_t rightChar = FT_Get_Char_Index(data_->face_, *it);
-            newOffset += kerning(leftChar, rightChar).x();
-            newOffset += cachedGlyph(rightChar).advance_.x();
+            const CacheEntry& entry = cachedCharacter(*it);
+            newOffset += kerning(left, entry).x();
+            newOffset += entry.advance_.x();
 
             if( (newOffset >= anOffset) && (oldOffset <= anOffset) )
             {
@@ -371,7 +502,7 @@ size_t TypeFace::hitCharacterIndex(const String& aString, float anOffset)
                 break;
             }
 
-            leftChar = rightChar;
+            left = &entry;
             oldOffset = newOffset;
             ++characterIndex;
             ++it;
@@ -384,143 +515,279 @@ size_t TypeFace::hitCharacterIndex(const String& aString, float anOffset)
     return characterIndex;
 }
 
-void TypeFace::addCacheEntry(FT_GlyphRec_* aGlyph, FT_BitmapGlyphRec_* aBitmapGlyph, size_t aGlyphIndex, const Vector2i& aGlyphSize)
+Vector2i TypeFace::maximumGlyphSize() const
 {
-    const TextureInfo& textureInfo = *(data_->textures_.rbegin());
-
-    const Vector2i bottomRight = data_->offset_ + Vector2i(aGlyphSize);
+    if(data_->face_ == 0)
+        return Vector2i();
 
-    const float widthF  = static_cast<float>(textureInfo.size_.width());
-    const float heightF = static_cast<float>(textureInfo.size_.height());
+    FT_BBox& bounds = data_->face_->bbox;
+    float maxGlyphWidthF = static_cast<float>(bounds.xMax - bounds.xMin);
+    maxGlyphWidthF *= ( (float)data_->size_->metrics.x_ppem / (float)data_->face_->units_per_EM);
 
-    CacheEntry entry;
-    entry.topLeftUV_.setX(static_cast<float>(data_->offset_.x()) / widthF);
-    entry.topLeftUV_.setY(static_cast<float>(data_->offset_.y()) / heightF);
-    entry.bottomRightUV_.setX(static_cast<float>(bottomRight.x()) / widthF);
-    entry.bottomRightUV_.setY(static_cast<float>(bottomRight.y()) / heightF);
-    entry.textureIndex_ = data_->textures_.size() - 1;
-    entry.renderSize_ = aGlyphSize;
-    entry.advance_ = Vector2f(float(aGlyph->advance.x >> 16), float(aGlyph->advance.y >> 16));
-    entry.bitmapPosition_ = Vector2f(float(aBitmapGlyph->left), float(-aBitmapGlyph->top));
+    float maxGlyphHeightF = static_cast<float>(bounds.yMax - bounds.yMin);
+    maxGlyphHeightF *= ( (float)data_->size_->metrics.y_ppem / (float)data_->face_->units_per_EM);
 
-    data_->characterCache_[aGlyphIndex] = entry;
+    return Vector2i(static_cast<size_t>(maxGlyphWidthF), static_cast<size_t>(maxGlyphHeightF));
 }
 
-Vector2i TypeFace::maximumGlyphSize() const
+size_t TypeFace::cacheGlyph(size_t aGlyphIndex)
 {
-    FT_BBox& bounds = data_->face_->bbox;
-    float maxGlyphWidthF = static_cast<float>(bounds.xMax - bounds.xMin);
-    maxGlyphWidthF *= ( (float)data_->face_->size->metrics.x_ppem / (float)data_->face_->units_per_EM);
+    CacheEntry entry = CacheEntry();
+    entry.glyphIndex_ = static_cast<FT_UInt>(aGlyphIndex);
+    entry.kerningSlot_ = -1;
+    entry.textureIndex_ = noTexture;
+    entry.lastUse_ = data_->useClock_;
 
-    float maxGlyphHeightF = static_cast<float>(bounds.yMax - bounds.yMin);
-    maxGlyphHeightF *= ( (float)data_->face_->size->metrics.y_ppem / (float)data_->face_->units_per_EM);
+    // glyphs which cannot be loaded are cached empty, so they are not retried for every string
+    FT_Glyph glyph = activateSize() ? loadBitmapGlyph(data_->face_, aGlyphIndex) : 0;
+    if(glyph != 0)
+    {
+        FT_BitmapGlyph bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(glyph);
+        FT_Bitmap* bitmap = &bitmapGlyph->bitmap;
 
-    return Vector2i(static_cast<size_t>(maxGlyphWidthF), static_cast<size_t>(maxGlyphHeightF));
+        entry.renderSize_ = Vector2i(bitmap->width, bitmap->rows);
+        entry.advance_ = Vector2f(float(glyph->advance.x >> 16), float(glyph->advance.y >> 16));
+        entry.bitmapPosition_ = Vector2f(float(bitmapGlyph->left), float(-bitmapGlyph->top));
+        placeGlyph(entry, bitmap);
+        FT_Done_Glyph(glyph);
+    }
+
+    const size_t ret = data_->entries_.size();
+    data_->entries_.push_back(entry);
+    data_->glyphCache_[entry.glyphIndex_] = ret;
+    return ret;
 }
 
-void TypeFace::ensureTextureIsAvailable()
+bool TypeFace::placeGlyph(CacheEntry& anEntry, FT_Bitmap* aBitmap)
 {
-    const Vector2i maxGlyphSize = maximumGlyphSize();
+    if(anEntry.renderSize_.size() == 0)
+        return true;
 
-    if(data_->textures_.size() == 0)
+    const Vector2i paddedSize = anEntry.renderSize_ + Vector2i(glyphPadding, glyphPadding);
+    const int pageSize = static_cast<int>(maximumTextureSize());
+    if(paddedSize.width() > pageSize || paddedSize.height() > pageSize)
+        return false;
+
+    size_t textureIndex = 0;
+    Vector2i position;
+    if(!allocate(paddedSize, textureIndex, position, data_->defragmenting_))
     {
-        addNewTexture(maxGlyphSize);
+        defragment();
+        allocate(paddedSize, textureIndex, position, true);
     }
-    else
+
+    const TextureInfo& textureInfo = data_->textures_[textureIndex];
+    blitGlyphToTexture(aBitmap, textureInfo, position, anEntry.renderSize_);
+
+    const Vector2i bottomRight = position + anEntry.renderSize_;
+    const float widthF  = static_cast<float>(textureInfo.size_.width());
+    const float heightF = static_cast<float>(textureInfo.size_.height());
+    anEntry.topLeftUV_.setX(static_cast<float>(position.x()) / widthF);
+    anEntry.topLeftUV_.setY(static_cast<float>(position.y()) / heightF);
+    anEntry.bottomRightUV_.setX(static_cast<float>(bottomRight.x()) / widthF);
+    anEntry.bottomRightUV_.setY(static_cast<float>(bottomRight.y()) / heightF);
+    anEntry.textureIndex_ = textureIndex;
+    return true;
+}
+
+bool TypeFace::allocate(const Vector2i& aSize, size_t& aTextureIndex, Vector2i& aPosition, bool anOverBudget)
+{
+    for(size_t i = 0; i < data_->textures_.size(); ++i)
     {
-        const TextureInfo& textureInfo = *(data_->textures_.rbegin());
-        if(data_->offset_.x() > int(textureInfo.size_.width()) - int(maxGlyphSize.width()) - int(glyphPadding))
+        if(data_->textures_[i].packer_.insert(aSize, aPosition))
         {
-            data_->offset_.x_ = glyphPadding;
-            data_->offset_.y_ =  data_->offset_.y() + maxGlyphSize.height();
-
-            if(data_->offset_.y() > int(textureInfo.size_.height()) - int(maxGlyphSize.height()) - int(glyphPadding))
-            {
-                addNewTexture(maxGlyphSize);
-            }
+            aTextureIndex = i;
+            return true;
         }
     }
+
+    const size_t pageSize = maximumTextureSize();
+    if(!anOverBudget && !data_->textures_.empty() && atlasBytes() + pageSize * pageSize > data_->atlasBudget_)
+        return false;
+
+    data_->textures_.push_back(createCacheTexture(Vector2i(pageSize, pageSize)));
+    aTextureIndex = data_->textures_.size() - 1;
+    return data_->textures_.back().packer_.insert(aSize, aPosition);
 }
 
-void TypeFace::cacheGlyph(size_t aGlyphIndex)
+bool TypeFace::reloadGlyph(CacheEntry& anEntry)
 {
-    ensureTextureIsAvailable();
+    FT_Glyph glyph = activateSize() ? loadBitmapGlyph(data_->face_, anEntry.glyphIndex_) : 0;
+    if(glyph == 0)
+        return false;
+
+    const bool ret = placeGlyph(anEntry, &reinterpret_cast<FT_BitmapGlyph>(glyph)->bitmap);
+    FT_Done_Glyph(glyph);
+    return ret;
+}
 
-    const FT_Error loadError = FT_Load_Glyph(data_->face_, aGlyphIndex, FT_LOAD_NO_HINTING);
-    //ASSERT(loadError == 0);
-    if(loadError == 0)
+//! Orders glyphs by the time they were last used, most recent first
+struct MoreRecentlyUsed
+{
+    bool operator() (const CacheEntry* aLeft, const CacheEntry* aRight) const
     {
-        FT_Glyph glyph;
-        const FT_Error getError = FT_Get_Glyph( data_->face_->glyph, &glyph);
-        if(getError == 0)
-        {
-            const FT_Error bitmapError = FT_Glyph_To_Bitmap( &glyph, FT_RENDER_MODE_NORMAL, 0, 1);
-            if( (bitmapError == 0) && (glyph->format == FT_GLYPH_FORMAT_BITMAP) )
-            {
-                FT_BitmapGlyph bitmapGlyph = reinterpret_cast<FT_BitmapGlyph>(glyph);
-                FT_Bitmap* bitmap = &bitmapGlyph->bitmap;
+        return aLeft->lastUse_ > aRight->lastUse_;
+    }
+};
+
+//! Orders glyphs by height, the tallest first, the skyline stays flatter that way
+struct Taller
+{
+    bool operator() (const CacheEntry* aLeft, const CacheEntry* aRight) const
+    {
+        return aLeft->renderSize_.height() > aRight->renderSize_.height();
+    }
+};
 
-                const Vector2i glyphSize(bitmap->width, bitmap->rows);
+void TypeFace::defragment()
+{
+    // queued quads refer to where the glyphs are now
+    WindowManager::instance().canvas()->flush();
+    data_->defragmenting_ = true;
 
-                if(glyphSize.size() > 0)
-                    blitGlyphToTexture(bitmap, *(data_->textures_.rbegin()), data_->offset_, glyphSize);
+    std::vector<CacheEntry*> resident;
+    for(CacheEntries::iterator it = data_->entries_.begin(); it != data_->entries_.end(); ++it)
+    {
+        if(it->textureIndex_ != noTexture)
+            resident.push_back(&*it);
+    }
+    std::sort(resident.begin(), resident.end(), MoreRecentlyUsed());
 
-                addCacheEntry(glyph, bitmapGlyph, aGlyphIndex, glyphSize);
-                data_->offset_.setX(data_->offset_.x() + glyphSize.width() + glyphPadding);
-            }
+    // the glyphs used least recently are evicted until half of the budget is free,
+    // glyphs of the string being rendered always stay
+    std::vector<CacheEntry*> kept;
+    size_t keptArea = 0;
+    for(size_t i = 0; i < resident.size(); ++i)
+    {
+        CacheEntry& entry = *resident[i];
+        const size_t area = (entry.renderSize_ + Vector2i(glyphPadding, glyphPadding)).size();
+        entry.textureIndex_ = noTexture;
+        if((entry.lastUse_ == data_->useClock_) || (keptArea + area <= data_->atlasBudget_ / 2))
+        {
+            kept.push_back(&entry);
+            keptArea += area;
         }
-        FT_Done_Glyph(glyph);
+        else
+        {
+            data_->atlasStatistics_.evictions_ ++;
+        }
+    }
+
+    for(Textures::iterator it = data_->textures_.begin(); it != data_->textures_.end(); ++it)
+        it->packer_.reset(it->size_.width(), it->size_.height());
+
+    std::stable_sort(kept.begin(), kept.end(), Taller());
+    for(size_t i = 0; i < kept.size(); ++i)
+        reloadGlyph(*kept[i]);
+
+    // textures are filled in order, so the ones left empty are at the end
+    while(!data_->textures_.empty() && data_->textures_.back().packer_.usedArea() == 0)
+    {
+        DestroyTexture()(data_->textures_.back());
+        data_->textures_.pop_back();
     }
+
+    data_->defragmenting_ = false;
+    data_->generation_ ++;
+    data_->atlasStatistics_.defragmentations_ ++;
 }
 
-CacheEntry& TypeFace::cachedGlyph(size_t aGlyphIndex)
+CacheEntry& TypeFace::cachedCharacter(uint32_t aCharacter)
 {
-    CharacterCache::iterator cacheIterator = data_->characterCache_.find(aGlyphIndex);
-    if(cacheIterator == data_->characterCache_.end())
+    int32_t index = data_->characterCache_.find(aCharacter);
+    if(index < 0)
     {
-        cacheGlyph(aGlyphIndex);
-        cacheIterator = data_->characterCache_.find(aGlyphIndex);
-        //ASSERT(cacheIterator != data_->characterCache_.end());
+        const FT_UInt glyphIndex = FT_Get_Char_Index(data_->face_, aCharacter);
+        GlyphCache::const_iterator cacheIterator = data_->glyphCache_.find(glyphIndex);
+        if(cacheIterator != data_->glyphCache_.end())
+            index = static_cast<int32_t>(cacheIterator->second);
+        else
+            index = static_cast<int32_t>(cacheGlyph(glyphIndex));
+        data_->characterCache_.insert(aCharacter, index);
+
+        CacheEntry& entry = data_->entries_[index];
+        if(aCharacter < denseKerningRange && entry.kerningSlot_ < 0)
+            entry.kerningSlot_ = static_cast<int32_t>(aCharacter);
     }
-    return cacheIterator->second;
+    return data_->entries_[index];
 }
 
-Vector2f TypeFace::renderGlyph(size_t aGlyphIndex, const Vector2f& aPosition)
+void TypeFace::addGlyphQuad(CacheEntry& entry, const Vector2f& aPosition)
 {
-    CacheEntry& entry = cachedGlyph(aGlyphIndex);
+    // glyphs without pixels such as spaces only advance the pen
+    if(entry.renderSize_.size() == 0)
+        return;
 
-    bindTexture(entry);
+    // evicted glyphs are rendered into the textures again
+    if((entry.textureIndex_ == noTexture) && !reloadGlyph(entry))
+        return;
+    entry.lastUse_ = data_->useClock_;
 
-    const Vector2f position = aPosition + entry.bitmapPosition_;
+    if(data_->quads_.size() <= entry.textureIndex_)
+        data_->quads_.resize(entry.textureIndex_ + 1);
 
-    const Vector2f topLeftUV     = entry.topLeftUV_;
-    const Vector2f bottomRightUV = entry.bottomRightUV_;
-    const float glyphWidth  = static_cast<float>(entry.renderSize_.width());
-    const float glyphHeight = static_cast<float>(entry.renderSize_.height());
+    GlyphQuad quad;
+    quad.rectangle_ = FloatRect(aPosition + entry.bitmapPosition_,
+        Vector2f(static_cast<float>(entry.renderSize_.width()), static_cast<float>(entry.renderSize_.height())));
+    quad.topLeftUV_ = entry.topLeftUV_;
+    quad.bottomRightUV_ = entry.bottomRightUV_;
+    data_->quads_[entry.textureIndex_].push_back(quad);
+}
 
-    glBegin(GL_QUADS);
-    {
-        glTexCoord2f( topLeftUV.x(), topLeftUV.y() );
-        glVertex2f( position.x(), position.y() );
+Vector2f TypeFace::kerning(const CacheEntry* aLeft, const CacheEntry& aRight)
+{
+    if(!data_->hasKerning_ || (aLeft == 0) || (aLeft->glyphIndex_ == 0) || (aRight.glyphIndex_ == 0))
+        return Vector2f();
 
-        glTexCoord2f( bottomRightUV.x(), topLeftUV.y() );
-        glVertex2f( position.x() + glyphWidth, position.y() );
+    KerningCache& cache = data_->kerningCache_;
+    if((aLeft->kerningSlot_ >= 0) && (aRight.kerningSlot_ >= 0))
+    {
+        if(cache.dense_.empty())
+        {
+            cache.dense_.resize(denseKerningRange * denseKerningRange);
+            cache.known_.resize(denseKerningRange * denseKerningRange, 0);
+        }
 
-        glTexCoord2f( bottomRightUV.x(), bottomRightUV.y() );
-        glVertex2f( position.x() + glyphWidth, position.y() + glyphHeight );
+        const size_t index = aLeft->kerningSlot_ * denseKerningRange + aRight.kerningSlot_;
+        if(cache.known_[index] == 0)
+        {
+            data_->kerningStatistics_.misses_ ++;
+            cache.dense_[index] = kerning(aLeft->glyphIndex_, aRight.glyphIndex_);
+            cache.known_[index] = 1;
+        }
+        else
+            data_->kerningStatistics_.hits_ ++;
+        return cache.dense_[index];
+    }
 
-        glTexCoord2f( topLeftUV.x(), bottomRightUV.y() );
-        glVertex2f( position.x(), position.y() + glyphHeight );
+    const uint64_t key = (static_cast<uint64_t>(aLeft->glyphIndex_) << 32) | aRight.glyphIndex_;
+    std::unordered_map<uint64_t, Vector2f>::const_iterator it = cache.pairs_.find(key);
+    if(it != cache.pairs_.end())
+    {
+        data_->kerningStatistics_.hits_ ++;
+        return it->second;
     }
-    glEnd();
 
-    return entry.advance_;
+    data_->kerningStatistics_.misses_ ++;
+    const Vector2f ret = kerning(aLeft->glyphIndex_, aRight.glyphIndex_);
+    cache.pairs_[key] = ret;
+    return ret;
+}
+
+bool TypeFace::activateSize() const
+{
+    return data_->size_ != 0 && FT_Activate_Size(data_->size_) == 0;
+}
+
+KerningStatistics TypeFace::kerningStatistics() const
+{
+    return data_->kerningStatistics_;
 }
 
 Vector2f TypeFace::kerning(size_t leftGlyphIndex, size_t rightGlyphIndex) const
 {
     Vector2f ret;
-    if(data_->hasKerning_ && (leftGlyphIndex > 0) && (rightGlyphIndex > 0))
+    if(data_->hasKerning_ && (leftGlyphIndex > 0) && (rightGlyphIndex > 0) && activateSize())
     {
         FT_Vector kerningVector;
         FT_Error ftError = FT_Get_Kerning(data_->face_, leftGlyphIndex, rightGlyphIndex, FT_KERNING_DEFAULT, &kerningVector);
@@ -533,32 +800,17 @@ Vector2f TypeFace::kerning(size_t leftGlyphIndex, size_t rightGlyphIndex) const
     return ret;
 }
 
-void TypeFace::bindTexture(const CacheEntry& aCacheEntry) const
-{
-    //ASSERT(aCacheEntry.textureIndex_ < data_->textures_.size());
-    const TextureInfo& info = data_->textures_[aCacheEntry.textureIndex_];
-
-    GLint currentTextureID = -1;
-    glGetIntegerv(GL_TEXTURE_2D_BINDING_EXT, &currentTextureID);
-    if(static_cast<GLuint>(currentTextureID) != info.handle_)
-    {
-        glBindTexture(GL_TEXTURE_2D, info.handle_);
-    }
-}
-
-void TypeFace::renderGlyphs(const String& aString)
+void TypeFace::addGlyphQuads(const String& aString, const Vector2f& aPosition)
 {
-    Vector2f pos(0.0f, 0.0f);
-    size_t leftChar = 0;
-    auto str = aString.get();
-    auto it = str.begin();
-    while(it != str.end())
+    Vector2f pos(aPosition);
+    const CacheEntry* left = 0;
+    for(String::ConstIterator it = aString.begin(); it != aString.end(); ++it)
     {
-        size_t rightChar = FT_Get_Char_Index(data_->face_, *it);
-        pos += kerning(leftChar, rightChar);
-        pos += renderGlyph(rightChar, pos);
-        leftChar = rightChar;
-        ++it;
+        CacheEntry& entry = cachedCharacter(*it);
+        pos += kerning(left, entry);
+        addGlyphQuad(entry, pos);
+        pos += entry.advance_;
+        left = &entry;
     }
 }
 
@@ -2,6 +2,7 @@
 #define BGE_FONT_TYPE_FACE_H
 #include <BGE/System/Math.h>
 #include <BGE/System/String.h>
+#include <BGE/Graphics/TextRenderer.h>
 #include <string>
  
 namespace bge
@@ -10,10 +11,11 @@ namespace bge
     {
         struct Data;
         struct CacheEntry;
+        class FontRegistry;
     }
+    class CanvasImpl;
 }
-struct FT_GlyphRec_;
-struct FT_BitmapGlyphRec_;
+struct FT_Bitmap_;
 
 namespace bge
 {
@@ -24,7 +26,9 @@ namespace Font
 class TypeFace
 {
 public:
-    explicit TypeFace(const std::string& aFileName, size_t aPointSize = 12, size_t aResolution = 100);
+    //! \brief Creates a type face of the passed in size from a font file
+    //! \note The file and its face are shared through the registry with the other sizes using them.
+    TypeFace(FontRegistry& aRegistry, const std::string& aFileName, size_t aPointSize = 12, size_t aResolution = 100);
     virtual ~TypeFace();
 public:
     //! Returns the point size of the font
@@ -39,8 +43,9 @@ public:
     //! Sets the resolution of the font
     void setResolution(size_t aResolution);
 
-    //! Renders the passed in string at the passed in position
-    void render(const String& aString, const Vector2f& aPosition);
+    //! \brief Renders the passed in string at the passed in position
+    //! \note The glyphs are handed to the canvas as one array of quads per cache texture.
+    void render(CanvasImpl& aCanvas, const String& aString, const Vector2f& aPosition);
 
     //! \brief Returns the ascent of this type face in pixels.
     //! \note This is a positive value representing the distance from the baseline to the
@@ -65,33 +70,54 @@ public:
 
     //! Returns the largest theoretically possible glyph size for this face
     Vector2i maximumGlyphSize() const;
+
+    //! Returns how many kerning lookups were answered by the cache and how many asked FreeType
+    KerningStatistics kerningStatistics() const;
+
+    //! \brief Sets how many bytes the glyph textures may take
+    //! \note Glyphs used least recently are evicted when the budget is exceeded, a glyph of the
+    //! string being rendered never is.
+    void setAtlasBudget(size_t aBytes);
+
+    //! Returns the use of the glyph textures
+    GlyphAtlasStatistics atlasStatistics() const;
 private:
-    //! \brief Renders the glyph with the passed in index
-    //! \returns How far to advance to the position of the next character
-    Vector2f renderGlyph(size_t aGlyphIndex, const Vector2f& aPosition);
+    //! Queues the quad of the passed in cached glyph with its texture
+    void addGlyphQuad(CacheEntry& aCacheEntry, const Vector2f& aPosition);
+
+    //! \brief Copies the bitmap of the passed in glyph to a texture
+    //! \returns False if the glyph is too large for a texture
+    bool placeGlyph(CacheEntry& anEntry, FT_Bitmap_* aBitmap);
+
+    //! \brief Finds room for a glyph of the passed in size, adding a texture if the budget allows it
+    //! \returns False if there is no room within the budget
+    bool allocate(const Vector2i& aSize, size_t& aTextureIndex, Vector2i& aPosition, bool anOverBudget);
+
+    //! Renders an evicted glyph into a texture again
+    bool reloadGlyph(CacheEntry& anEntry);
 
-    //! Adds a new texture to the array of cache textures
-    void addNewTexture(const Vector2i& aGlyphSize);
+    //! Evicts the glyphs used least recently and packs the others again from scratch
+    void defragment();
 
-    //! Puts a new entry into the glyph cache
-    void addCacheEntry(FT_GlyphRec_* aGlyph, FT_BitmapGlyphRec_* aBitmapGlyph, size_t aGlyphIndex, const Vector2i& aGlyphSize);
+    //! Returns the bytes taken by the glyph textures
+    size_t atlasBytes() const;
 
-    //! Checks that a cache texture is available, adding a new one if necessary
-    void ensureTextureIsAvailable();
+    //! Returns the cache entry for the passed in character, caching its glyph if necessary
+    CacheEntry& cachedCharacter(uint32_t aCharacter);
 
-    //! Returns the cache entry for the glyph with the passed in index
-    CacheEntry& cachedGlyph(size_t aGlyphIndex);
+    //! Returns the kerning vector for the passed in pair of cached glyphs, the left one may be null
+    Vector2f kerning(const CacheEntry* aLeft, const CacheEntry& aRight);
 
-    //! Returns the kerning vector for the passed in pair of glyphs
+    //! Queries FreeType for the kerning vector of the passed in pair of glyphs
     Vector2f kerning(size_t leftGlyphIndex, size_t rightGlyphIndex) const;
 
-    //! Renders the glyphs of the passed in string
-    void renderGlyphs(const String& aString);
+    //! Makes the scaled metrics of this type face current in the shared face, returns false if there are none
+    bool activateSize() const;
 
-    //! binds the passed in cache entry's texture
-    void bindTexture(const CacheEntry& aCacheEntry) const;
+    //! Queues the glyph quads of the passed in string
+    void addGlyphQuads(const String& aString, const Vector2f& aPosition);
 
-    void cacheGlyph(size_t aGlyphIndex);  //!< Caches the glyph with the passed in index
+    size_t cacheGlyph(size_t aGlyphIndex);  //!< Caches the glyph with the passed in index, returns the entry index
 
     void flushCache(); //! Flushes the string and character cache
 
@@ -0,0 +1,168 @@
+#include <BGE/System/Arena.h>
+#include <cstdlib>
+#include <new>
+
+namespace bge
+{
+
+// keeps objects aligned as malloc does,each one starts with the arena it came from
+static const size_t alignment = 16;
+static const size_t objectHeader = alignment;
+
+static thread_local Arena* currentArena = 0;
+
+static std::atomic<uint32_t> arenaCount(0);
+static std::atomic<uint32_t> blockCount(0);
+static std::atomic<uint64_t> blockBytes(0);
+static std::atomic<uint32_t> arenaObjects(0);
+static std::atomic<uint32_t> heapObjects(0);
+
+static size_t alignSize(size_t size)
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+struct Arena::Block
+{
+    Block* next_;
+    size_t size_;
+};
+
+Arena* Arena::create(size_t blockSize)
+{
+    return new Arena(blockSize);
+}
+
+Arena::Arena(size_t blockSize):
+    blocks_(0),
+    position_(0),
+    end_(0),
+    blockSize_(blockSize),
+    references_(1)
+{
+    arenaCount.fetch_add(1,std::memory_order_relaxed);
+}
+
+Arena::~Arena()
+{
+    while(blocks_)
+    {
+        Block* next = blocks_->next_;
+        blockCount.fetch_sub(1,std::memory_order_relaxed);
+        blockBytes.fetch_sub(blocks_->size_,std::memory_order_relaxed);
+        free(blocks_);
+        blocks_ = next;
+    }
+    arenaCount.fetch_sub(1,std::memory_order_relaxed);
+}
+
+void Arena::close()
+{
+    release();
+}
+
+Arena* Arena::current()
+{
+    return currentArena;
+}
+
+void* Arena::allocateObject(size_t size)
+{
+    Arena* arena = currentArena;
+    char* memory = 0;
+    if(arena)
+    {
+        memory = static_cast<char*>(arena->allocate(objectHeader + size));
+        arena->references_.fetch_add(1,std::memory_order_relaxed);
+        arenaObjects.fetch_add(1,std::memory_order_relaxed);
+    }
+    else
+    {
+        memory = static_cast<char*>(malloc(objectHeader + size));
+        if(!memory)
+            throw std::bad_alloc();
+        heapObjects.fetch_add(1,std::memory_order_relaxed);
+    }
+
+    *reinterpret_cast<Arena**>(memory) = arena;
+    return memory + objectHeader;
+}
+
+void Arena::freeObject(void* memory)
+{
+    if(!memory)
+        return;
+
+    char* start = static_cast<char*>(memory) - objectHeader;
+    Arena* arena = *reinterpret_cast<Arena**>(start);
+    if(arena)
+    {
+        arenaObjects.fetch_sub(1,std::memory_order_relaxed);
+        arena->release();
+    }
+    else
+    {
+        heapObjects.fetch_sub(1,std::memory_order_relaxed);
+        free(start);
+    }
+}
+
+ArenaStatistics Arena::statistics()
+{
+    ArenaStatistics statistics;
+    statistics.arenas_ = arenaCount.load(std::memory_order_relaxed);
+    statistics.blocks_ = blockCount.load(std::memory_order_relaxed);
+    statistics.bytes_ = blockBytes.load(std::memory_order_relaxed);
+    statistics.objects_ = arenaObjects.load(std::memory_order_relaxed);
+    statistics.heapObjects_ = heapObjects.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void* Arena::allocate(size_t size)
+{
+    size = alignSize(size);
+    if(size > size_t(end_ - position_))
+    {
+        // larger objects get a block of their own,the current one stays in use
+        const size_t blockHeader = alignSize(sizeof(Block));
+        const size_t capacity = size > blockSize_ ? size : blockSize_;
+        Block* block = static_cast<Block*>(malloc(blockHeader + capacity));
+        if(!block)
+            throw std::bad_alloc();
+        block->size_ = blockHeader + capacity;
+        block->next_ = blocks_;
+        blocks_ = block;
+        blockCount.fetch_add(1,std::memory_order_relaxed);
+        blockBytes.fetch_add(block->size_,std::memory_order_relaxed);
+
+        char* start = reinterpret_cast<char*>(block) + blockHeader;
+        if(capacity > blockSize_)
+            return start;
+        position_ = start;
+        end_ = start + capacity;
+    }
+
+    void* memory = position_;
+    position_ += size;
+    return memory;
+}
+
+void Arena::release()
+{
+    // objects may be destroyed on another thread than the one that loaded them
+    if(references_.fetch_sub(1,std::memory_order_acq_rel) == 1)
+        delete this;
+}
+
+ArenaScope::ArenaScope(Arena* arena):
+    previous_(currentArena)
+{
+    currentArena = arena;
+}
+
+ArenaScope::~ArenaScope()
+{
+    currentArena = previous_;
+}
+
+}
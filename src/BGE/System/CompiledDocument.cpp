@@ -0,0 +1,613 @@
+#include <BGE/System/CompiledDocument.h>
+#include <BGE/System/Object.h>
+#include <BGE/System/IO.h>
+#include <BGE/System/Err.h>
+#include <cstring>
+#include <unordered_map>
+#if defined(BGE_SYSTEM_WINDOWS)
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace bge
+{
+
+// the image is written and read in the byte order of the machine,all tables are 4 byte aligned
+// header,strings,classes,nodes,attributes,then the characters of the strings
+static const char imageMagic[4] = {'B','G','E','U'};
+static const uint32_t imageVersion = 2;
+static const int32_t noClass = -1;
+
+enum NodeType
+{
+    NodeType_element = 0,
+    NodeType_text,
+    NodeType_cdata
+};
+
+struct ImageHeader
+{
+    char magic_[4];
+    uint32_t version_;
+    uint32_t size_;
+    uint32_t strings_;
+    uint32_t classes_;
+    uint32_t nodes_;
+    uint32_t attributes_;
+    //! nodes directly under the document
+    uint32_t roots_;
+};
+
+//! offset from the start of the characters,each string ends with a zero
+struct ImageString
+{
+    uint32_t offset_;
+    uint32_t length_;
+};
+
+//! nodes are stored depth first,the children of a node follow it
+struct ImageNode
+{
+    uint8_t type_;
+    uint8_t reserved_;
+    uint16_t attributes_;
+    //! the name of an element or the text of a text
+    uint32_t value_;
+    //! index in the class table
+    int32_t class_;
+    uint32_t children_;
+    //! the next node under the same parent,zero for the last one,the first node is nobody's next
+    uint32_t next_;
+    //! index of the first of its attributes
+    uint32_t attribute_;
+};
+
+struct ImageAttribute
+{
+    uint32_t name_;
+    uint32_t value_;
+};
+
+class ImageWriter
+{
+public:
+    bool write(const TiXmlNode* node,uint32_t& count)
+    {
+        size_t previous = nodes_.size();
+        for(const TiXmlNode* child = node->FirstChild();child;child = child->NextSibling())
+        {
+            const TiXmlElement* element = child->ToElement();
+            const TiXmlText* text = child->ToText();
+            if(!element && !text)
+                continue;
+
+            const size_t index = nodes_.size();
+            nodes_.push_back(ImageNode());
+            ImageNode image = {};
+            image.type_ = element ? NodeType_element : (text->CDATA() ? NodeType_cdata : NodeType_text);
+            image.value_ = intern(child->ValueStr());
+            image.class_ = noClass;
+            image.attribute_ = attributes_.size();
+            if(element)
+            {
+                for(const TiXmlAttribute* attribute = element->FirstAttribute();attribute;attribute = attribute->Next())
+                {
+                    if(image.attributes_ == 0xffff)
+                    {
+                        err() << "element " << element->ValueStr() << " has too many attributes\n";
+                        return false;
+                    }
+
+                    ImageAttribute pair = {intern(attribute->NameTStr()),intern(attribute->ValueStr())};
+                    attributes_.push_back(pair);
+                    image.attributes_ ++;
+                    if(attribute->NameTStr() == "class")
+                        image.class_ = classOf(pair.value_);
+                }
+                if(!write(child,image.children_))
+                    return false;
+            }
+            nodes_[index] = image;
+            if(count > 0)
+                nodes_[previous].next_ = index;
+            previous = index;
+            count ++;
+        }
+        return true;
+    }
+
+    void finish(uint32_t roots,std::vector<char>& image)const
+    {
+        size_t characters = 0;
+        for(size_t i = 0;i < strings_.size();i++)
+            characters += strings_[i]->size() + 1;
+
+        ImageHeader header;
+        memcpy(header.magic_,imageMagic,sizeof(imageMagic));
+        header.version_ = imageVersion;
+        header.strings_ = strings_.size();
+        header.classes_ = classes_.size();
+        header.nodes_ = nodes_.size();
+        header.attributes_ = attributes_.size();
+        header.roots_ = roots;
+        header.size_ = sizeof(ImageHeader) + sizeof(ImageString) * strings_.size() + sizeof(uint32_t) * classes_.size() +
+            sizeof(ImageNode) * nodes_.size() + sizeof(ImageAttribute) * attributes_.size() + characters;
+
+        image.resize(header.size_);
+        char* position = image.data();
+        append(position,&header,sizeof(header));
+        uint32_t offset = 0;
+        for(size_t i = 0;i < strings_.size();i++)
+        {
+            ImageString string = {offset,uint32_t(strings_[i]->size())};
+            append(position,&string,sizeof(string));
+            offset += string.length_ + 1;
+        }
+        append(position,classes_.data(),sizeof(uint32_t) * classes_.size());
+        append(position,nodes_.data(),sizeof(ImageNode) * nodes_.size());
+        append(position,attributes_.data(),sizeof(ImageAttribute) * attributes_.size());
+        for(size_t i = 0;i < strings_.size();i++)
+            append(position,strings_[i]->c_str(),strings_[i]->size() + 1);
+    }
+private:
+    uint32_t intern(const std::string& string)
+    {
+        auto itr = indices_.find(string);
+        if(itr != indices_.end())
+            return itr->second;
+
+        const uint32_t index = strings_.size();
+        itr = indices_.insert(std::make_pair(string,index)).first;
+        // the keys of the map do not move
+        strings_.push_back(&itr->first);
+        return index;
+    }
+
+    int32_t classOf(uint32_t name)
+    {
+        for(size_t i = 0;i < classes_.size();i++)
+        {
+            if(classes_[i] == name)
+                return i;
+        }
+        classes_.push_back(name);
+        return classes_.size() - 1;
+    }
+
+    static void append(char*& position,const void* data,size_t size)
+    {
+        memcpy(position,data,size);
+        position += size;
+    }
+private:
+    std::unordered_map<std::string,uint32_t> indices_;
+    std::vector<const std::string*> strings_;
+    std::vector<uint32_t> classes_;
+    std::vector<ImageNode> nodes_;
+    std::vector<ImageAttribute> attributes_;
+};
+
+//! the tables of a loaded image,checked against its size before use
+struct ImageTables
+{
+    const ImageHeader* header_;
+    const ImageString* strings_;
+    const uint32_t* classes_;
+    const ImageNode* nodes_;
+    const ImageAttribute* attributes_;
+    const char* characters_;
+
+    ImageTables():
+        header_(0),
+        strings_(0),
+        classes_(0),
+        nodes_(0),
+        attributes_(0),
+        characters_(0)
+    {
+    }
+
+    //! quiet for a file that is not an image
+    bool locate(const char* image,size_t size)
+    {
+        if(size < sizeof(ImageHeader) || memcmp(image,imageMagic,sizeof(imageMagic)) != 0)
+            return false;
+
+        header_ = reinterpret_cast<const ImageHeader*>(image);
+        if(header_->version_ != imageVersion || header_->size_ != size)
+        {
+            err() << "compiled document has version " << header_->version_ << " or a bad size\n";
+            return false;
+        }
+
+        // 64 bit sums cannot overflow for counts of 32 bits
+        const uint64_t tables = sizeof(ImageHeader) + uint64_t(sizeof(ImageString)) * header_->strings_ +
+            uint64_t(sizeof(uint32_t)) * header_->classes_ + uint64_t(sizeof(ImageNode)) * header_->nodes_ +
+            uint64_t(sizeof(ImageAttribute)) * header_->attributes_;
+        if(tables > size)
+            return false;
+
+        strings_ = reinterpret_cast<const ImageString*>(header_ + 1);
+        classes_ = reinterpret_cast<const uint32_t*>(strings_ + header_->strings_);
+        nodes_ = reinterpret_cast<const ImageNode*>(classes_ + header_->classes_);
+        attributes_ = reinterpret_cast<const ImageAttribute*>(nodes_ + header_->nodes_);
+        characters_ = reinterpret_cast<const char*>(attributes_ + header_->attributes_);
+        return true;
+    }
+
+    //! every index is in its table and the children counted fill the nodes exactly
+    bool isValid()const
+    {
+        const uint64_t characters = header_->size_ - (characters_ - reinterpret_cast<const char*>(header_));
+        for(uint32_t i = 0;i < header_->strings_;i++)
+        {
+            if(uint64_t(strings_[i].offset_) + strings_[i].length_ >= characters ||
+               characters_[strings_[i].offset_ + strings_[i].length_] != 0)
+                return false;
+        }
+        for(uint32_t i = 0;i < header_->classes_;i++)
+        {
+            if(classes_[i] >= header_->strings_)
+                return false;
+        }
+
+        // the children each parent still waits for,with the node before them to check its next
+        std::vector<std::pair<uint32_t,const ImageNode*> > children;
+        children.reserve(32);
+        children.push_back(std::make_pair(header_->roots_,static_cast<const ImageNode*>(0)));
+        uint64_t attribute = 0;
+        for(uint32_t i = 0;i < header_->nodes_;i++)
+        {
+            while(!children.empty() && children.back().first == 0)
+            {
+                if(children.back().second && children.back().second->next_ != 0)
+                    return false;
+                children.pop_back();
+            }
+
+            const ImageNode& node = nodes_[i];
+            if(children.empty() || (children.back().second && children.back().second->next_ != i) ||
+               node.attribute_ != attribute)
+                return false;
+            attribute += node.attributes_;
+            if(node.value_ >= header_->strings_ || attribute > header_->attributes_ ||
+               (node.class_ != noClass && uint32_t(node.class_) >= header_->classes_) ||
+               (node.type_ != NodeType_element && (node.children_ > 0 || node.attributes_ > 0)))
+                return false;
+
+            children.back().first --;
+            children.back().second = &node;
+            if(node.children_ > 0)
+                children.push_back(std::make_pair(node.children_,static_cast<const ImageNode*>(0)));
+        }
+
+        for(uint32_t i = 0;i < header_->attributes_;i++)
+        {
+            if(attributes_[i].name_ >= header_->strings_ || attributes_[i].value_ >= header_->strings_)
+                return false;
+        }
+        for(size_t i = 0;i < children.size();i++)
+        {
+            if(children[i].first > 0 || (children[i].second && children[i].second->next_ != 0))
+                return false;
+        }
+        return attribute == header_->attributes_;
+    }
+
+    const char* string(uint32_t index)const
+    {
+        return characters_ + strings_[index].offset_;
+    }
+};
+
+bool CompiledDocument::compile(const TiXmlDocument& document,std::vector<char>& image)
+{
+    ImageWriter writer;
+    uint32_t roots = 0;
+    if(!writer.write(&document,roots))
+        return false;
+    writer.finish(roots,image);
+    return true;
+}
+
+bool CompiledDocument::compile(const std::string& source,const std::string& target)
+{
+    TiXmlDocument document(source);
+    if(!document.LoadFile())
+    {
+        err() << "load file " << source << " failed\n";
+        return false;
+    }
+
+    std::vector<char> image;
+    if(!compile(document,image))
+        return false;
+
+    IOWriter* writer = FileSystem::instance().writeFile(target);
+    if(!writer)
+        return false;
+    const bool written = writer->isValid() && writer->write(image.data(),image.size(),1) == 1;
+    writer->close();
+    writer->deleteLater();
+    if(!written)
+        err() << "write file " << target << " failed\n";
+    return written;
+}
+
+CompiledDocument::CompiledDocument():
+    image_(0),
+    size_(0),
+    mapping_(0),
+    tables_(0)
+{
+}
+
+CompiledDocument::~CompiledDocument()
+{
+    close();
+}
+
+bool CompiledDocument::load(const std::string& file)
+{
+    close();
+    if(file.size() > 0 && file[0] == ':')
+    {
+        IOReader* reader = FileSystem::instance().readFile(file);
+        if(!reader)
+            return false;
+
+        bool read = false;
+        char magic[sizeof(imageMagic)];
+        // xml files are left after the first bytes
+        if(reader->isValid() && reader->size() > sizeof(ImageHeader) && reader->read(magic,sizeof(magic),1) == 1 &&
+           memcmp(magic,imageMagic,sizeof(magic)) == 0)
+        {
+            buffer_.resize(reader->size());
+            memcpy(buffer_.data(),magic,sizeof(magic));
+            read = reader->read(buffer_.data() + sizeof(magic),buffer_.size() - sizeof(magic),1) == 1;
+        }
+        reader->close();
+        reader->deleteLater();
+        if(read && open(buffer_.data(),buffer_.size()))
+            return true;
+        close();
+        return false;
+    }
+
+    if(!map(file))
+        return false;
+    if(open(image_,size_))
+        return true;
+    close();
+    return false;
+}
+
+bool CompiledDocument::load(const std::vector<char>& image)
+{
+    close();
+    buffer_ = image;
+    if(open(buffer_.data(),buffer_.size()))
+        return true;
+    close();
+    return false;
+}
+
+void CompiledDocument::close()
+{
+    unmap();
+    image_ = 0;
+    size_ = 0;
+    std::vector<char>().swap(buffer_);
+    delete tables_;
+    tables_ = 0;
+    classes_.clear();
+}
+
+bool CompiledDocument::open(const char* image,size_t size)
+{
+    ImageTables tables;
+    if(!tables.locate(image,size))
+        return false;
+    if(!tables.isValid())
+    {
+        err() << "compiled document is corrupt\n";
+        return false;
+    }
+
+    // an unknown class fails the load before any window is created
+    classes_.resize(tables.header_->classes_);
+    for(size_t i = 0;i < classes_.size();i++)
+    {
+        classes_[i] = Rtti::rttiByObjectName(tables.string(tables.classes_[i]));
+        if(!classes_[i])
+        {
+            err() << "get " << tables.string(tables.classes_[i]) << "'s rtti failed\n";
+            return false;
+        }
+    }
+
+    image_ = image;
+    size_ = size;
+    tables_ = new ImageTables(tables);
+    return true;
+}
+
+bool CompiledDocument::build(TiXmlDocument& document)const
+{
+    if(!tables_)
+        return false;
+
+    const ImageTables& tables = *tables_;
+    const ImageHeader& header = *tables.header_;
+
+    // the parents of the next node with the children each one still waits for
+    std::vector<std::pair<TiXmlNode*,uint32_t> > parents;
+    parents.reserve(32);
+    parents.push_back(std::make_pair(static_cast<TiXmlNode*>(&document),header.roots_));
+    const ImageAttribute* attribute = tables.attributes_;
+    for(uint32_t i = 0;i < header.nodes_;i++)
+    {
+        while(parents.back().second == 0)
+            parents.pop_back();
+        parents.back().second --;
+
+        const ImageNode& image = tables.nodes_[i];
+        if(image.type_ == NodeType_element)
+        {
+            TiXmlElement* element = new TiXmlElement(tables.string(image.value_));
+            for(uint32_t j = 0;j < image.attributes_;j++,attribute++)
+                element->SetAttribute(tables.string(attribute->name_),tables.string(attribute->value_));
+            parents.back().first->LinkEndChild(element);
+            if(image.children_ > 0)
+                parents.push_back(std::make_pair(static_cast<TiXmlNode*>(element),image.children_));
+        }
+        else
+        {
+            TiXmlText* text = new TiXmlText(tables.string(image.value_));
+            text->SetCDATA(image.type_ == NodeType_cdata);
+            parents.back().first->LinkEndChild(text);
+        }
+    }
+    return true;
+}
+
+PropertyNode CompiledDocument::rootElement()const
+{
+    if(!tables_)
+        return PropertyNode();
+
+    for(uint32_t i = 0;i < tables_->header_->nodes_;i = tables_->nodes_[i].next_)
+    {
+        if(tables_->nodes_[i].type_ == NodeType_element)
+            return PropertyNode(this,i);
+        if(tables_->nodes_[i].next_ == 0)
+            break;
+    }
+    return PropertyNode();
+}
+
+PropertyNode CompiledDocument::firstChild(uint32_t index,const char* name)const
+{
+    const ImageNode* nodes = tables_->nodes_;
+    if(nodes[index].children_ == 0)
+        return PropertyNode();
+
+    for(uint32_t i = index + 1;;i = nodes[i].next_)
+    {
+        if(nodes[i].type_ == NodeType_element && (!name || strcmp(tables_->string(nodes[i].value_),name) == 0))
+            return PropertyNode(this,i);
+        if(nodes[i].next_ == 0)
+            return PropertyNode();
+    }
+}
+
+PropertyNode CompiledDocument::nextSibling(uint32_t index,const char* name)const
+{
+    const ImageNode* nodes = tables_->nodes_;
+    for(uint32_t i = nodes[index].next_;i != 0;i = nodes[i].next_)
+    {
+        if(nodes[i].type_ == NodeType_element && (!name || strcmp(tables_->string(nodes[i].value_),name) == 0))
+            return PropertyNode(this,i);
+    }
+    return PropertyNode();
+}
+
+const char* CompiledDocument::name(uint32_t index)const
+{
+    return tables_->string(tables_->nodes_[index].value_);
+}
+
+const char* CompiledDocument::attribute(uint32_t index,const char* name)const
+{
+    const ImageNode& node = tables_->nodes_[index];
+    for(uint32_t i = node.attribute_;i < node.attribute_ + node.attributes_;i++)
+    {
+        if(strcmp(tables_->string(tables_->attributes_[i].name_),name) == 0)
+            return tables_->string(tables_->attributes_[i].value_);
+    }
+    return 0;
+}
+
+const char* CompiledDocument::text(uint32_t index)const
+{
+    // as TiXmlElement::GetText,only a text coming first counts and an element without one reads as a space
+    const ImageNode* nodes = tables_->nodes_;
+    if(nodes[index].children_ == 0 || nodes[index + 1].type_ == NodeType_element)
+        return " ";
+    return tables_->string(nodes[index + 1].value_);
+}
+
+Rtti* CompiledDocument::rtti(uint32_t index)const
+{
+    const int32_t type = tables_->nodes_[index].class_;
+    return type == noClass ? 0 : classes_[type];
+}
+
+#if defined(BGE_SYSTEM_WINDOWS)
+
+bool CompiledDocument::map(const std::string& file)
+{
+    HANDLE handle = CreateFileA(file.c_str(),GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+    if(handle == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER size;
+    HANDLE mapping = NULL;
+    if(GetFileSizeEx(handle,&size) && size.QuadPart > LONGLONG(sizeof(ImageHeader)))
+        mapping = CreateFileMappingA(handle,NULL,PAGE_READONLY,0,0,NULL);
+    CloseHandle(handle);
+    if(!mapping)
+        return false;
+
+    mapping_ = MapViewOfFile(mapping,FILE_MAP_READ,0,0,0);
+    CloseHandle(mapping);
+    if(!mapping_)
+        return false;
+    image_ = static_cast<const char*>(mapping_);
+    size_ = size_t(size.QuadPart);
+    return true;
+}
+
+void CompiledDocument::unmap()
+{
+    if(mapping_)
+        UnmapViewOfFile(mapping_);
+    mapping_ = 0;
+}
+
+#else
+
+bool CompiledDocument::map(const std::string& file)
+{
+    const int handle = ::open(file.c_str(),O_RDONLY);
+    if(handle < 0)
+        return false;
+
+    struct stat status;
+    void* memory = MAP_FAILED;
+    if(fstat(handle,&status) == 0 && status.st_size > off_t(sizeof(ImageHeader)))
+        memory = mmap(0,status.st_size,PROT_READ,MAP_PRIVATE,handle,0);
+    ::close(handle);
+    if(memory == MAP_FAILED)
+        return false;
+
+    mapping_ = memory;
+    image_ = static_cast<const char*>(memory);
+    size_ = status.st_size;
+    return true;
+}
+
+void CompiledDocument::unmap()
+{
+    if(mapping_)
+        munmap(mapping_,size_);
+    mapping_ = 0;
+}
+
+#endif
+
+}
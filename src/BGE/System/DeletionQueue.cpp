@@ -0,0 +1,90 @@
+#include <BGE/System/DeletionQueue.h>
+#include <BGE/System/Object.h>
+#include <BGE/System/TimeManager.h>
+
+namespace bge
+{
+
+static thread_local DeletionQueue* currentQueue = 0;
+
+//! children handed to the queue in one step by an object having more of them
+static const size_t handedChildren = 256;
+
+void DeletionQueue::setCurrent(DeletionQueue* queue)
+{
+    currentQueue = queue;
+}
+
+DeletionQueue* DeletionQueue::current()
+{
+    return currentQueue;
+}
+
+DeletionQueue::DeletionQueue():
+    taken_(0)
+{
+}
+
+DeletionQueue::~DeletionQueue()
+{
+    DeletionQueue* current = currentQueue;
+    currentQueue = this;
+    while(!isEmpty())
+        destroy(-1.0f);
+    currentQueue = current == this ? 0 : current;
+}
+
+DeletionQueue& DeletionQueue::push(Object* object)
+{
+    object->isDeletionQueued_ = true;
+    object->deletionIndex_ = taken_ + objects_.size();
+    objects_.push_back(object);
+    return *this;
+}
+
+DeletionQueue& DeletionQueue::cancel(Object* object)
+{
+    const size_t index = object->deletionIndex_ - taken_;
+    if(object->deletionIndex_ >= taken_ && index < objects_.size() && objects_[index] == object)
+        objects_[index] = 0;
+    object->isDeletionQueued_ = false;
+    return *this;
+}
+
+size_t DeletionQueue::destroy(float budget)
+{
+    const size_t end = taken_ + objects_.size();
+    const float start = budget < 0.0f ? 0.0f : TimeManager::systemTime();
+    size_t destroyed = 0;
+    bool isStarted = false;
+    while(taken_ < end)
+    {
+        if(isStarted && budget >= 0.0f && TimeManager::systemTime() - start >= budget)
+            break;
+        isStarted = true;
+
+        Object* object = objects_.front();
+        if(!object)
+        {
+            objects_.pop_front();
+            taken_ ++;
+            continue;
+        }
+
+        // the object stays at the front until few children are left,the time of a step stays bounded
+        if(budget >= 0.0f && object->children_.size() > handedChildren)
+        {
+            object->handLastChildren(handedChildren);
+            continue;
+        }
+
+        objects_.pop_front();
+        taken_ ++;
+        object->isDeletionQueued_ = false;
+        object->destroy();
+        destroyed ++;
+    }
+    return destroyed;
+}
+
+}
@@ -1,62 +1,72 @@
 #include <BGE/System/Err.h>
+#include <BGE/System/Log.h>
 #include <streambuf>
 #include <cstdio>
-#include <iostream>
 
 namespace priv
 {
 
-class DefaultErrStreamBuf : public std::streambuf
+//! collects a line,each complete line is logged as an error of the general category
+class LogStreamBuf : public std::streambuf
 {
 public :
-    DefaultErrStreamBuf()
+    LogStreamBuf():
+        length_(0)
     {
-        static const int size = 64;
-        char* buffer = new char[size];
-        setp(buffer, buffer + size);
     }
 
-    ~DefaultErrStreamBuf()
+    ~LogStreamBuf()
     {
-        sync();
-        delete[] pbase();
+        send();
     }
 private :
     virtual int overflow(int character)
     {
-        if((character != EOF) && (pptr() != epptr()))
-        {
-            // Valid character
-            return sputc(static_cast<char>(character));
-        }
-        else if (character != EOF)
-        {
-            // Not enough space in the buffer: synchronize output and try again
-            sync();
-            return overflow(character);
-        }
-        else
-        {
-            // Invalid character: synchronize output
-            return sync();
-        }
+        if(character == EOF)
+            return 0;
+
+        const char text = static_cast<char>(character);
+        append(&text, 1);
+        return character;
+    }
+
+    virtual std::streamsize xsputn(const char* text, std::streamsize count)
+    {
+        append(text, static_cast<size_t>(count));
+        return count;
     }
 
     virtual int sync()
     {
-        // Check if there is something into the write buffer
-        if (pbase() != pptr())
-        {
-            // Print the contents of the write buffer into the standard error output
-            std::size_t size = static_cast<int>(pptr() - pbase());
-            fwrite(pbase(), 1, size, stderr);
+        send();
+        return 0;
+    }
 
-            // Reset the pointer position to the beginning of the write buffer
-            setp(pbase(), epptr());
+    void append(const char* text, size_t count)
+    {
+        for(size_t i = 0; i < count; i++)
+        {
+            if(text[i] == '\n')
+                send();
+            else
+            {
+                // a line longer than a message is split
+                if(length_ == sizeof(text_))
+                    send();
+                text_[length_++] = text[i];
+            }
         }
+    }
 
-        return 0;
+    void send()
+    {
+        if(length_ > 0 && bge::Log::instance().isEnabled(bge::LogCategory_general, bge::LogLevel_error))
+            bge::Log::instance().write(bge::LogCategory_general, bge::LogLevel_error, text_, length_);
+        length_ = 0;
     }
+private :
+    char text_[bge::Log::maxMessageLength];
+    size_t length_;
 };
 
 }
@@ -66,9 +76,10 @@ namespace bge
 
 std::ostream& err()
 {
-    //static priv::DefaultErrStreamBuf buffer;
-    //static std::ostream stream(&buffer);
-    return std::cout;//stream;
+    // one line buffer per thread,lines of different threads do not mix
+    static thread_local priv::LogStreamBuf buffer;
+    static thread_local std::ostream stream(&buffer);
+    return stream;
 }
 
 }
@@ -0,0 +1,303 @@
+#include <BGE/System/Log.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace bge
+{
+
+static const char* levelNames[] = {"debug","info","warning","error"};
+static const char* categoryNames[] = {"","system","graphics","font","gui"};
+
+struct LogSlot
+{
+    //! position the slot is free for,position + 1 once a message was stored
+    std::atomic<size_t> sequence_;
+    uint8_t category_;
+    uint8_t level_;
+    uint16_t length_;
+    char text_[Log::maxMessageLength];
+};
+
+class LogImpl : public Log
+{
+public:
+    LogImpl();
+public:
+    bool setOutput(const std::string& file);
+    void write(LogCategory category,LogLevel level,const char* text,size_t length);
+    void flush();
+    uint64_t droppedMessages()const{return dropped_.load(std::memory_order_relaxed);}
+    //! called at exit,later messages are written by the thread logging them
+    void stop();
+private:
+    bool push(LogCategory category,LogLevel level,const char* text,size_t length);
+    bool isEmpty()const;
+    //! writes the queued messages,the mutex must be held
+    void drain();
+    void print(const LogSlot& slot);
+    void run();
+private:
+    static const size_t capacity_ = 1024;
+    LogSlot slots_[capacity_];
+    std::atomic<size_t> tail_;
+    size_t head_;
+    std::atomic<uint64_t> dropped_;
+    uint64_t reportedDropped_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable drained_;
+    std::atomic<bool> sleeping_;
+    std::atomic<bool> stopping_;
+    std::atomic<bool> running_;
+    FILE* output_;
+};
+
+static void stopLog()
+{
+    static_cast<LogImpl&>(Log::instance()).stop();
+}
+
+static LogImpl* createLog()
+{
+    // never deleted,objects destroyed at exit may still log
+    LogImpl* log = new LogImpl();
+    atexit(stopLog);
+    return log;
+}
+
+Log& Log::instance()
+{
+    static LogImpl* log = createLog();
+    return *log;
+}
+
+Log::Log()
+{
+#if defined(BGE_DEBUG)
+    setLevel(LogLevel_debug);
+#else
+    setLevel(LogLevel_info);
+#endif
+}
+
+Log::~Log()
+{
+}
+
+Log& Log::setLevel(LogLevel level)
+{
+    for(int i = 0;i < LogCategory_count;i++)
+        levels_[i].store(level,std::memory_order_relaxed);
+    return *this;
+}
+
+Log& Log::setLevel(LogCategory category,LogLevel level)
+{
+    levels_[category].store(level,std::memory_order_relaxed);
+    return *this;
+}
+
+LogImpl::LogImpl():
+    tail_(0),
+    head_(0),
+    dropped_(0),
+    reportedDropped_(0),
+    sleeping_(false),
+    stopping_(false),
+    running_(true),
+    output_(stderr)
+{
+    for(size_t i = 0;i < capacity_;i++)
+        slots_[i].sequence_.store(i,std::memory_order_relaxed);
+    std::thread(&LogImpl::run,this).detach();
+}
+
+bool LogImpl::setOutput(const std::string& file)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    drain();
+
+    FILE* output = stderr;
+    if(!file.empty())
+    {
+        output = fopen(file.c_str(),"w");
+        if(!output)
+            return false;
+    }
+
+    if(output_ != stderr)
+        fclose(output_);
+    output_ = output;
+    return true;
+}
+
+void LogImpl::write(LogCategory category,LogLevel level,const char* text,size_t length)
+{
+    if(!push(category,level,text,length))
+    {
+        // the writer gets one chance to catch up,the message is dropped rather than waiting for it
+        std::this_thread::yield();
+        if(!push(category,level,text,length))
+        {
+            dropped_.fetch_add(1,std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    if(!running_.load())
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        drain();
+        return;
+    }
+
+    // pairs with the fence of the writer,either it sees the message or it is woken,by one thread only
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if(sleeping_.load(std::memory_order_relaxed) && sleeping_.exchange(false))
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_.notify_one();
+    }
+}
+
+void LogImpl::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if(running_.load())
+    {
+        wake_.notify_one();
+        while(!isEmpty() && running_.load())
+            drained_.wait_for(lock,std::chrono::milliseconds(10));
+    }
+    drain();
+}
+
+void LogImpl::stop()
+{
+    stopping_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_.notify_one();
+    }
+
+    // the thread may already be gone when the library is unloaded
+    for(int i = 0;i < 500 && running_.load();i++)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    running_.store(false);
+
+    std::unique_lock<std::mutex> lock(mutex_,std::try_to_lock);
+    if(lock.owns_lock())
+        drain();
+}
+
+bool LogImpl::push(LogCategory category,LogLevel level,const char* text,size_t length)
+{
+    size_t position = tail_.load(std::memory_order_relaxed);
+    LogSlot* slot = 0;
+    for(;;)
+    {
+        slot = &slots_[position & (capacity_ - 1)];
+        const size_t sequence = slot->sequence_.load(std::memory_order_acquire);
+        const intptr_t difference = intptr_t(sequence) - intptr_t(position);
+        if(difference == 0)
+        {
+            if(tail_.compare_exchange_weak(position,position + 1,std::memory_order_relaxed))
+                break;
+        }
+        else if(difference < 0)
+            return false;
+        else
+            position = tail_.load(std::memory_order_relaxed);
+    }
+
+    if(length > maxMessageLength)
+        length = maxMessageLength;
+    slot->category_ = uint8_t(category);
+    slot->level_ = uint8_t(level);
+    slot->length_ = uint16_t(length);
+    memcpy(slot->text_,text,length);
+    slot->sequence_.store(position + 1,std::memory_order_release);
+    return true;
+}
+
+bool LogImpl::isEmpty()const
+{
+    const LogSlot& slot = slots_[head_ & (capacity_ - 1)];
+    return slot.sequence_.load(std::memory_order_acquire) != head_ + 1;
+}
+
+void LogImpl::drain()
+{
+    bool written = false;
+    while(!isEmpty())
+    {
+        LogSlot& slot = slots_[head_ & (capacity_ - 1)];
+        print(slot);
+        slot.sequence_.store(head_ + capacity_,std::memory_order_release);
+        head_ ++;
+        written = true;
+    }
+
+    const uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if(dropped != reportedDropped_)
+    {
+        fprintf(output_,"warning: %llu log messages dropped\n",(unsigned long long)(dropped - reportedDropped_));
+        reportedDropped_ = dropped;
+        written = true;
+    }
+
+    if(written)
+        fflush(output_);
+}
+
+void LogImpl::print(const LogSlot& slot)
+{
+    size_t length = slot.length_;
+    if(length > 0 && slot.text_[length - 1] == '\n')
+        length --;
+
+    const char* level = slot.level_ < LogLevel_none ? levelNames[slot.level_] : "";
+    const char* category = slot.category_ < LogCategory_count ? categoryNames[slot.category_] : "";
+    if(category[0] != 0)
+        fprintf(output_,"%s %s: %.*s\n",level,category,int(length),slot.text_);
+    else
+        fprintf(output_,"%s: %.*s\n",level,int(length),slot.text_);
+}
+
+void LogImpl::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while(!stopping_.load())
+    {
+        sleeping_.store(true);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        // writers and stop notify under the mutex after the fence,no wake up is lost
+        wake_.wait(lock,[this]{return !isEmpty() || stopping_.load();});
+        sleeping_.store(false);
+
+        drain();
+        drained_.notify_all();
+    }
+    drain();
+    running_.store(false);
+    drained_.notify_all();
+}
+
+LogMessage::LogMessage(LogCategory category,LogLevel level):
+    category_(category),
+    level_(level),
+    stream_(&buffer_)
+{
+}
+
+LogMessage::~LogMessage()
+{
+    Log::instance().write(category_,level_,buffer_.text(),buffer_.length());
+}
+
+}
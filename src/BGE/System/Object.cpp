@@ -1,7 +1,7 @@
 #include <BGE/System/Object.h>
 #include <BGE/System/Err.h>
 #include <BGE/System/Serialization.h>
-#include <algorithm>
+#include <vector>
 
 #define IMPLEMENT_BASE_OBJECT(object)\
     const bge::Rtti  object::rtti##object(#object,NULL,sizeof(object),NULL);\
@@ -19,19 +19,27 @@ namespace bge
 
 IMPLEMENT_BASE_OBJECT(Object)
 
+//! fewer children are searched one by one
+static const size_t indexedChildren = 16;
+
 Object::Object(Object* parent)
 {
 	parent_ = NULL;
-	children_ = new std::list<Object*>();
+    childIndex_ = 0;
+    nameIndex_ = NULL;
     isWidget_ = false;
+    isDeletionQueued_ = false;
+    deletionIndex_ = 0;
     if(parent)
 	    parent->insertChild(this);
-	else
-        parent_ = NULL;
 }
 
 Object::~Object()
 {
+    // deleted directly while it waited in the queue
+    if(isDeletionQueued_ && DeletionQueue::current())
+        DeletionQueue::current()->cancel(this);
+    delete nameIndex_;
 }
 
 bool Object::isExactly(const Rtti& type)const
@@ -62,7 +70,7 @@ void Object::setName(const std::string &name)
         return;
     }
 
-    name_ = name;
+    changeName(name);
 }
 
 std::string Object::name()const
@@ -73,10 +81,8 @@ std::string Object::name()const
 void Object::setParent(Object* ptr)
 {
     remove();
-	parent_ = ptr;
-
-	if(parent_)
-		parent_->insertChild(this);
+	if(ptr)
+		ptr->insertChild(this);
 }
 
 Object* Object::parent()const
@@ -86,17 +92,20 @@ Object* Object::parent()const
 
 void Object::removeChild(Object* child)
 {
-    if(hasChild(child))
-    {
-		children_->remove(child);
-	}
+    if(!hasChild(child))
+        return;
+
+    Object* last = children_[children_.size() - 1];
+    children_[child->childIndex_] = last;
+    last->childIndex_ = child->childIndex_;
+    children_.pop_back();
+    unindexChild(child);
+    child->parent_ = NULL;
 }
 
 bool Object::hasChild(Object* child)
 {
-	if(children_->empty())
-		return false;
-	return std::find(children_->begin(),children_->end(),child) != children_->end();
+	return child && child->parent_ == this;
 }
 
 void Object::insertChild(Object* child)
@@ -104,8 +113,10 @@ void Object::insertChild(Object* child)
 	if(child && (child != this))
 	{
 		child->remove();
-		children_->push_back(child);
 		child->parent_ = this;
+		child->childIndex_ = children_.size();
+		children_.push_back(child);
+		indexChild(child);
 	}
 }
 
@@ -118,17 +129,44 @@ void Object::remove()
 
 void Object::removeAllChild()
 {
-    auto itr = children_->begin();
-	for(;itr != children_->end(); ++itr)
-	{
-		(*itr)->parent_ = NULL;
-		(*itr)->deleteLater();
-	}
+    // a child deleted may remove a sibling,every one is detached first
+    ChildList children(children_);
+    children_.clear();
+    delete nameIndex_;
+    nameIndex_ = NULL;
+
+	for(size_t i = 0;i < children.size();i++)
+		children[i]->parent_ = NULL;
+	for(size_t i = 0;i < children.size();i++)
+		children[i]->deleteLater();
+}
 
-	children_->clear();
+void Object::handLastChildren(size_t count)
+{
+    // the object is out of the tree from the first batch,names of a going object are not looked up
+    remove();
+    delete nameIndex_;
+    nameIndex_ = NULL;
+
+    for(size_t i = 0;i < count && children_.size() > 0;i++)
+    {
+        Object* child = children_[children_.size() - 1];
+        children_.pop_back();
+        child->parent_ = NULL;
+        child->deleteLater();
+    }
 }
 
 void Object::deleteLater()
+{
+    DeletionQueue* queue = DeletionQueue::current();
+    if(!queue)
+        destroy();
+    else if(!isDeletionQueued_)
+        queue->push(this);
+}
+
+void Object::destroy()
 {
     remove();
 	removeAllChild();
@@ -140,25 +178,108 @@ void Object::setWidgetType(bool widget)
     isWidget_ = widget;
 }
 
-Object* Object::findChild(const std::string& name)
+Object* Object::findChild(const std::string& name,bool recursive)
+{
+    size_t end = name.find('/');
+    if(end == std::string::npos)
+        return recursive ? findDescendant(name) : findDirectChild(name);
+
+    const std::string first = name.substr(0,end);
+    Object* object = recursive ? findDescendant(first) : findDirectChild(first);
+    while(object && end != std::string::npos)
+    {
+        const size_t begin = end + 1;
+        end = name.find('/',begin);
+        object = object->findDirectChild(name.substr(begin,end == std::string::npos ? end : end - begin));
+    }
+    return object;
+}
+
+Object* Object::findDirectChild(const std::string& name)
 {
-    auto itr = children_->begin();
-    while(itr != children_->end())
+    if(!nameIndex_ && children_.size() >= indexedChildren)
     {
-        Object* child = *itr;
-        if(child->name() == name)
-            return child;
-        itr ++;
+        nameIndex_ = new NameIndex();
+        for(size_t i = 0;i < children_.size();i++)
+            indexChild(children_[i]);
     }
 
+    if(nameIndex_)
+    {
+        // the multimap keeps equal names in no particular order,the scan below returns the lowest index too
+        Object* found = NULL;
+        std::pair<NameIndex::const_iterator,NameIndex::const_iterator> range = nameIndex_->equal_range(name);
+        for(NameIndex::const_iterator itr = range.first;itr != range.second;++itr)
+        {
+            if(!found || itr->second->childIndex_ < found->childIndex_)
+                found = itr->second;
+        }
+        return found;
+    }
+
+    for(size_t i = 0;i < children_.size();i++)
+    {
+        if(children_[i]->name_ == name)
+            return children_[i];
+    }
     return NULL;
 }
 
-bool Object::loadProperty(TiXmlNode* node)
+Object* Object::findDescendant(const std::string& name)
+{
+    std::vector<Object*> level(1,this);
+    std::vector<Object*> next;
+    while(!level.empty())
+    {
+        for(size_t i = 0;i < level.size();i++)
+        {
+            Object* child = level[i]->findDirectChild(name);
+            if(child)
+                return child;
+            next.insert(next.end(),level[i]->children_.begin(),level[i]->children_.end());
+        }
+        level.swap(next);
+        next.clear();
+    }
+    return NULL;
+}
+
+void Object::changeName(const std::string& name)
+{
+    if(parent_)
+        parent_->unindexChild(this);
+    name_ = name;
+    if(parent_)
+        parent_->indexChild(this);
+}
+
+void Object::indexChild(Object* child)
+{
+    if(nameIndex_ && !child->name_.empty())
+        nameIndex_->insert(std::make_pair(child->name_,child));
+}
+
+void Object::unindexChild(Object* child)
+{
+    if(!nameIndex_ || child->name_.empty())
+        return;
+
+    std::pair<NameIndex::iterator,NameIndex::iterator> range = nameIndex_->equal_range(child->name_);
+    for(NameIndex::iterator itr = range.first;itr != range.second;++itr)
+    {
+        if(itr->second == child)
+        {
+            nameIndex_->erase(itr);
+            return;
+        }
+    }
+}
+
+bool Object::loadProperty(const PropertyNode& node)
 {
     std::string objectName_;
     DESERIALIZE_OBJECT(objectName,node)
-    name_ = objectName_;
+    changeName(objectName_);
     return true;
 }
 
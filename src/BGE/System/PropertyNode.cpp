@@ -0,0 +1,71 @@
+#include <BGE/System/PropertyNode.h>
+#include <BGE/System/CompiledDocument.h>
+#include <BGE/System/Object.h>
+
+namespace bge
+{
+
+PropertyNode::PropertyNode():
+    element_(0),
+    document_(0),
+    index_(0)
+{
+}
+
+PropertyNode::PropertyNode(TiXmlNode* node):
+    element_(node ? node->ToElement() : 0),
+    document_(0),
+    index_(0)
+{
+}
+
+PropertyNode::PropertyNode(const CompiledDocument* document,uint32_t index):
+    element_(0),
+    document_(document),
+    index_(index)
+{
+}
+
+PropertyNode PropertyNode::firstChild(const char* name)const
+{
+    if(document_)
+        return document_->firstChild(index_,name);
+    return PropertyNode(element_ ? (name ? element_->FirstChildElement(name) : element_->FirstChildElement()) : 0);
+}
+
+PropertyNode PropertyNode::nextSibling(const char* name)const
+{
+    if(document_)
+        return document_->nextSibling(index_,name);
+    return PropertyNode(element_ ? (name ? element_->NextSiblingElement(name) : element_->NextSiblingElement()) : 0);
+}
+
+const char* PropertyNode::name()const
+{
+    if(document_)
+        return document_->name(index_);
+    return element_ ? element_->Value() : 0;
+}
+
+const char* PropertyNode::attribute(const char* name)const
+{
+    if(document_)
+        return document_->attribute(index_,name);
+    return element_ ? element_->Attribute(name) : 0;
+}
+
+const char* PropertyNode::text()const
+{
+    if(document_)
+        return document_->text(index_);
+    return element_ ? element_->GetText() : 0;
+}
+
+Rtti* PropertyNode::rtti()const
+{
+    if(document_)
+        return document_->rtti(index_);
+    return element_ ? Rtti::rttiByObjectName(element_->Attribute("class")) : 0;
+}
+
+}
@@ -1,12 +1,33 @@
 #include <BGE/System/Object.h>
+#include <cstring>
 
 namespace bge
 {
 
 Rtti* Rtti::first_ = NULL;
-std::map<std::string,Rtti*> Rtti::rttitable;
 
-std::string Rtti::name()const
+//! open addressing on the name hash,filled while the static rttis are constructed
+//! zero initialized before any constructor runs,whatever the order of the translation units
+static const size_t tableSize = 1024;
+static Rtti* table[tableSize];
+static size_t tableCount;
+//! more classes than fit at half load are found by walking the list
+static bool isTableFull;
+
+static Rtti* removedRtti()
+{
+    return reinterpret_cast<Rtti*>(&tableCount);
+}
+
+static uint32_t hashName(const char* name,size_t length)
+{
+    uint32_t hash = 2166136261u;
+    for(size_t i = 0;i < length;i++)
+        hash = (hash ^ uint8_t(name[i])) * 16777619u;
+    return hash;
+}
+
+const std::string& Rtti::name()const
 {
     return name_;
 }
@@ -26,13 +47,37 @@ name_(name),
 parent_(parent),
 size_(size),
 creator_(ptr),
-next_(first_)
+next_(first_),
+hash_(hashName(name.data(),name.size())),
+depth_(0),
+isLinked_(false)
 {
     first_ = this;
+    link();
+
+    if(tableCount < tableSize / 2)
+    {
+        size_t i = hash_ & (tableSize - 1);
+        while(table[i] && table[i] != removedRtti())
+            i = (i + 1) & (tableSize - 1);
+        table[i] = this;
+        tableCount ++;
+    }
+    else
+        isTableFull = true;
 }
 
 Rtti::~Rtti()
 {
+    for(size_t i = hash_ & (tableSize - 1);table[i];i = (i + 1) & (tableSize - 1))
+    {
+        if(table[i] == this)
+        {
+            table[i] = removedRtti();
+            break;
+        }
+    }
+
 	if(this == first_)
 	{
 		first_ = next_;
@@ -52,15 +97,33 @@ Rtti::~Rtti()
 	}
 }
 
-bool Rtti::isDerived(const Rtti& type)const
+void Rtti::link()const
+{
+    // the parent links this one when it is constructed
+    if(parent_ && !parent_->isLinked_)
+        return;
+
+    depth_ = parent_ ? parent_->depth_ + 1 : 0;
+    for(uint32_t i = 0;i < depth_ && i < maxDepth;i++)
+        ancestors_[i] = parent_->ancestors_[i];
+    if(depth_ < maxDepth)
+        ancestors_[depth_] = this;
+    isLinked_ = true;
+
+    for(const Rtti* info = first_;info;info = info->next_)
+    {
+        if(info->parent_ == this && !info->isLinked_)
+            info->link();
+    }
+}
+
+bool Rtti::isDeeplyDerived(const Rtti& type)const
 {
     const Rtti* search = this;
-    while (search)
+    while(search && search->depth_ >= type.depth_)
     {
-        if (search == &type)
-        {
+        if(search == &type)
             return true;
-        }
         search = search->parent_;
     }
     return false;
@@ -73,21 +136,36 @@ Object* Rtti::createObject()
 	return NULL;
 }
 
-Rtti* Rtti::rttiByObjectName(const std::string & objectname)
+Rtti* Rtti::find(const char* name,size_t length)
 {
-    if(rttitable[objectname])
-		return rttitable[objectname];
-	else
-        for(Rtti* info = first_; info ; info = info->next_)
+    const uint32_t hash = hashName(name,length);
+    for(size_t i = hash & (tableSize - 1);table[i];i = (i + 1) & (tableSize - 1))
+    {
+        Rtti* info = table[i];
+        if(info != removedRtti() && info->hash_ == hash && info->name_.size() == length &&
+            memcmp(info->name_.data(),name,length) == 0)
+            return info;
+    }
+
+    if(isTableFull)
+    {
+        for(Rtti* info = first_;info;info = info->next_)
         {
-            if(info->name() == objectname)
-            {
-                rttitable[objectname] = info;
+            if(info->hash_ == hash && info->name_.size() == length && memcmp(info->name_.data(),name,length) == 0)
                 return info;
-            }
         }
+    }
     return NULL;
 }
 
+Rtti* Rtti::rttiByObjectName(const std::string & objectname)
+{
+    return find(objectname.data(),objectname.size());
 }
 
+Rtti* Rtti::rttiByObjectName(const char* objectname)
+{
+    return objectname ? find(objectname,strlen(objectname)) : NULL;
+}
+
+}
@@ -36,17 +36,14 @@ void serialize(const ObjectNamer<String>& object,TiXmlNode* node)
 {
     TiXmlElement element(object.name());
 	std::string buffer;
-	if(!object.value().empty())
+	char number[16];
+	auto itr = object.value().begin();
+	while(itr != object.value().end())
 	{
-		char ch[5] = {0};
-		auto itr = object.value().begin();
-		while(itr != object.value().end())
-		{
-		    buffer += toString<uint32_t>(*itr);
-			buffer += ',';
-			itr ++;
-		}
-		buffer = buffer.substr(0,buffer.size()-1);
+	    if(itr != object.value().begin())
+	        buffer += ',';
+	    buffer.append(number,toChars(number,number + sizeof(number),*itr));
+		itr ++;
 	}
     TiXmlText text(buffer);
     element.InsertEndChild(text);
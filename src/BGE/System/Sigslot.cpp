@@ -0,0 +1,72 @@
+#include <BGE/System/Sigslot.h>
+
+namespace bge
+{
+
+//! innermost emission running on this thread
+static thread_local SignalEmission* currentEmission = 0;
+
+std::mutex& SlotHolder::connectionMutex()
+{
+    // never deleted,static signals and slot holders are destroyed after it otherwise
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
+SignalEmission::SignalEmission(BasicSignal* signal):
+    signal_(signal),
+    previous_(currentEmission),
+    isSignalDestroyed_(false)
+{
+    signal_->emitting_.fetch_add(1);
+    currentEmission = this;
+}
+
+SignalEmission::~SignalEmission()
+{
+    currentEmission = previous_;
+    if(!isSignalDestroyed_)
+        signal_->emitting_.fetch_sub(1);
+}
+
+void BasicSignal::share()
+{
+    if(isShared_.load())
+        return;
+
+    // changes in place made so far are seen,later ones copy the list
+    std::lock_guard<std::mutex> lock(SlotHolder::connectionMutex());
+    isShared_.store(true);
+}
+
+void BasicSignal::reclaimRetired()
+{
+    std::lock_guard<std::mutex> lock(SlotHolder::connectionMutex());
+    reclaim();
+}
+
+void BasicSignal::finishEmissions()
+{
+    if(isOwnerThread())
+    {
+        for(OwnerEmission* emission = ownerEmission_;emission != 0;emission = emission->previous_)
+            emission->isSignalDestroyed_ = true;
+    }
+    ownerEmission_ = 0;
+
+    int own = 0;
+    for(SignalEmission* emission = currentEmission;emission != 0;emission = emission->previous_)
+    {
+        if(emission->signal_ == this)
+        {
+            emission->isSignalDestroyed_ = true;
+            own ++;
+        }
+    }
+
+    while(emitting_.load() > own)
+        std::this_thread::yield();
+    emitting_.store(0);
+}
+
+}
@@ -1,6 +1,10 @@
 #include <BGE/System/String.h>
 #include <BGE/System/Utf.h>
+#include <algorithm>
 #include <iterator>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
 
 namespace bge
@@ -234,21 +238,291 @@ String operator +(const String& left, const String& right)
 
 void splitAndConvert(const std::string& s,char flag,String& string)
 {
-    size_t last = 0;
-    size_t index = s.find_first_of(flag,last);
-    while(index != std::string::npos)
+    splitAndConvert(s.c_str(),flag,string);
+}
+
+void splitAndConvert(const char* s,char flag,String& string)
+{
+    // items that are not numbers,as the space of an empty element,are skipped
+    const char* last = s + strlen(s);
+    while(s != last)
+    {
+        const char* end = std::find(s,last,flag);
+        int32_t item = 0;
+        if(fromChars(s,end,item) != s)
+            string.push_back(item);
+        s = end == last ? last : end + 1;
+    }
+}
+
+static const char* skipSpaces(const char* first,const char* last)
+{
+    while(first != last && (*first == ' ' || (*first >= '\t' && *first <= '\r')))
+        first ++;
+    return first;
+}
+
+static bool isDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static const char* readDigits(const char* first,const char* last,uint64_t& value)
+{
+    const char* position = first;
+    uint64_t number = 0;
+    for(;position != last && isDigit(*position);position++)
+    {
+        const unsigned digit = *position - '0';
+        if(number > (std::numeric_limits<uint64_t>::max() - digit) / 10)
+            return first;
+        number = number * 10 + digit;
+    }
+    if(position != first)
+        value = number;
+    return position;
+}
+
+const char* fromChars(const char* first,const char* last,uint64_t& value)
+{
+    const char* position = skipSpaces(first,last);
+    if(position != last && *position == '+')
+        position ++;
+    const char* end = readDigits(position,last,value);
+    return end == position ? first : end;
+}
+
+const char* fromChars(const char* first,const char* last,int64_t& value)
+{
+    const char* position = skipSpaces(first,last);
+    const bool negative = position != last && *position == '-';
+    if(position != last && (*position == '-' || *position == '+'))
+        position ++;
+
+    uint64_t magnitude = 0;
+    const char* end = readDigits(position,last,magnitude);
+    const uint64_t limit = uint64_t(std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0);
+    if(end == position || magnitude > limit)
+        return first;
+    value = negative ? int64_t(0 - magnitude) : int64_t(magnitude);
+    return end;
+}
+
+//! a decimal number as the digits of its first 19 significant digits and a power of ten
+struct DecimalNumber
+{
+    uint64_t mantissa_;
+    int32_t exponent_;
+    bool negative_;
+    //! more significant digits than the mantissa holds
+    bool truncated_;
+    //! infinity or not a number
+    bool special_;
+    double specialValue_;
+};
+
+static bool matchesWord(const char* first,const char* last,const char* word)
+{
+    const size_t length = strlen(word);
+    if(size_t(last - first) < length)
+        return false;
+    for(size_t i = 0;i < length;i++)
+    {
+        if((first[i] | 0x20) != word[i])
+            return false;
+    }
+    return true;
+}
+
+static const char* readDecimal(const char* first,const char* last,DecimalNumber& number)
+{
+    const char* position = skipSpaces(first,last);
+    number.negative_ = position != last && *position == '-';
+    if(position != last && (*position == '-' || *position == '+'))
+        position ++;
+
+    // what a stream writes for them
+    number.special_ = true;
+    if(matchesWord(position,last,"inf"))
+    {
+        number.specialValue_ = std::numeric_limits<double>::infinity();
+        position += matchesWord(position,last,"infinity") ? 8 : 3;
+        return position;
+    }
+    if(matchesWord(position,last,"nan"))
+    {
+        number.specialValue_ = std::numeric_limits<double>::quiet_NaN();
+        return position + 3;
+    }
+
+    number.special_ = false;
+    number.mantissa_ = 0;
+    number.exponent_ = 0;
+    number.truncated_ = false;
+    int digits = 0;
+    bool any = false;
+    for(;position != last && isDigit(*position);position++)
+    {
+        any = true;
+        if(digits < 19)
+        {
+            number.mantissa_ = number.mantissa_ * 10 + (*position - '0');
+            digits += number.mantissa_ != 0;
+        }
+        else
+        {
+            number.exponent_ ++;
+            number.truncated_ = number.truncated_ || *position != '0';
+        }
+    }
+    if(position != last && *position == '.')
     {
-		std::string item = s.substr(last,index-last);
-		string.push_back(fromString<int32_t>(item));
-		last = index+1;
-        index = s.find_first_of(flag,last);
+        for(position++;position != last && isDigit(*position);position++)
+        {
+            any = true;
+            if(digits < 19)
+            {
+                number.mantissa_ = number.mantissa_ * 10 + (*position - '0');
+                digits += number.mantissa_ != 0;
+                number.exponent_ --;
+            }
+            else
+                number.truncated_ = number.truncated_ || *position != '0';
+        }
     }
+    if(!any)
+        return first;
 
-    if(index-last>0)
-	{
-		std::string item = s.substr(last,index-last);
-		string.push_back(fromString<int32_t>(item));
+    // an exponent without digits is not part of the number
+    if(position != last && (*position == 'e' || *position == 'E'))
+    {
+        const char* exponent = position + 1;
+        const bool negative = exponent != last && *exponent == '-';
+        if(exponent != last && (*exponent == '-' || *exponent == '+'))
+            exponent ++;
+        if(exponent != last && isDigit(*exponent))
+        {
+            int32_t power = 0;
+            for(;exponent != last && isDigit(*exponent);exponent++)
+            {
+                if(power < 100000)
+                    power = power * 10 + (*exponent - '0');
+            }
+            number.exponent_ += negative ? -power : power;
+            position = exponent;
+        }
     }
+    return position;
+}
+
+//! the mantissa written with an exponent has no decimal point,strtod reads it the same in every locale
+static double slowValue(const DecimalNumber& number)
+{
+    char text[48];
+    char* end = toChars(text,text + 24,number.mantissa_);
+    *end++ = 'e';
+    end = toChars(end,text + sizeof(text) - 1,int64_t(number.exponent_));
+    *end = 0;
+    return strtod(text,0);
+}
+
+static const double powers[] = {1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,
+    1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+
+const char* fromChars(const char* first,const char* last,double& value)
+{
+    DecimalNumber number;
+    const char* end = readDecimal(first,last,number);
+    if(end == first)
+        return first;
+
+    double result = 0.0;
+    if(number.special_)
+        result = number.specialValue_;
+    // both the mantissa and the power of ten are exact,the one operation rounds correctly
+    else if(!number.truncated_ && number.mantissa_ <= (uint64_t(1) << 53) && number.exponent_ >= -22 && number.exponent_ <= 22)
+        result = number.exponent_ < 0 ? double(number.mantissa_) / powers[-number.exponent_] :
+            double(number.mantissa_) * powers[number.exponent_];
+    else
+        result = slowValue(number);
+    value = number.negative_ ? -result : result;
+    return end;
+}
+
+const char* fromChars(const char* first,const char* last,float& value)
+{
+    DecimalNumber number;
+    const char* end = readDecimal(first,last,number);
+    if(end == first)
+        return first;
+
+    float result = 0.0f;
+    if(number.special_)
+        result = float(number.specialValue_);
+    else if(!number.truncated_ && number.mantissa_ <= (uint64_t(1) << 24) && number.exponent_ >= -10 && number.exponent_ <= 10)
+        result = number.exponent_ < 0 ? float(number.mantissa_) / float(powers[-number.exponent_]) :
+            float(number.mantissa_) * float(powers[number.exponent_]);
+    else
+        result = float(slowValue(number));
+    value = number.negative_ ? -result : result;
+    return end;
+}
+
+static char* copyChars(char* first,char* last,const char* text,size_t length)
+{
+    if(size_t(last - first) < length)
+        return first;
+    memcpy(first,text,length);
+    return first + length;
+}
+
+char* toChars(char* first,char* last,uint64_t value)
+{
+    // written backwards from the end of the buffer
+    char text[20];
+    char* position = text + sizeof(text);
+    do
+    {
+        *--position = char('0' + value % 10);
+        value /= 10;
+    }
+    while(value > 0);
+    return copyChars(first,last,position,text + sizeof(text) - position);
+}
+
+char* toChars(char* first,char* last,int64_t value)
+{
+    if(value >= 0)
+        return toChars(first,last,uint64_t(value));
+    if(first == last)
+        return first;
+
+    *first = '-';
+    char* end = toChars(first + 1,last,0 - uint64_t(value));
+    return end == first + 1 ? first : end;
+}
+
+char* toChars(char* first,char* last,double value)
+{
+    // the whole numbers a stream writes without an exponent,negative zero keeps its sign
+    if(value > -999999.5 && value < 999999.5 && value == double(int64_t(value)) && !(value == 0.0 && std::signbit(value)))
+        return toChars(first,last,int64_t(value));
+
+    char text[32];
+    const int length = snprintf(text,sizeof(text),"%g",value);
+    if(length <= 0 || length >= int(sizeof(text)))
+        return first;
+
+    // printf follows the c locale,a stream and the files use a point
+    const char point = *localeconv()->decimal_point;
+    if(point != '.')
+        std::replace(text,text + length,point,'.');
+    return copyChars(first,last,text,length);
+}
+
+char* toChars(char* first,char* last,float value)
+{
+    return toChars(first,last,double(value));
 }
 
 }
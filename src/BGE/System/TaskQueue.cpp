@@ -0,0 +1,163 @@
+#include <BGE/System/TaskQueue.h>
+#include <BGE/System/TimeManager.h>
+#include <mutex>
+#include <utility>
+
+namespace bge
+{
+
+typedef std::vector<std::pair<std::thread::id,TaskQueue*> > ThreadQueues;
+
+// never deleted,queued slots may be called while static objects are destroyed
+static std::mutex& threadQueueMutex()
+{
+    static std::mutex* mutex = new std::mutex();
+    return *mutex;
+}
+
+static ThreadQueues& threadQueues()
+{
+    static ThreadQueues* queues = new ThreadQueues();
+    return *queues;
+}
+
+void TaskQueue::setThreadQueue(TaskQueue* queue)
+{
+    std::lock_guard<std::mutex> lock(threadQueueMutex());
+    ThreadQueues& queues = threadQueues();
+    const std::thread::id thread = std::this_thread::get_id();
+    for(size_t i = 0;i < queues.size();i++)
+    {
+        if(queues[i].first == thread)
+        {
+            queues.erase(queues.begin() + i);
+            break;
+        }
+    }
+
+    if(queue)
+        queues.push_back(std::make_pair(thread,queue));
+}
+
+TaskQueue* TaskQueue::threadQueue(std::thread::id thread)
+{
+    std::lock_guard<std::mutex> lock(threadQueueMutex());
+    const ThreadQueues& queues = threadQueues();
+    for(size_t i = 0;i < queues.size();i++)
+    {
+        if(queues[i].first == thread)
+            return queues[i].second;
+    }
+    return 0;
+}
+
+TaskQueue::TaskQueue():
+    head_(&stub_),
+    tail_(&stub_)
+{
+    stub_.next_.store(0,std::memory_order_relaxed);
+}
+
+TaskQueue::~TaskQueue()
+{
+    clear();
+}
+
+void TaskQueue::post(Task task)
+{
+    Node* node = new Node();
+    node->next_.store(0,std::memory_order_relaxed);
+    node->task_.swap(task);
+    push(node,node);
+}
+
+void TaskQueue::post(std::vector<Task> tasks)
+{
+    if(tasks.empty())
+        return;
+
+    Node* first = 0;
+    Node* last = 0;
+    for(size_t i = 0;i < tasks.size();i++)
+    {
+        Node* node = new Node();
+        node->next_.store(0,std::memory_order_relaxed);
+        node->task_.swap(tasks[i]);
+        if(last)
+            last->next_.store(node,std::memory_order_relaxed);
+        else
+            first = node;
+        last = node;
+    }
+    push(first,last);
+}
+
+size_t TaskQueue::run(float budget)
+{
+    const uint64_t deadline = TimeManager::nanoseconds() + uint64_t(budget > 0.0f ? budget * 1e9f : 0.0f);
+    size_t ran = 0;
+    // at least one task runs,a long task can not stall the queue forever
+    while(Node* node = pop())
+    {
+        node->task_();
+        delete node;
+        ran ++;
+        if(TimeManager::nanoseconds() >= deadline)
+            break;
+    }
+    return ran;
+}
+
+void TaskQueue::clear()
+{
+    while(Node* node = pop())
+        delete node;
+}
+
+bool TaskQueue::isEmpty()const
+{
+    return tail_ == &stub_ && stub_.next_.load(std::memory_order_acquire) == 0 && head_.load(std::memory_order_acquire) == &stub_;
+}
+
+void TaskQueue::push(Node* first,Node* last)
+{
+    // the queue is unlinked between the exchange and the store,pop reports it empty until then
+    Node* previous = head_.exchange(last,std::memory_order_acq_rel);
+    previous->next_.store(first,std::memory_order_release);
+}
+
+TaskQueue::Node* TaskQueue::pop()
+{
+    Node* tail = tail_;
+    Node* next = tail->next_.load(std::memory_order_acquire);
+    if(tail == &stub_)
+    {
+        if(!next)
+            return 0;
+        tail_ = next;
+        tail = next;
+        next = next->next_.load(std::memory_order_acquire);
+    }
+
+    if(next)
+    {
+        tail_ = next;
+        return tail;
+    }
+
+    if(tail != head_.load(std::memory_order_acquire))
+        return 0;
+
+    // the last node is only handed out once the stub queued behind it
+    stub_.next_.store(0,std::memory_order_relaxed);
+    push(&stub_,&stub_);
+    next = tail->next_.load(std::memory_order_acquire);
+    if(next)
+    {
+        tail_ = next;
+        return tail;
+    }
+    return 0;
+}
+
+}
@@ -1,22 +1,30 @@
 #include <BGE/System/TimeManager.h>
-#ifdef WIN32
-#include <windows.h>
-#include <mmsystem.h>
-#else
-#include <ctime>
-#endif
+#include <chrono>
 
 namespace bge
 {
 
+static std::chrono::steady_clock::time_point startTime()
+{
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
 float TimeManager::systemTime()
 {
-#ifdef WIN32
-    return static_cast<float>(timeGetTime()) * 0.001f;
-#else
-    clock_t clockTime = clock();
-    return static_cast<float>(clockTime) / static_cast<float>(CLOCKS_PER_SEC);
-#endif
+    // counted from the first call,a float stays fine grained far longer than with the epoch of the clock
+    return static_cast<float>(static_cast<double>(nanoseconds()) * 1e-9);
+}
+
+uint64_t TimeManager::milliseconds()
+{
+    return nanoseconds() / 1000000;
+}
+
+uint64_t TimeManager::nanoseconds()
+{
+    const std::chrono::steady_clock::time_point start = startTime();
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
 }
 
 }
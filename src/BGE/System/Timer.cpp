@@ -1,14 +1,47 @@
 //! 2010.06.01
 #include <BGE/System/Timer.h>
 #include <BGE/System/TimeManager.h>
+#include <algorithm>
 
 namespace bge
 {
 
+static void link(TimerLink& slot,TimerLink* link)
+{
+    link->next_ = &slot;
+    link->previous_ = slot.previous_;
+    slot.previous_->next_ = link;
+    slot.previous_ = link;
+}
+
+static void unlink(TimerLink* link)
+{
+    link->previous_->next_ = link->next_;
+    link->next_->previous_ = link->previous_;
+    link->next_ = link;
+    link->previous_ = link;
+}
+
+//! moves every link of a slot to an empty list
+static void splice(TimerLink& slot,TimerLink& list)
+{
+    if(slot.isEmpty())
+        return;
+    list.next_ = slot.next_;
+    list.previous_ = slot.previous_;
+    list.next_->previous_ = &list;
+    list.previous_->next_ = &list;
+    slot.next_ = &slot;
+    slot.previous_ = &slot;
+}
+
 Timer::Timer(uint32_t inv):
 interval_(inv),
-isStarted_(false)
+isStarted_(false),
+lastTriggerTime_(0),
+deadline_(0)
 {
+    link_.timer_ = this;
 }
 
 Timer::~Timer()
@@ -16,13 +49,26 @@ Timer::~Timer()
     stop();
 }
 
+Timer& Timer::setInterval(uint32_t milliseconds)
+{
+    interval_ = milliseconds;
+    if(isStarted())
+    {
+        TimerWheel::instance().cancel(this);
+        deadline_ = lastTriggerTime_ + interval_;
+        TimerWheel::instance().schedule(this);
+    }
+    return *this;
+}
+
 Timer& Timer::start()
 {
-    //!ASSERT(GetInterval() > 0);
     if(!isStarted())
     {
         isStarted_ = true;
-        lastTriggerTime_ = TimeManager::systemTime();
+        lastTriggerTime_ = TimeManager::milliseconds();
+        deadline_ = lastTriggerTime_ + interval_;
+        TimerWheel::instance().schedule(this);
     }
     return *this;
 }
@@ -32,24 +78,196 @@ Timer& Timer::stop()
     if(isStarted())
     {
         isStarted_ = false;
+        TimerWheel::instance().cancel(this);
     }
     return *this;
 }
 
-bool Timer::isElapsed()
+TimerWheel& TimerWheel::instance()
 {
-    bool ret = false;
-    if(isStarted())
+    static TimerWheel wheel;
+    return wheel;
+}
+
+TimerWheel::TimerWheel():
+current_(TimeManager::milliseconds()),
+count_(0),
+nextDeadline_(never),
+isDeadlineValid_(true)
+{
+}
+
+void TimerWheel::schedule(Timer* timer)
+{
+    const uint64_t deadline = timer->deadline_;
+    TimerLink* slot = 0;
+    if(deadline < current_)
+        slot = &root_[current_ & (rootSize - 1)];
+    else
     {
-        uint32_t now = TimeManager::systemTime();
-        if(now > (lastTriggerTime_ + interval()))
+        uint64_t delta = deadline - current_;
+        uint64_t position = deadline;
+        if(delta < rootSize)
+            slot = &root_[position & (rootSize - 1)];
+        else
         {
-            ret = true;
-            lastTriggerTime_ = now;
+            // farther than the wheel reaches the timer waits in the last level and is scheduled again
+            const uint64_t reach = uint64_t(1) << (rootBits + levelCount * levelBits);
+            if(delta >= reach)
+            {
+                delta = reach - 1;
+                position = current_ + delta;
+            }
+
+            uint32_t level = 0;
+            while(delta >= uint64_t(1) << (rootBits + (level + 1) * levelBits))
+                level ++;
+            slot = &levels_[level][(position >> (rootBits + level * levelBits)) & (levelSize - 1)];
         }
     }
+
+    link(*slot,&timer->link_);
+    count_ ++;
+    if(isDeadlineValid_ && deadline < nextDeadline_)
+        nextDeadline_ = deadline;
+}
+
+void TimerWheel::cancel(Timer* timer)
+{
+    unlink(&timer->link_);
+    count_ --;
+    if(timer->deadline_ <= nextDeadline_)
+        isDeadlineValid_ = false;
+}
+
+uint32_t TimerWheel::cascade(uint32_t level)
+{
+    const uint32_t index = uint32_t(current_ >> (rootBits + level * levelBits)) & (levelSize - 1);
+    TimerLink list;
+    splice(levels_[level][index],list);
+    while(!list.isEmpty())
+    {
+        Timer* timer = list.next_->timer_;
+        unlink(&timer->link_);
+        count_ --;
+        schedule(timer);
+    }
+    return index;
+}
+
+uint32_t TimerWheel::advance(uint64_t now)
+{
+    uint32_t triggered = 0;
+    if(count_ == 0)
+    {
+        if(now >= current_)
+            current_ = now + 1;
+        return triggered;
+    }
+
+    while(current_ <= now)
+    {
+        const uint32_t index = uint32_t(current_) & (rootSize - 1);
+        if(index != 0 && root_[index].isEmpty())
+        {
+            // the wheel jumps to the next deadline of the turn,or to the next turn which cascades the upper levels
+            uint32_t next = index + 1;
+            while(next < rootSize && root_[next].isEmpty())
+                next ++;
+            current_ = std::min(current_ + (next - index),now + 1);
+            continue;
+        }
+
+        if(index == 0)
+        {
+            for(uint32_t level = 0;level < levelCount;level++)
+            {
+                if(cascade(level) != 0)
+                    break;
+            }
+        }
+
+        TimerLink list;
+        splice(root_[index],list);
+        current_ ++;
+
+        // slots may start and stop any timer,the one triggered is taken off the list first
+        while(!list.isEmpty())
+        {
+            Timer* timer = list.next_->timer_;
+            unlink(&timer->link_);
+            count_ --;
+            if(timer->deadline_ >= current_)
+            {
+                schedule(timer);
+                continue;
+            }
+
+            // a late timer is not triggered for every interval it missed
+            timer->lastTriggerTime_ = timer->deadline_;
+            if(timer->lastTriggerTime_ + timer->interval_ <= now)
+                timer->lastTriggerTime_ = now;
+            timer->deadline_ = timer->lastTriggerTime_ + (timer->interval_ > 0 ? timer->interval_ : 1);
+            schedule(timer);
+            isDeadlineValid_ = false;
+
+            triggered ++;
+            timer->trigger();
+        }
+    }
+    return triggered;
+}
+
+uint64_t TimerWheel::earliestDeadline(const TimerLink& slot)
+{
+    uint64_t ret = never;
+    for(const TimerLink* link = slot.next_;link != &slot;link = link->next_)
+    {
+        if(link->timer_->deadline_ < ret)
+            ret = link->timer_->deadline_;
+    }
     return ret;
 }
 
+uint64_t TimerWheel::nextDeadline()const
+{
+    if(isDeadlineValid_)
+        return nextDeadline_;
+
+    // the first occupied slot of every level holds its earliest timers
+    uint64_t ret = never;
+    for(uint32_t i = 0;i < rootSize;i++)
+    {
+        const TimerLink& slot = root_[(current_ + i) & (rootSize - 1)];
+        if(!slot.isEmpty())
+        {
+            ret = earliestDeadline(slot);
+            break;
+        }
+    }
+
+    for(uint32_t level = 0;level < levelCount;level++)
+    {
+        // the slot of the current turn is cascaded at its first millisecond,later it holds the next turn
+        const uint32_t shift = rootBits + level * levelBits;
+        const uint32_t index = uint32_t(current_ >> shift);
+        const uint32_t first = (current_ & ((uint64_t(1) << shift) - 1)) == 0 ? 0 : 1;
+        for(uint32_t i = first;i < first + levelSize;i++)
+        {
+            const TimerLink& slot = levels_[level][(index + i) & (levelSize - 1)];
+            if(!slot.isEmpty())
+            {
+                const uint64_t deadline = earliestDeadline(slot);
+                if(deadline < ret)
+                    ret = deadline;
+                break;
+            }
+        }
+    }
+
+    nextDeadline_ = ret;
+    isDeadlineValid_ = true;
+    return ret;
 }
 
+}
@@ -867,8 +867,7 @@ const char* TiXmlElement::GetText() const
 			return childText->Value();
 		}
 	}
-	static char backspace[1] = {32};
-	return backspace;
+	return " ";
 }
 
 